@@ -4,13 +4,16 @@
  * 按《程序总体架构.pdf》进行组织：
  * - Drivers: MAX31865 / ADS1115 / PWM(Heater) / TPC(Valve) / UartLink
  * - HW Abstraction: Sensors / Actuators
- * - Ctrl: ModeManager(Manual/Auto占位)/ControlState
- * - Util: SafetyManager
+ * - Ctrl: ModeManager(Manual/Auto)/AutoController(PID)/ControlState
+ * - Util: SafetyManager / ConfigStore（现场标定与配置，片内 Flash 持久化）/ DaqRegistry（变量订阅采集）
  *
  * 当前阶段约束：
- * 1) 不实现自动控制算法（保留 AutoController 文件/接口）。
- * 2) 温度传感器当前为 2 路 PT100，后续可扩展至 4 路（修改 BoardConfig.h）。
+ * 1) 自动控制：温度环 PID + 压力外环串级 + 加热前馈（AutoController），各环由 enable_mask 单独启用。
+ * 2) 温度传感器为 PT100/PT1000，最多 8 路（BoardConfig::TEMP_SENSOR_MAX_COUNT）；
+ *    实际接入路数由 BoardConfig::TEMP_SENSOR_COUNT 指定（当前 2 路）。
  * 3) 与机载 ESP32 通过 Serial1 (D0/D1) 通讯；USB Serial 仅用于调试输出。
+ * 4) 控制步由定时器节拍以固定周期驱动（BoardConfig::CONTROL_PERIOD_US）：
+ *    采集 -> 计算 -> 安全 -> 输出；通讯/遥测/调试在节拍间隙的后台执行。
  */
 
 #include <Arduino.h>
@@ -22,8 +25,16 @@
 
 #include "src/ctrl/ControlState.h"
 #include "src/ctrl/ModeManager.h"
+#include "src/ctrl/SetpointProgram.h"
 
 #include "src/util/SafetyManager.h"
+#include "src/util/ControlTicker.h"
+#include "src/util/CaptureBuffer.h"
+#include "src/util/StageProfiler.h"
+#include "src/util/RtdTable.h"
+#include "src/util/ConfigStore.h"
+#include "src/util/DaqRegistry.h"
+#include "src/util/Metrics.h"
 #include "src/drivers/UartLink.h"
 
 static ControlState g_state;
@@ -32,58 +43,364 @@ static Actuators g_actuators;
 static ModeManager g_mode_mgr;
 static SafetyManager g_safety;
 static UartLink g_link(Serial1);
+static ControlTicker g_ticker;
+static CaptureBuffer g_capture;
+static SetpointProgram g_program;
+static ConfigStore g_config;
+static DaqRegistry g_daq;
+static uint32_t g_capture_trips_seen = 0;
+#if CTRL_PROFILE
+static StageProfiler g_profiler;
+static void benchRtdConversion();
+#endif
 
 static Proto::Telemetry g_telem;
 static Proto::Outputs g_out;
+static Proto::Diagnostics g_diag;
 
 static uint32_t g_last_telem_tx_ms = 0;
+static uint32_t g_last_diag_ms = 0;
 static uint32_t g_last_debug_ms = 0;
 
+// 后台主循环周期（us）只记入 g_m_loop_us 直方图；USB 调试输出每秒按两次打印间 sum/count 之差给出均值
+static uint32_t g_loop_last_us = 0;
+static uint32_t g_loop_dt_us   = 0;   // 最近一次后台循环周期（DAQ 观测）
+static uint64_t g_loop_prev_sum   = 0;
+static uint32_t g_loop_prev_count = 0;
+
+// 运行指标（util/Metrics.h）：地面 `metrics ctrl` 经空中端拉取快照；定义顺序即条目序号。
+// 累计量直接读取各模块已有统计（不重复记账），UART 发送统计读 UartLink 的实时计数
+static Metrics::Counter   g_m_ticks("ctrl_ticks", []() -> uint32_t { return g_ticker.ticks(); });
+static Metrics::Counter   g_m_overruns("ctrl_overruns", []() -> uint32_t { return g_ticker.overruns(); });
+static Metrics::Histogram g_m_exec_us("ctrl_exec_us");
+static Metrics::Histogram g_m_loop_us("loop_us");
+static Metrics::Counter   g_m_trips("safety_trips", []() -> uint32_t { return g_safety.tripCount(); });
+static Metrics::Counter   g_m_tx_drops("uart_tx_drops", []() -> uint32_t { return g_link.txDrops(); });
+static Metrics::Counter   g_m_telem_ovw("uart_tel_ovw", []() -> uint32_t { return g_link.telemOverwrites(); });
+static Metrics::Gauge     g_m_txq_max("uart_txq_max", []() -> int32_t { return static_cast<int32_t>(g_link.queuedMax()); });
+static Metrics::Gauge     g_m_link("link_alive", []() -> int32_t { return g_state.link_alive ? 1 : 0; });
+
+static void measureLoopPeriod()
+{
+    const uint32_t now_us = micros();
+    if (g_loop_last_us != 0) {
+        const uint32_t dt = now_us - g_loop_last_us;
+        g_loop_dt_us = dt;
+        g_m_loop_us.record(dt);
+    }
+    g_loop_last_us = now_us;
+}
+
+// DAQ 变量表：id 一经发布不再改动含义（地面脚本按 id 订阅），新增变量追加新 id。
+// 1..：遥测/状态/输出；16..：控制器内部状态；24..：驱动原始码值；32..：时序
+static const DaqRegistry::Var kDaqVars[] = {
+    {1,  Proto::DAQ_T_F32, &g_telem.temp_c[0],                 nullptr, "temp0_c"},
+    {2,  Proto::DAQ_T_F32, &g_telem.temp_c[1],                 nullptr, "temp1_c"},
+    {3,  Proto::DAQ_T_F32, &g_telem.pressure_pa,               nullptr, "press_pa"},
+    {4,  Proto::DAQ_T_F32, &g_telem.heater_power_pct,          nullptr, "heater_pct"},
+    {5,  Proto::DAQ_T_F32, &g_telem.valve_opening_pct,         nullptr, "valve_pct"},
+    {6,  Proto::DAQ_T_F32, &g_state.setpoints.target_temp_c,   nullptr, "sp_temp_c"},
+    {7,  Proto::DAQ_T_F32, &g_state.setpoints.target_pressure_pa, nullptr, "sp_press_pa"},
+    {8,  Proto::DAQ_T_U8,  &g_state.mode,                      nullptr, "mode"},
+    {9,  Proto::DAQ_T_F32, &g_out.heater_power_pct,            nullptr, "out_heater"},
+    {10, Proto::DAQ_T_F32, &g_out.valve_opening_pct,           nullptr, "out_valve"},
+    {16, Proto::DAQ_T_F32, nullptr, []() -> float { return g_mode_mgr.autoController().tempPid().integral(); },  "temp_integ"},
+    {17, Proto::DAQ_T_F32, nullptr, []() -> float { return g_mode_mgr.autoController().pressPid().integral(); }, "press_integ"},
+    {18, Proto::DAQ_T_F32, nullptr, []() -> float { return g_mode_mgr.autoController().effectiveTempSetpoint(); }, "temp_sp_eff"},
+    {19, Proto::DAQ_T_U8,  nullptr, []() -> float { return g_safety.activeMask(); },     "safety_mask"},
+    {24, Proto::DAQ_T_U16, nullptr, []() -> float { return g_sensors.lastRtdCode(0); },  "rtd_code0"},
+    {25, Proto::DAQ_T_U16, nullptr, []() -> float { return g_sensors.lastRtdCode(1); },  "rtd_code1"},
+    {26, Proto::DAQ_T_I16, nullptr, []() -> float { return g_sensors.lastPressureRaw(); }, "ads_raw"},
+    {32, Proto::DAQ_T_U32, nullptr, []() -> float { return g_ticker.lastExecUs(); },     "exec_us"},
+    {33, Proto::DAQ_T_U32, &g_loop_dt_us,                      nullptr, "loop_us"},
+};
+
+// 配置参数下发到各模块（上电装载后、链路改写参数后）
+static void applyConfig()
+{
+    const ConfigStore::Data &c = g_config.data();
+    g_sensors.setPressureCal(c.press_v0_mv, c.press_sens_mv_per_kpa);
+    for (uint8_t i = 0; i < BoardConfig::TEMP_SENSOR_COUNT; ++i) {
+        g_sensors.setRtdRref(i, c.rtd_rref[i]);
+    }
+    g_safety.setMaxTempC(c.safety_max_temp_c);
+    g_safety.setMaxPressPa(c.safety_max_press_pa);
+    g_safety.setMaxRateCPerS(c.safety_max_rate_c_per_s);
+    g_mode_mgr.setMaxTempC(c.safety_max_temp_c);
+    g_program.setMaxTempC(c.safety_max_temp_c);
+    g_program.setMaxPressPa(c.safety_max_press_pa);
+
+    // 整组增益在两个控制节拍之间一次下发，下一拍同时生效
+    AutoController::Tuning t;
+    t.temp_kp      = c.temp_kp;
+    t.temp_ki      = c.temp_ki;
+    t.temp_kd      = c.temp_kd;
+    t.temp_d_tau_s = c.temp_d_tau_s;
+    t.cascade_kp   = c.cascade_kp;
+    t.cascade_ki   = c.cascade_ki;
+    t.press_kp     = c.press_kp;
+    t.press_ki     = c.press_ki;
+    t.press_kd     = c.press_kd;
+    g_mode_mgr.setTuning(t);
+}
+
+// 自整定增益校验：三个增益都在参数表范围内才采用
+static bool checkTuneGains(void *, float kp, float ki, float kd)
+{
+    return ConfigStore::validate(Proto::CFG_TEMP_KP, kp) == Proto::CONFIG_OK &&
+           ConfigStore::validate(Proto::CFG_TEMP_KI, ki) == Proto::CONFIG_OK &&
+           ConfigStore::validate(Proto::CFG_TEMP_KD, kd) == Proto::CONFIG_OK;
+}
+
+// 安全联锁跳闸：在样本处理路径上直接关断执行器
+static void safetyForceOff(void *)
+{
+    g_actuators.forceOff();
+}
+
 void setup()
 {
     Serial.begin(115200);
     delay(50);
 
+    // 配置最先装载：只读 Flash，不擦写
+    const uint32_t cfg_load_us = g_config.begin();
+
     g_sensors.begin();
     g_actuators.begin();
     g_mode_mgr.begin();
+    g_mode_mgr.setGainCheck(checkTuneGains, nullptr);
     g_safety.begin();
+    g_safety.setForceOff(safetyForceOff, nullptr);
+    g_sensors.attachSafety(&g_safety);
 
     g_link.begin(BoardConfig::UART_BAUD);
+    g_capture.begin(BoardConfig::CONTROL_PERIOD_US);
+    g_link.attachCapture(&g_capture);
+    g_link.attachProgram(&g_program);
+    g_link.attachConfig(&g_config);
+    g_daq.begin(kDaqVars, sizeof(kDaqVars) / sizeof(kDaqVars[0]), BoardConfig::CONTROL_PERIOD_US);
+    g_link.attachDaq(&g_daq);
+    applyConfig();
+    g_config.takeChanged();
 
     g_state.reset();
     g_state.mode = ControlMode::SAFE;
 
+#if CTRL_PROFILE
+    g_profiler.begin();
+    benchRtdConversion();
+#endif
+    g_ticker.begin(BoardConfig::CONTROL_PERIOD_US);
+
     Serial.println("Nano33BLE Controller booted.");
     Serial.println("Link: Serial1 @115200, frame protocol enabled.");
+    Serial.print("Config: ");
+    Serial.print(g_config.loadedFromFlash() ? "flash seq=" : "defaults");
+    if (g_config.loadedFromFlash()) Serial.print(g_config.commitSeq());
+    Serial.print(" load(us)=");
+    Serial.println(cfg_load_us);
+}
+
+// 固定周期控制步
+static void controlTick()
+{
+    const uint32_t now_ms = millis();
+
+    // 1) 采集
+    PROFILE_STAGE(g_profiler, StageProfiler::SENSORS_READ, g_sensors.readAll(g_telem));
+
+    // 1.5) 设定值程序：按本拍时间推进斜坡/保持/阶跃，改写 setpoints
+    g_program.tick(g_state, g_telem, now_ms);
+
+    // 2) 控制计算
+    PROFILE_STAGE(g_profiler, StageProfiler::MODE_COMPUTE, g_mode_mgr.compute(g_state, g_telem, g_out));
+
+    // 3) 安全检查 + 输出钳制
+    PROFILE_STAGE(g_profiler, StageProfiler::SAFETY_CHECK,
+                  g_safety.checkAndClamp(g_state, g_telem, g_out, now_ms));
+
+    // 4) 执行输出；回填实际生效的执行器状态（下一拍前馈/抗饱和使用）
+    PROFILE_STAGE(g_profiler, StageProfiler::ACTUATORS_APPLY, g_actuators.apply(g_out, now_ms));
+    g_link.noteActuation(millis());
+    g_telem.heater_power_pct  = g_actuators.heaterPct();
+    g_telem.valve_opening_pct = g_actuators.valvePct();
+
+    // 5) 高速捕获：联锁跳闸自动触发（保留第一次跳闸的现场，读取后由地面重新布防）
+    const uint32_t trips = g_safety.tripCount();
+    if (trips != g_capture_trips_seen) {
+        g_capture_trips_seen = trips;
+        g_capture.trigger(Proto::CAPTURE_REASON_SAFETY, now_ms);
+    }
+    g_capture.push(g_telem, g_state.mode, g_safety.activeMask());
+
+    // 6) 变量采集：按订阅分频采样一行
+    g_daq.sample(now_ms);
+}
+
+#if CTRL_PROFILE
+// RTD 码 -> 温度换算的片上耗时：上电时按通道 0 的 R0/RREF 遍历低温表与主表覆盖的全部码值，
+// 用 DWT 周期计数求每次换算的平均周期数（含循环与累加开销，约几个周期）
+static volatile float g_rtd_bench_sink = 0.0f;
+
+static void benchRtdSpan(const char *name, const RtdConverter &conv, double t_lo, double t_hi)
+{
+    const double code_per_ratio = BoardConfig::RTD_R0[0] * 32768.0 / BoardConfig::RTD_RREF[0];
+    auto ratio = [](double t) {
+        return (t < RtdCvdTable::T_MIN_C) ? RtdLowTable::ratioAt(t) : RtdCvdTable::ratioAt(t);
+    };
+    const uint32_t lo = static_cast<uint32_t>(ceil(ratio(t_lo) * code_per_ratio));
+    uint32_t hi = static_cast<uint32_t>(floor(ratio(t_hi) * code_per_ratio));
+    if (hi > 0x7FFEu) hi = 0x7FFEu;
+    if (hi < lo) return;
+
+    float acc = 0.0f;
+    const uint32_t c0 = StageProfiler::cycles();
+    for (uint32_t code = lo; code <= hi; ++code) {
+        float t = 0.0f;
+        conv.codeToTempC(static_cast<uint16_t>(code), t);
+        acc += t;
+    }
+    const uint32_t cyc = StageProfiler::cycles() - c0;
+    g_rtd_bench_sink = acc;
+
+    const uint32_t n = hi - lo + 1;
+    Serial.print("prof rtd_conv ");
+    Serial.print(name);
+    Serial.print(" n=");
+    Serial.print(n);
+    Serial.print(" cycles/conv=");
+    Serial.print(static_cast<float>(cyc) / n, 1);
+    Serial.print(" us/conv=");
+    Serial.println(static_cast<float>(cyc) / n / StageProfiler::cyclesPerUs(), 3);
+}
+
+static void benchRtdConversion()
+{
+    RtdConverter conv;
+    conv.configure(BoardConfig::RTD_R0[0], BoardConfig::RTD_RREF[0]);
+    benchRtdSpan("low", conv, RtdLowTable::T_MIN_C, RtdLowTable::T_MAX_C);
+    benchRtdSpan("cvd", conv, RtdCvdTable::T_MIN_C, RtdCvdTable::T_MAX_C);
+}
+
+// 分段耗时：USB 每段一行（us），同时以 MSG_PROFILE_V1 上报
+static void reportProfile(uint32_t now_ms)
+{
+    StageProfiler::StageStats st[StageProfiler::STAGE_COUNT];
+    g_profiler.takeStats(st);
+    const float k = 1.0f / StageProfiler::cyclesPerUs();
+    for (uint8_t i = 0; i < StageProfiler::STAGE_COUNT; ++i) {
+        Serial.print("prof ");
+        Serial.print(StageProfiler::stageName(i));
+        Serial.print(" n=");
+        Serial.print(st[i].count);
+        Serial.print(" us min=");
+        Serial.print(st[i].min_cyc * k, 2);
+        Serial.print(" mean=");
+        Serial.print(st[i].mean_cyc * k, 2);
+        Serial.print(" p99=");
+        Serial.print(st[i].p99_cyc * k, 2);
+        Serial.print(" max=");
+        Serial.println(st[i].max_cyc * k, 2);
+    }
+    g_link.sendProfile(st, now_ms);
+}
+#endif
+
+static void updateDiagnostics()
+{
+    const ControlTicker::Stats st = g_ticker.takeStats();
+    g_diag.ctrl_period_us     = st.period_us;
+    g_diag.ctrl_ticks         = st.ticks;
+    g_diag.ctrl_overruns      = st.overruns;
+    g_diag.ctrl_jitter_max_us = st.jitter_max_us;
+    g_diag.ctrl_jitter_avg_us = st.jitter_avg_us;
+    g_diag.ctrl_exec_max_us   = st.exec_max_us;
+
+    const ValveDriver::DutyStats vd = g_actuators.takeValveDutyStats();
+    g_diag.valve_cmd_pct      = g_actuators.valvePct();
+    g_diag.valve_duty_pct     = vd.duty_pct;
+    g_diag.valve_cycles       = vd.cycles;
+
+    const SafetyManager::Stats ss = g_safety.takeStats();
+    g_diag.safety_active_mask   = ss.active_mask;
+    g_diag.safety_last_trip     = ss.last_trip_mask;
+    g_diag.safety_trips         = ss.trips;
+    g_diag.safety_react_last_us = ss.react_last_us;
+    g_diag.safety_react_max_us  = ss.react_max_us;
+
+    const UartLink::TxStats tx = g_link.takeTxStats();
+    g_diag.uart_txq_bytes        = tx.queued_bytes;
+    g_diag.uart_txq_max          = tx.queued_max;
+    g_diag.uart_tx_drops         = tx.hi_drops;
+    g_diag.uart_telem_overwrites = tx.telem_overwrites;
+    g_diag.uart_diag_overwrites  = tx.diag_overwrites;
 }
 
 void loop()
 {
+    measureLoopPeriod();
+
+    // 控制步：仅在定时器节拍到期时执行
+    if (g_ticker.takeTick()) {
+        controlTick();
+        g_ticker.endTick();
+        g_m_exec_us.record(g_ticker.lastExecUs());
+    }
+
+    // ---- 以下为节拍间隙的后台任务 ----
     const uint32_t now_ms = millis();
 
-    // 1) 通讯轮询：接收来自机载 ESP32 的命令 / 心跳
-    g_link.poll(g_state, now_ms);
+    // 4.5) 传感器后台轮询：ADS1115 860SPS 样本逐个送入压力抽取滤波
+    PROFILE_STAGE(g_profiler, StageProfiler::SENSORS_POLL, g_sensors.poll(now_ms));
 
-    // 2) 采集
-    g_sensors.readAll(g_telem);
+    // 5) 通讯轮询：接收来自机载 ESP32 的命令 / 心跳；写出发送队列
+    PROFILE_STAGE(g_profiler, StageProfiler::LINK_POLL, g_link.poll(g_state, now_ms));
 
-    // 3) 控制计算
-    g_mode_mgr.compute(g_state, g_telem, g_out);
+    // 5.5) 自整定结束：一次性上报结果
+    RelayAutotuner::Result tune_res;
+    if (g_mode_mgr.takeAutotuneResult(tune_res)) {
+        g_link.sendAutotuneResult(tune_res);
+        // DONE 的增益已在 ModeManager 中校验通过并生效；同步到参数表，可读回，也可随 cfg commit 持久化
+        // （被拒绝时为 REJECTED，控制器已转 SAFE，参数表与生效增益均未改变）
+        if (tune_res.status == RelayAutotuner::Status::DONE) {
+            g_config.set(Proto::CFG_TEMP_KP, tune_res.kp);
+            g_config.set(Proto::CFG_TEMP_KI, tune_res.ki);
+            g_config.set(Proto::CFG_TEMP_KD, tune_res.kd);
+        }
+    }
 
-    // 4) 安全检查 + 输出钳制
-    g_safety.checkAndClamp(g_state, g_telem, g_out, now_ms);
+    // 5.6) 捕获完成：主动上报一次状态，地面据此分块读取
+    if (g_capture.takeReady()) {
+        g_link.sendCaptureInfo();
+    }
+
+    // 5.65) DAQ：攒满的一帧交给发送队列（只占用线路空闲）
+    {
+        uint8_t daq_payload[FrameCodec::MAX_PAYLOAD];
+        const uint8_t n = g_daq.takeFrame(daq_payload, sizeof(daq_payload));
+        if (n) g_link.sendDaq(daq_payload, n);
+    }
 
-    // 5) 执行输出
-    g_actuators.apply(g_out, now_ms);
+    // 5.7) 链路改写了配置参数：立即下发（下一个节拍生效）
+    if (g_config.takeChanged()) {
+        applyConfig();
+    }
 
     // 6) 上行遥测
-    if (now_ms - g_last_telem_tx_ms >= BoardConfig::TELEMETRY_PERIOD_MS) {
+    if (now_ms - g_last_telem_tx_ms >= g_config.data().telemetry_period_ms) {
         g_last_telem_tx_ms = now_ms;
         g_link.sendTelemetry(g_telem, g_out, now_ms);
     }
 
-    // 7) USB 调试输出（低频）
+    // 7) 诊断遥测（节拍抖动/超时等）
+    if (now_ms - g_last_diag_ms >= g_config.data().diag_period_ms) {
+        g_last_diag_ms = now_ms;
+        updateDiagnostics();
+        g_link.sendDiagnostics(g_diag, now_ms);
+    }
+
+    // 8) USB 调试输出（低频）
     if (now_ms - g_last_debug_ms >= 1000) {
         g_last_debug_ms = now_ms;
 
@@ -101,9 +418,32 @@ void loop()
         Serial.print(g_telem.temp_c[1]);
         Serial.print(" P(Pa)=");
         Serial.print(g_telem.pressure_pa);
+        Serial.print(" press_sps=");
+        Serial.print(g_sensors.takePressureSampleCount());
         Serial.print(" heater=%=");
         Serial.print(g_out.heater_power_pct);
         Serial.print(" valve=%=");
-        Serial.println(g_out.valve_opening_pct);
+        Serial.print(g_out.valve_opening_pct);
+        // 均值取最近 1 s；min/max 为直方图自上电的极值
+        const uint32_t loop_n = g_m_loop_us.count() - g_loop_prev_count;
+        const uint64_t loop_sum = g_m_loop_us.sum() - g_loop_prev_sum;
+        g_loop_prev_count = g_m_loop_us.count();
+        g_loop_prev_sum = g_m_loop_us.sum();
+        Serial.print(" loop(us) avg=");
+        Serial.print(loop_n ? static_cast<uint32_t>(loop_sum / loop_n) : 0);
+        Serial.print(" min=");
+        Serial.print(g_m_loop_us.minValue());
+        Serial.print(" max=");
+        Serial.print(g_m_loop_us.maxValue());
+        Serial.print(" tick jit_max(us)=");
+        Serial.print(g_diag.ctrl_jitter_max_us);
+        Serial.print(" exec_max(us)=");
+        Serial.print(g_diag.ctrl_exec_max_us);
+        Serial.print(" overruns=");
+        Serial.println(g_diag.ctrl_overruns);
+
+#if CTRL_PROFILE
+        reportProfile(now_ms);
+#endif
     }
 }
@@ -0,0 +1,23 @@
+// sim/Arduino.h
+#pragma once
+
+// 主机仿真用的 Arduino 最小替身：只提供控制器 ctrl/ util/ 源码用到的类型与时间函数。
+// 时间由仿真推进（SimClock），与真实时间无关，因此可远快于实时运行。
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+#include <stdlib.h>
+
+namespace SimClock {
+extern uint64_t now_us;
+
+inline void advanceUs(uint32_t dt_us) { now_us += dt_us; }
+} // namespace SimClock
+
+inline uint32_t millis() { return static_cast<uint32_t>(SimClock::now_us / 1000ULL); }
+inline uint32_t micros() { return static_cast<uint32_t>(SimClock::now_us); }
+
+inline void noInterrupts() {}
+inline void interrupts() {}
@@ -0,0 +1,75 @@
+// sim/MpcBench.cpp
+#include "MpcBench.h"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "../src/ctrl/MpcController.h"
+#include "../src/util/BoardConfig.h"
+
+namespace {
+
+uint32_t g_rng = 0x2468ACE1u;
+
+float uniform(float lo, float hi)
+{
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 17;
+    g_rng ^= g_rng << 5;
+    return lo + (hi - lo) * (g_rng >> 8) * (1.0f / 16777216.0f);
+}
+
+template <uint8_t N>
+void benchHorizon(FILE *out, float dt_s)
+{
+    static MpcController<N> mpc;   // 大数组放静态区，与固件一致
+    mpc.configure(MpcModel::fromBoardConfig(dt_s), MpcWeights::fromBoardConfig(),
+                  BoardConfig::MPC_QP_ITERS, BoardConfig::MPC_DIST_ALPHA);
+
+    float c[2];
+    MpcModel::affineFromBoardConfig(dt_s, BoardConfig::AMBIENT_TEMP_DEFAULT_C, c);
+
+    const uint32_t runs = 2000;
+    std::vector<double> ns_list;
+    ns_list.reserve(runs);
+    double sum_ns = 0.0;
+    float u[2] = {0.0f, 0.0f};
+    for (uint32_t i = 0; i < runs; ++i) {
+        const float x[2] = {uniform(0.0f, 80.0f), uniform(0.0f, 150.0f)};
+        const float r[2] = {uniform(20.0f, 70.0f), uniform(20.0f, 120.0f)};
+        const auto t0 = std::chrono::steady_clock::now();
+        mpc.solve(x, u, c, r, 0.0f, u);
+        const auto t1 = std::chrono::steady_clock::now();
+        const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        sum_ns += ns;
+        ns_list.push_back(ns);
+    }
+    // 求解路径与数据无关，最坏值主要来自主机调度抖动；同时给出 p99
+    std::sort(ns_list.begin(), ns_list.end());
+    const double p99_ns = ns_list[runs * 99 / 100];
+    const double max_ns = ns_list.back();
+
+    const uint32_t nv = MpcController<N>::NV;
+    const uint32_t macs = nv * nv * BoardConfig::MPC_QP_ITERS + nv * MpcController<N>::NY;
+    const uint32_t ram = sizeof(MpcController<N>);
+    // 板上粗估：Cortex-M4F @64 MHz，按每次乘加约 4 周期（两次装载 + VFMA + 循环开销）
+    const double est_m4_us = macs * 4.0 / 64.0;
+    fprintf(out, "%4u %8u %8u %10.0f %10.0f %10.0f %11.0f\n", static_cast<unsigned>(N),
+            static_cast<unsigned>(ram), static_cast<unsigned>(macs), sum_ns / runs, p99_ns, max_ns,
+            est_m4_us);
+}
+
+} // namespace
+
+void runMpcBench(FILE *out)
+{
+    const float dt_s = BoardConfig::CONTROL_PERIOD_US * 1e-6f * BoardConfig::MPC_PERIOD_TICKS;
+    fprintf(out, "MPC solve (iters=%u, dt=%.1fs)\n", static_cast<unsigned>(BoardConfig::MPC_QP_ITERS), dt_s);
+    fprintf(out, "%4s %8s %8s %10s %10s %10s %11s\n", "N", "ram_B", "macs", "ns_avg", "ns_p99", "ns_max",
+            "est_m4_us");
+    benchHorizon<5>(out, dt_s);
+    benchHorizon<10>(out, dt_s);
+    benchHorizon<20>(out, dt_s);
+    benchHorizon<30>(out, dt_s);
+}
@@ -0,0 +1,7 @@
+// sim/MpcBench.h
+#pragma once
+
+#include <stdio.h>
+
+// MpcController 求解耗时基准：不同预测时域下单次 solve() 的平均/最坏主机耗时与乘加次数
+void runMpcBench(FILE *out);
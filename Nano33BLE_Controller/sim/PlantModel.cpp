@@ -0,0 +1,69 @@
+// sim/PlantModel.cpp
+#include "PlantModel.h"
+
+#include <math.h>
+
+void PlantModel::reset(const Params &p, float t0_c)
+{
+    p_ = p;
+    t_c_ = t0_c;
+    p_pa_ = p_.p_ref_pa + p_.dpdt_pa_k * (t0_c - p_.t_ref_c);
+    t_sensor_c_ = t0_c;
+    for (int i = 0; i < kDelayLen; ++i) delay_buf_[i] = t0_c;
+    delay_head_ = 0;
+    delay_steps_ = 0;
+    last_dt_s_ = 0.0f;
+    rng_ = 0x12345678u;
+}
+
+void PlantModel::step(float dt_s, float u_heater_pct, float u_valve_pct)
+{
+    const float uh = fminf(fmaxf(u_heater_pct, 0.0f), 100.0f) * 0.01f;
+    const float uv = fminf(fmaxf(u_valve_pct, 0.0f), 100.0f) * 0.01f;
+
+    const float dp_vent = fmaxf(p_pa_ - p_.p_atm_pa, 0.0f);
+
+    const float q = p_.heater_max_w * uh
+                  - p_.ua_w_k * (t_c_ - p_.ambient_c)
+                  - p_.vent_cool_w_pa * uv * dp_vent;
+    t_c_ += dt_s * q / p_.heat_cap_j_k;
+
+    const float p_eq = p_.p_ref_pa + p_.dpdt_pa_k * (t_c_ - p_.t_ref_c);
+    p_pa_ += dt_s * ((p_eq - p_pa_) / p_.tau_p_s - p_.k_vent_per_s * uv * dp_vent);
+    if (p_pa_ < p_.p_atm_pa) p_pa_ = p_.p_atm_pa;
+
+    // 测温：纯延迟 -> 一阶滞后
+    if (dt_s != last_dt_s_) {
+        last_dt_s_ = dt_s;
+        int n = static_cast<int>(p_.sensor_delay_s / dt_s + 0.5f);
+        if (n >= kDelayLen) n = kDelayLen - 1;
+        delay_steps_ = n;
+    }
+    delay_buf_[delay_head_] = t_c_;
+    const int tail = (delay_head_ - delay_steps_ + kDelayLen) % kDelayLen;
+    delay_head_ = (delay_head_ + 1) % kDelayLen;
+    const float delayed = delay_buf_[tail];
+
+    const float a = (p_.sensor_tau_s > 0.0f) ? (dt_s / (p_.sensor_tau_s + dt_s)) : 1.0f;
+    t_sensor_c_ += a * (delayed - t_sensor_c_);
+}
+
+float PlantModel::noise(float amp)
+{
+    // xorshift32：确定性，保证 CI 结果可复现
+    rng_ ^= rng_ << 13;
+    rng_ ^= rng_ >> 17;
+    rng_ ^= rng_ << 5;
+    const float u = static_cast<float>(rng_ & 0xFFFFFFu) / static_cast<float>(0xFFFFFFu);
+    return amp * (2.0f * u - 1.0f);
+}
+
+float PlantModel::measuredTempC()
+{
+    return t_sensor_c_ + noise(p_.temp_noise_c);
+}
+
+float PlantModel::measuredPressurePa()
+{
+    return p_pa_ + noise(p_.press_noise_pa);
+}
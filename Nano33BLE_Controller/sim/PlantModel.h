@@ -0,0 +1,62 @@
+// sim/PlantModel.h
+#pragma once
+
+#include <stdint.h>
+
+// 集总参数对象模型（储罐 + 加热片 + 排气阀）：
+// - 热：C·dT/dt = Pmax·u_h - UA·(T - T_amb) - L·u_v·(P - P_atm)
+// - 压力：dP/dt = (P_eq(T) - P)/tau_p - k_vent·u_v·(P - P_atm)，P_eq(T) = P_ref + dPdT·(T - T_ref)
+// - 测温：一阶传感器滞后 + 纯延迟；可叠加确定性噪声
+// 参数仅用于比较控制器改动，不代表真实储罐。
+
+class PlantModel {
+public:
+    struct Params {
+        float heater_max_w   = 50.0f;     // 100% 加热功率（W）
+        float heat_cap_j_k   = 200.0f;    // 热容（J/K）
+        float ua_w_k         = 0.5f;      // 对环境散热系数（W/K）
+        float ambient_c      = 20.0f;
+        float vent_cool_w_pa = 1.0e-4f;   // 阀门全开时每 Pa 压差带走的功率（W/Pa）
+
+        float p_atm_pa       = 0.0f;      // 表压基准
+        float p_ref_pa       = 20000.0f;  // T_ref 时的平衡压力
+        float t_ref_c        = 20.0f;
+        float dpdt_pa_k      = 2000.0f;   // 平衡压力随温度斜率
+        float tau_p_s        = 30.0f;
+        float k_vent_per_s   = 0.05f;     // 阀门全开时的排气速率
+
+        float sensor_tau_s   = 5.0f;      // 测温滞后
+        float sensor_delay_s = 2.0f;      // 测温纯延迟
+        float temp_noise_c   = 0.02f;     // 测温噪声幅值
+        float press_noise_pa = 50.0f;     // 测压噪声幅值
+    };
+
+    void reset(const Params &p, float t0_c);
+
+    // 推进 dt，u_heater / u_valve 为 0..100 %
+    void step(float dt_s, float u_heater_pct, float u_valve_pct);
+
+    float trueTempC() const { return t_c_; }
+    float truePressurePa() const { return p_pa_; }
+
+    // 传感器读数（含滞后/延迟/噪声）
+    float measuredTempC();
+    float measuredPressurePa();
+
+private:
+    static constexpr int kDelayLen = 1024;
+
+    Params p_;
+    float t_c_ = 20.0f;
+    float p_pa_ = 0.0f;
+    float t_sensor_c_ = 20.0f;
+
+    // 纯延迟环形缓冲：每次 step 写入一次
+    float delay_buf_[kDelayLen] = {0};
+    int   delay_head_ = 0;
+    int   delay_steps_ = 0;
+    float last_dt_s_ = 0.0f;
+
+    uint32_t rng_ = 0x12345678u;
+    float noise(float amp);
+};
@@ -0,0 +1,124 @@
+// sim/RtdBench.cpp
+#include "RtdBench.h"
+
+#include <chrono>
+#include <math.h>
+
+#include "../src/util/RtdTable.h"
+
+namespace {
+
+// 旧版 Max31865Driver::resistanceToTempC（正温区解析解 + 负温区 5 阶多项式），仅作对照
+float legacyTempC(float rt_ohm, float r0)
+{
+    const float a = BoardConfig::PT100_A;
+    const float b = BoardConfig::PT100_B;
+    float temp = (sqrtf(a * a - 4.0f * b + (4.0f * b / r0) * rt_ohm) - a) / (2.0f * b);
+    if (temp >= 0.0f) return temp;
+
+    // 多项式按 PT100 电阻给出；PT1000 先折算到 100 Ω
+    const float r = rt_ohm * (100.0f / r0);
+    float rpoly = r;
+    temp = -242.02f + 2.2228f * rpoly;
+    rpoly *= r;
+    temp += 2.5859e-3f * rpoly;
+    rpoly *= r;
+    temp -= 4.8260e-6f * rpoly;
+    rpoly *= r;
+    temp -= 2.8183e-8f * rpoly;
+    rpoly *= r;
+    temp += 1.5243e-10f * rpoly;
+    return temp;
+}
+
+struct Err {
+    double cryo = 0.0;   // -259..-200 °C（低温表）
+    double cold = 0.0;   // -200..0 °C
+    double warm = 0.0;   // 0..850 °C
+};
+
+// 精确反解：-200 °C 以下按低温段模型，其余按 CVD
+double exactTempC(double ratio)
+{
+    return (ratio < RtdCvdTable::ratioAt(RtdCvdTable::T_MIN_C)) ? RtdLowTable::tempAt(ratio)
+                                                               : RtdCvdTable::tempAt(ratio);
+}
+
+double &slotFor(Err &e, double t)
+{
+    if (t < RtdCvdTable::T_MIN_C) return e.cryo;
+    return (t < 0.0) ? e.cold : e.warm;
+}
+
+volatile float g_sink = 0.0f;
+
+bool benchSensor(FILE *out, const char *name, float r0, float rref)
+{
+    RtdConverter conv;
+    conv.configure(r0, rref);
+
+    Err tab_err, old_err;
+    uint32_t n = 0;
+    for (uint32_t code = 1; code < 0x7FFF; ++code) {
+        const double ratio = code * (static_cast<double>(rref) / 32768.0) / r0;
+        if (ratio < RtdLowTable::ratioAt(RtdLowTable::T_MIN_C) || ratio > RtdCvdTable::ratioAt(RtdCvdTable::T_MAX_C)) {
+            continue;
+        }
+        const double exact = exactTempC(ratio);
+        float t_tab = NAN;
+        if (!conv.codeToTempC(static_cast<uint16_t>(code), t_tab)) continue;
+        const float t_old = legacyTempC(conv.codeToOhm(static_cast<uint16_t>(code)), r0);
+
+        double &slot_tab = slotFor(tab_err, exact);
+        double &slot_old = slotFor(old_err, exact);
+        slot_tab = fmax(slot_tab, fabs(t_tab - exact));
+        slot_old = fmax(slot_old, fabs(t_old - exact));
+        ++n;
+    }
+
+    // 耗时：对全部有效码值循环若干遍
+    const uint16_t lo = static_cast<uint16_t>(ceil(RtdLowTable::ratioAt(RtdLowTable::T_MIN_C) * r0 * 32768.0 / rref));
+    const uint16_t hi = static_cast<uint16_t>(fmin(0x7FFE, RtdCvdTable::ratioAt(850.0) * r0 * 32768.0 / rref));
+    const uint32_t reps = 20;
+    float acc = 0.0f;
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t k = 0; k < reps; ++k) {
+        for (uint16_t code = lo; code <= hi; ++code) {
+            float t = 0.0f;
+            conv.codeToTempC(code, t);
+            acc += t;
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (uint32_t k = 0; k < reps; ++k) {
+        for (uint16_t code = lo; code <= hi; ++code) acc += legacyTempC(conv.codeToOhm(code), r0);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    g_sink = acc;
+
+    const double conv_n = static_cast<double>(reps) * (hi - lo + 1);
+    const double ns_tab = std::chrono::duration<double, std::nano>(t1 - t0).count() / conv_n;
+    const double ns_old = std::chrono::duration<double, std::nano>(t2 - t1).count() / conv_n;
+
+    fprintf(out, "%-8s %6u  table: err_cryo=%.4f err_cold=%.4f err_warm=%.4f ns=%.1f   "
+                 "legacy: err_cryo=%.4f err_cold=%.4f err_warm=%.4f ns=%.1f\n",
+            name, static_cast<unsigned>(n), tab_err.cryo, tab_err.cold, tab_err.warm, ns_tab,
+            old_err.cryo, old_err.cold, old_err.warm, ns_old);
+
+    // 表误差应远小于 15-bit 量化（PT100/402Ω 约 0.03 °C/LSB；低温段斜率小，-259 °C 附近约 0.25 °C/LSB）
+    return tab_err.cryo < 0.05 && tab_err.cold < 0.01 && tab_err.warm < 0.01;
+}
+
+} // namespace
+
+bool runRtdBench(FILE *out)
+{
+    fprintf(out, "RTD code->temp vs exact inversion (-259..-200 C low-temp model, -200..850 C CVD), "
+                 "table size %u + %u, max |err| in C\n",
+            static_cast<unsigned>(RtdLowTable::SIZE), static_cast<unsigned>(RtdCvdTable::SIZE));
+    bool ok = true;
+    ok = benchSensor(out, "PT100", 100.0f, 402.0f) && ok;
+    ok = benchSensor(out, "PT1000", 1000.0f, 4300.0f) && ok;
+    fprintf(out, "%s\n", ok ? "PASS" : "FAIL");
+    return ok;
+}
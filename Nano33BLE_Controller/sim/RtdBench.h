@@ -0,0 +1,8 @@
+// sim/RtdBench.h
+#pragma once
+
+#include <stdio.h>
+
+// RTD 查表换算对比：与精确 CVD 反解比较误差，并统计单次换算耗时（含旧版 sqrtf + 多项式）
+// 误差超限返回 false
+bool runRtdBench(FILE *out);
@@ -0,0 +1,551 @@
+// sim/Scenarios.cpp
+#include "Scenarios.h"
+
+#include <chrono>
+#include <math.h>
+
+#include "../src/util/BoardConfig.h"
+#include "SimRunner.h"
+
+namespace {
+
+constexpr uint32_t kTicksPerSec = 1000000UL / BoardConfig::CONTROL_PERIOD_US;
+
+// 阶跃响应指标
+class StepMetrics {
+public:
+    void start(float t_s, float y0, float sp, float abs_band)
+    {
+        t0_ = t_s;
+        sp_ = sp;
+        step_ = sp - y0;
+        band_ = fmaxf(abs_band, 0.02f * fabsf(step_));
+        last_out_s_ = t_s;
+        max_over_ = 0.0f;
+        active_ = true;
+    }
+
+    void sample(float t_s, float y)
+    {
+        if (!active_) return;
+        if (fabsf(y - sp_) > band_) last_out_s_ = t_s;
+        const float over = (step_ >= 0.0f) ? (y - sp_) : (sp_ - y);
+        if (over > max_over_) max_over_ = over;
+    }
+
+    // 结束时仍需在带内保持 hold_s，否则视为未稳定（返回 -1）
+    float settleS(float t_end_s, float hold_s) const
+    {
+        if (!active_ || t_end_s - last_out_s_ < hold_s) return -1.0f;
+        return last_out_s_ - t0_;
+    }
+
+    float overshootPct() const
+    {
+        if (!active_ || fabsf(step_) < 1e-6f) return 0.0f;
+        return 100.0f * max_over_ / fabsf(step_);
+    }
+
+private:
+    bool  active_ = false;
+    float t0_ = 0.0f, sp_ = 0.0f, step_ = 0.0f, band_ = 0.0f;
+    float last_out_s_ = 0.0f, max_over_ = 0.0f;
+};
+
+void traceHeader(FILE *trace)
+{
+    if (trace) fprintf(trace, "t_s,mode,T_true,T_meas,P_true,heater_pct,valve_pct\n");
+}
+
+void traceRow(SimRunner &sim, FILE *trace)
+{
+    fprintf(trace, "%.2f,%u,%.3f,%.3f,%.1f,%.2f,%.2f\n",
+            sim.timeS(), static_cast<unsigned>(sim.state.mode),
+            sim.plant.trueTempC(), sim.telem.temp_c[BoardConfig::TEMP_CTRL_CHANNEL],
+            sim.plant.truePressurePa(), sim.act.heaterPct(), sim.act.valvePct());
+}
+
+// 运行至 t_end_s，每拍结束后调用 each(sim)
+template <typename F>
+void runUntil(SimRunner &sim, float t_end_s, FILE *trace, F &&each)
+{
+    const uint32_t end_ticks = static_cast<uint32_t>(t_end_s * kTicksPerSec + 0.5f);
+    while (sim.ticks() < end_ticks) {
+        sim.tick();
+        each(sim);
+        if (trace && sim.ticks() % kTicksPerSec == 0) traceRow(sim, trace);
+    }
+}
+
+void runUntil(SimRunner &sim, float t_end_s, FILE *trace)
+{
+    runUntil(sim, t_end_s, trace, [](SimRunner &) {});
+}
+
+class WallTimer {
+public:
+    WallTimer() : t0_(std::chrono::steady_clock::now()) {}
+    double seconds() const
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0_).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point t0_;
+};
+
+void finish(ScenarioResult &r, const SimRunner &sim, const WallTimer &wt)
+{
+    r.safety_trips = sim.safety_trips;
+    r.ticks = sim.ticks();
+    r.sim_s = sim.timeS();
+    r.ctrl_ns_avg = sim.ticks() ? static_cast<float>(sim.ctrl_ns_sum) / sim.ticks() : 0.0f;
+    r.ctrl_ns_max = static_cast<float>(sim.ctrl_ns_max);
+    r.wall_s = wt.seconds();
+}
+
+void enterManual(SimRunner &sim, float heater_pct)
+{
+    sim.state.mode = ControlMode::MANUAL;
+    sim.state.manual_cmd.has_heater_cmd = true;
+    sim.state.manual_cmd.heater_power_pct = heater_pct;
+}
+
+void enterAutoTemp(SimRunner &sim, float temp_c)
+{
+    sim.state.setpoints = Proto::Setpoints{};
+    sim.state.setpoints.target_temp_c = temp_c;
+    sim.state.setpoints.enable_temp_ctrl = true;
+    sim.state.mode = ControlMode::AUTO;
+}
+
+// ---------------- 场景 ----------------
+
+// 温度环 20 -> 40 °C 阶跃
+ScenarioResult runTempStep(FILE *trace)
+{
+    WallTimer wt;
+    SimRunner sim;
+    sim.begin(PlantModel::Params{}, 20.0f);
+    traceHeader(trace);
+
+    const float t_end = 3600.0f;
+    enterAutoTemp(sim, 40.0f);
+    StepMetrics m;
+    m.start(0.0f, 20.0f, 40.0f, 0.5f);
+    runUntil(sim, t_end, trace, [&m](SimRunner &s) { m.sample(s.timeS(), s.plant.trueTempC()); });
+
+    ScenarioResult r;
+    r.settle_s = m.settleS(t_end, 300.0f);
+    r.overshoot_pct = m.overshootPct();
+    finish(r, sim, wt);
+    r.pass = r.settle_s >= 0.0f && r.settle_s < 2400.0f && r.overshoot_pct < 15.0f && r.safety_trips == 0;
+    return r;
+}
+
+// 串级压力控制：P 设定 60 kPa，T 上限 70 °C
+ScenarioResult runPressureCascade(FILE *trace)
+{
+    WallTimer wt;
+    SimRunner sim;
+    PlantModel::Params pp;
+    sim.begin(pp, 20.0f);
+    traceHeader(trace);
+
+    const float t_end = 5400.0f;
+    enterAutoTemp(sim, 70.0f);
+    sim.state.setpoints.target_pressure_pa = 60000.0f;
+    sim.state.setpoints.enable_pressure_ctrl = true;
+
+    StepMetrics m;
+    m.start(0.0f, pp.p_ref_pa, 60000.0f, 500.0f);
+    float late_err = 0.0f;   // 后半程最大偏差
+    runUntil(sim, t_end, trace, [&](SimRunner &s) {
+        m.sample(s.timeS(), s.plant.truePressurePa());
+        if (s.timeS() > 0.5f * t_end) late_err = fmaxf(late_err, fabsf(s.plant.truePressurePa() - 60000.0f));
+    });
+
+    ScenarioResult r;
+    r.settle_s = m.settleS(t_end, 300.0f);
+    r.overshoot_pct = m.overshootPct();
+    finish(r, sim, wt);
+    // 须稳定下来并保持在 ±500 Pa 内（不接受外环极限环）
+    r.pass = r.settle_s >= 0.0f && r.settle_s < 2400.0f && late_err < 500.0f &&
+             r.overshoot_pct < 20.0f && r.safety_trips == 0;
+    static char note[48];
+    snprintf(note, sizeof(note), "late_err=%.0fPa", late_err);
+    r.note = note;
+    return r;
+}
+
+// 仅压力环（直接驱动加热）：与串级对比
+ScenarioResult runPressureDirect(FILE *trace)
+{
+    WallTimer wt;
+    SimRunner sim;
+    PlantModel::Params pp;
+    sim.begin(pp, 20.0f);
+    traceHeader(trace);
+
+    const float t_end = 5400.0f;
+    sim.state.setpoints = Proto::Setpoints{};
+    sim.state.setpoints.enable_temp_ctrl = false;
+    sim.state.setpoints.target_pressure_pa = 60000.0f;
+    sim.state.setpoints.enable_pressure_ctrl = true;
+    sim.state.mode = ControlMode::AUTO;
+
+    StepMetrics m;
+    m.start(0.0f, pp.p_ref_pa, 60000.0f, 500.0f);
+    runUntil(sim, t_end, trace, [&m](SimRunner &s) { m.sample(s.timeS(), s.plant.truePressurePa()); });
+
+    ScenarioResult r;
+    r.settle_s = m.settleS(t_end, 300.0f);
+    r.overshoot_pct = m.overshootPct();
+    finish(r, sim, wt);
+    r.pass = r.safety_trips == 0;
+    r.note = "reference";
+    return r;
+}
+
+// 温度 + 压力同时跟踪（T 50 °C、P 70 kPa，需要排气）：MPC 同时决定加热与阀门
+ScenarioResult runMpc(FILE *trace)
+{
+    WallTimer wt;
+    SimRunner sim;
+    PlantModel::Params pp;
+    sim.begin(pp, 20.0f);
+    sim.mode_mgr.setAutoAlgorithm(AutoController::Algorithm::MPC);
+    traceHeader(trace);
+
+    const float t_end = 5400.0f;
+    enterAutoTemp(sim, 50.0f);
+    sim.state.setpoints.target_pressure_pa = 70000.0f;
+    sim.state.setpoints.enable_pressure_ctrl = true;
+
+    StepMetrics mt, mp;
+    mt.start(0.0f, 20.0f, 50.0f, 0.5f);
+    mp.start(0.0f, pp.p_ref_pa, 70000.0f, 500.0f);
+    runUntil(sim, t_end, trace, [&](SimRunner &s) {
+        mt.sample(s.timeS(), s.plant.trueTempC());
+        mp.sample(s.timeS(), s.plant.truePressurePa());
+    });
+
+    ScenarioResult r;
+    r.settle_s = fmaxf(mt.settleS(t_end, 300.0f), mp.settleS(t_end, 300.0f));
+    if (mt.settleS(t_end, 300.0f) < 0.0f || mp.settleS(t_end, 300.0f) < 0.0f) r.settle_s = -1.0f;
+    r.overshoot_pct = fmaxf(mt.overshootPct(), mp.overshootPct());
+    finish(r, sim, wt);
+    r.pass = r.settle_s >= 0.0f && r.overshoot_pct < 20.0f && r.safety_trips == 0;
+    static char note[64];
+    snprintf(note, sizeof(note), "T=%.2fC P=%.0fPa valve=%.1f%%",
+             sim.plant.trueTempC(), sim.plant.truePressurePa(), sim.act.valvePct());
+    r.note = note;
+    return r;
+}
+
+// MANUAL 30% 稳态后切 AUTO（设定 = 当前温度）：切换瞬间加热输出跳变应很小
+ScenarioResult runBumpless(FILE *trace)
+{
+    WallTimer wt;
+    SimRunner sim;
+    sim.begin(PlantModel::Params{}, 20.0f);
+    traceHeader(trace);
+
+    enterManual(sim, 30.0f);
+    runUntil(sim, 2400.0f, trace);
+
+    const float before = sim.act.heaterPct();
+    enterAutoTemp(sim, sim.telem.temp_c[BoardConfig::TEMP_CTRL_CHANNEL]);
+    float max_jump = 0.0f;
+    float prev = before;
+    const float t_switch = sim.timeS();
+    runUntil(sim, t_switch + 10.0f, trace, [&](SimRunner &s) {
+        max_jump = fmaxf(max_jump, fabsf(s.act.heaterPct() - prev));
+        prev = s.act.heaterPct();
+    });
+    runUntil(sim, t_switch + 600.0f, trace);
+
+    ScenarioResult r;
+    r.overshoot_pct = 0.0f;
+    finish(r, sim, wt);
+    r.pass = max_jump < 2.0f && r.safety_trips == 0;
+    static char note[48];
+    snprintf(note, sizeof(note), "max_jump=%.2f%%", max_jump);
+    r.note = note;
+    return r;
+}
+
+// 自整定 @40 °C，完成后以新参数保持：
+// 完成的那一拍应输出继电平均功率 bias，AUTO 第一拍由此无扰接续，之后以整定增益稳定在设定点
+ScenarioResult runAutotune(FILE *trace)
+{
+    WallTimer wt;
+    SimRunner sim;
+    sim.begin(PlantModel::Params{}, 20.0f);
+    traceHeader(trace);
+
+    enterAutoTemp(sim, 40.0f);
+    sim.state.mode = ControlMode::AUTOTUNE;
+
+    bool got = false;
+    RelayAutotuner::Result res;
+    float t_done = -1.0f;       // 转入 AUTO 的时刻
+    float last_tune_pct = -1.0f; // 整定最后一拍的加热输出
+    float jump = -1.0f;         // AUTO 第一拍相对该输出的跳变
+    float late_err = 0.0f;      // 转入 AUTO 后 hold_s 内最后 300 s 的最大温度偏差
+    ControlMode prev_mode = sim.state.mode;
+    const float hold_s = 1800.0f;
+    auto each = [&](SimRunner &s) {
+        if (!got && s.mode_mgr.takeAutotuneResult(res)) got = true;
+        const ControlMode mode = s.state.mode;
+        if (prev_mode == ControlMode::AUTOTUNE && mode == ControlMode::AUTO) {
+            // 整定完成的那一拍已把模式切为 AUTO，本拍输出即整定的最后输出
+            t_done = s.timeS();
+            last_tune_pct = s.act.heaterPct();
+        } else if (t_done >= 0.0f && jump < 0.0f) {
+            jump = fabsf(s.act.heaterPct() - last_tune_pct);
+        }
+        if (t_done >= 0.0f && s.timeS() > t_done + hold_s - 300.0f) {
+            late_err = fmaxf(late_err, fabsf(s.plant.trueTempC() - 40.0f));
+        }
+        prev_mode = mode;
+    };
+    runUntil(sim, BoardConfig::TUNE_TIMEOUT_MS / 1000.0f + 60.0f, trace, each);
+    if (t_done >= 0.0f) runUntil(sim, t_done + hold_s, trace, each);
+
+    ScenarioResult r;
+    finish(r, sim, wt);
+    r.pass = got && res.status == RelayAutotuner::Status::DONE &&
+             sim.state.mode == ControlMode::AUTO && r.safety_trips == 0 &&
+             fabsf(last_tune_pct - BoardConfig::TUNE_RELAY_BIAS_PCT) < 0.01f &&
+             jump >= 0.0f && jump < 5.0f && late_err < 0.5f;
+    static char note[96];
+    snprintf(note, sizeof(note), "Ku=%.2f Tu=%.1fs u=%.1f%%->+%.2f%% late_err=%.2fC",
+             res.ku, res.tu_s, last_tune_pct, jump, late_err);
+    r.note = note;
+    return r;
+}
+
+// 自整定完成但增益被拒绝：不进入 AUTO，转 SAFE，生效增益不变
+ScenarioResult runAutotuneReject(FILE *trace)
+{
+    WallTimer wt;
+    SimRunner sim;
+    sim.begin(PlantModel::Params{}, 20.0f);
+    traceHeader(trace);
+
+    sim.mode_mgr.setGainCheck([](void *, float, float, float) { return false; }, nullptr);
+    const AutoController::Tuning before = sim.mode_mgr.autoController().tuning();
+    enterAutoTemp(sim, 40.0f);
+    sim.state.mode = ControlMode::AUTOTUNE;
+
+    bool got = false;
+    bool entered_auto = false;
+    RelayAutotuner::Result res;
+    runUntil(sim, BoardConfig::TUNE_TIMEOUT_MS / 1000.0f + 60.0f, trace, [&](SimRunner &s) {
+        if (!got && s.mode_mgr.takeAutotuneResult(res)) got = true;
+        if (s.state.mode == ControlMode::AUTO) entered_auto = true;
+    });
+
+    const AutoController::Tuning &after = sim.mode_mgr.autoController().tuning();
+    ScenarioResult r;
+    finish(r, sim, wt);
+    r.pass = got && res.status == RelayAutotuner::Status::REJECTED && !entered_auto &&
+             sim.state.mode == ControlMode::SAFE && sim.act.heaterPct() == 0.0f &&
+             after.temp_kp == before.temp_kp && after.temp_ki == before.temp_ki &&
+             after.temp_kd == before.temp_kd && r.safety_trips == 0;
+    static char note[64];
+    snprintf(note, sizeof(note), "status=%u kp=%.2f (kept %.2f)",
+             static_cast<unsigned>(res.status), res.kp, after.temp_kp);
+    r.note = note;
+    return r;
+}
+
+// MANUAL 100% 加热：应触发过温保护
+ScenarioResult runOverTemp(FILE *trace)
+{
+    WallTimer wt;
+    SimRunner sim;
+    sim.begin(PlantModel::Params{}, 20.0f);
+    traceHeader(trace);
+
+    enterManual(sim, 100.0f);
+    float peak = 0.0f;
+    runUntil(sim, 1800.0f, trace, [&peak](SimRunner &s) { peak = fmaxf(peak, s.plant.trueTempC()); });
+
+    ScenarioResult r;
+    finish(r, sim, wt);
+    r.pass = r.safety_trips >= 1 && sim.state.mode == ControlMode::SAFE &&
+             peak < BoardConfig::SAFETY_MAX_TEMP_C + 5.0f;
+    static char note[48];
+    snprintf(note, sizeof(note), "peak=%.2fC", peak);
+    r.note = note;
+    return r;
+}
+
+// AUTO 稳态后心跳中断：应在 LINK_TIMEOUT_MS 后强制 SAFE
+ScenarioResult runLinkLoss(FILE *trace)
+{
+    WallTimer wt;
+    SimRunner sim;
+    sim.begin(PlantModel::Params{}, 20.0f);
+    traceHeader(trace);
+
+    enterAutoTemp(sim, 40.0f);
+    runUntil(sim, 600.0f, trace);
+
+    sim.link_ok = false;
+    const float t_loss = sim.timeS();
+    float t_safe = -1.0f;
+    runUntil(sim, t_loss + 10.0f, trace, [&](SimRunner &s) {
+        if (t_safe < 0.0f && s.state.mode == ControlMode::SAFE) t_safe = s.timeS() - t_loss;
+    });
+
+    ScenarioResult r;
+    finish(r, sim, wt);
+    const float limit_s = BoardConfig::LINK_TIMEOUT_MS / 1000.0f + 0.05f;
+    r.pass = t_safe >= 0.0f && t_safe <= limit_s && sim.act.heaterPct() == 0.0f;
+    static char note[48];
+    snprintf(note, sizeof(note), "safe_after=%.2fs", t_safe);
+    r.note = note;
+    return r;
+}
+
+// AUTO 稳态后控制通道测温失效：加热输出应立即归零
+ScenarioResult runSensorFault(FILE *trace)
+{
+    WallTimer wt;
+    SimRunner sim;
+    sim.begin(PlantModel::Params{}, 20.0f);
+    traceHeader(trace);
+
+    enterAutoTemp(sim, 40.0f);
+    runUntil(sim, 600.0f, trace);
+
+    sim.sensors.setTempFault(true);
+    sim.tick();
+    const float heater_after = sim.act.heaterPct();
+    runUntil(sim, sim.timeS() + 60.0f, trace);
+
+    ScenarioResult r;
+    finish(r, sim, wt);
+    r.pass = heater_after == 0.0f && sim.act.heaterPct() == 0.0f;
+    return r;
+}
+
+// MANUAL 100% 加热，对象参数使指定联锁条件先于过温成立：检查跳闸原因与输出即时关断
+ScenarioResult runInterlock(const PlantModel::Params &pp, uint8_t expect_mask, FILE *trace)
+{
+    WallTimer wt;
+    SimRunner sim;
+    sim.begin(pp, 20.0f);
+    traceHeader(trace);
+
+    enterManual(sim, 100.0f);
+    float t_trip = -1.0f;
+    float heater_at_trip = -1.0f;
+    float temp_at_trip = 0.0f;
+    runUntil(sim, 1800.0f, trace, [&](SimRunner &s) {
+        if (t_trip < 0.0f && s.safety.activeMask() != 0) {
+            t_trip = s.timeS();
+            heater_at_trip = s.act.heaterPct();
+            temp_at_trip = s.plant.trueTempC();
+        }
+    });
+
+    const SafetyManager::Stats st = sim.safety.takeStats();
+    ScenarioResult r;
+    finish(r, sim, wt);
+    r.pass = t_trip >= 0.0f && (st.last_trip_mask & expect_mask) != 0 && heater_at_trip == 0.0f &&
+             sim.state.mode == ControlMode::SAFE;
+    static char note[64];
+    snprintf(note, sizeof(note), "trip=0x%02X@%.1fs T=%.1fC", st.last_trip_mask, t_trip, temp_at_trip);
+    r.note = note;
+    return r;
+}
+
+// 压力随温度陡升（约 56 °C 达到 SAFETY_MAX_PRESS_PA）：超压联锁
+ScenarioResult runOverPressure(FILE *trace)
+{
+    PlantModel::Params pp;
+    pp.dpdt_pa_k = 5000.0f;
+    pp.tau_p_s = 5.0f;
+    return runInterlock(pp, SafetyManager::TRIP_OVERPRESS, trace);
+}
+
+// 加热功率放大 8 倍（约 2 °C/s）：温升速率联锁
+ScenarioResult runRateOfRise(FILE *trace)
+{
+    PlantModel::Params pp;
+    pp.heater_max_w = 400.0f;
+    return runInterlock(pp, SafetyManager::TRIP_TEMP_RATE, trace);
+}
+
+// 设定值程序：AUTO 20 °C 起，斜坡到 35 °C（20 min）-> 保持 5 min -> 阶跃到 30 °C 保持 15 min
+ScenarioResult runProgram(FILE *trace)
+{
+    WallTimer wt;
+    SimRunner sim;
+    sim.begin(PlantModel::Params{}, 20.0f);
+    traceHeader(trace);
+
+    enterAutoTemp(sim, 20.0f);
+    Proto::ProgramSegmentV1 segs[3] = {};
+    segs[0].type = Proto::PROGRAM_SEG_RAMP;
+    segs[0].enable_mask = Proto::SP_ENABLE_TEMP;
+    segs[0].temp_c = 35.0f;
+    segs[0].duration_ms = 1200000;
+    segs[1].type = Proto::PROGRAM_SEG_HOLD;
+    segs[1].duration_ms = 300000;
+    segs[2].type = Proto::PROGRAM_SEG_STEP;
+    segs[2].enable_mask = Proto::SP_ENABLE_TEMP;
+    segs[2].temp_c = 30.0f;
+    segs[2].duration_ms = 900000;
+    const bool loaded = sim.program.load(segs, 3);
+    const bool started = sim.program.command(Proto::PROGRAM_OP_START, sim.state, sim.nowMs());
+
+    // 斜坡后半段的跟踪误差（前半段含启动滞后）；结束时设定值与温度
+    float ramp_err = 0.0f;
+    runUntil(sim, 2410.0f, trace, [&](SimRunner &s) {
+        const float t = s.timeS();
+        if (t > 600.0f && t < 1200.0f) {
+            ramp_err = fmaxf(ramp_err, fabsf(s.plant.trueTempC() - s.state.setpoints.target_temp_c));
+        }
+    });
+
+    const SetpointProgram::Status &st = sim.program.status();
+    const float final_err = fabsf(sim.plant.trueTempC() - 30.0f);
+    ScenarioResult r;
+    finish(r, sim, wt);
+    r.pass = loaded && started && st.state == Proto::PROGRAM_DONE && st.sp_temp_c == 30.0f &&
+             ramp_err < 1.5f && final_err < 0.5f && r.safety_trips == 0;
+    static char note[64];
+    snprintf(note, sizeof(note), "ramp_err=%.2fC end_err=%.2fC state=%u", ramp_err, final_err,
+             static_cast<unsigned>(st.state));
+    r.note = note;
+    return r;
+}
+
+const Scenario kScenarios[] = {
+    {"temp_step",     "AUTO 温度 20->40 °C 阶跃",       runTempStep},
+    {"press_cascade", "串级压力 60 kPa（T 上限 70 °C）", runPressureCascade},
+    {"press_direct",  "单压力环 60 kPa（对照）",        runPressureDirect},
+    {"mpc",           "MPC 温度 50 °C + 压力 70 kPa",   runMpc},
+    {"bumpless",      "MANUAL 30% -> AUTO 无扰切换",    runBumpless},
+    {"autotune",      "继电自整定 @40 °C",              runAutotune},
+    {"tune_reject",   "自整定增益被拒绝 -> SAFE",       runAutotuneReject},
+    {"overtemp",      "MANUAL 100% 过温保护",           runOverTemp},
+    {"link_loss",     "AUTO 中心跳中断",                runLinkLoss},
+    {"sensor_fault",  "AUTO 中控制通道测温失效",        runSensorFault},
+    {"overpress",     "MANUAL 100% 超压联锁",           runOverPressure},
+    {"rate_rise",     "MANUAL 100% 温升速率联锁",       runRateOfRise},
+    {"program",       "设定值程序 斜坡/保持/阶跃",      runProgram},
+};
+
+} // namespace
+
+const Scenario *scenarioList(uint8_t &count)
+{
+    count = static_cast<uint8_t>(sizeof(kScenarios) / sizeof(kScenarios[0]));
+    return kScenarios;
+}
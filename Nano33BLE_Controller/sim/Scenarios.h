@@ -0,0 +1,32 @@
+// sim/Scenarios.h
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+
+// 仿真场景：每个场景给出输入序列与通过条件（用于 CI 回归）。
+// 阶跃指标：settling = 最后一次离开误差带（±max(0.5, 2%·|阶跃量|)）的时刻；
+//           overshoot = 超出设定值的最大量 / 阶跃量。
+
+struct ScenarioResult {
+    bool     pass = false;
+    const char *note = "";
+
+    float    settle_s = -1.0f;       // <0：未进入稳定带
+    float    overshoot_pct = 0.0f;
+    uint32_t safety_trips = 0;
+
+    uint32_t ticks = 0;
+    float    sim_s = 0.0f;
+    float    ctrl_ns_avg = 0.0f;
+    float    ctrl_ns_max = 0.0f;
+    double   wall_s = 0.0;
+};
+
+struct Scenario {
+    const char *name;
+    const char *desc;
+    ScenarioResult (*run)(FILE *trace);   // trace 非空时按 1 Hz 输出 CSV
+};
+
+const Scenario *scenarioList(uint8_t &count);
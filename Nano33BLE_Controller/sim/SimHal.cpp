@@ -0,0 +1,41 @@
+// sim/SimHal.cpp
+#include "SimHal.h"
+
+#include <math.h>
+
+#include "../src/util/BoardConfig.h"
+
+static float clampPct(float v)
+{
+    if (!isfinite(v)) return 0.0f;
+    if (v < 0.0f) v = 0.0f;
+    if (v > 100.0f) v = 100.0f;
+    return v;
+}
+
+void SimSensors::readAll(Proto::Telemetry &telem, uint32_t now_ms)
+{
+    telem.timestamp_ms = now_ms;
+
+    telem.temp_count = BoardConfig::TEMP_SENSOR_COUNT;
+    telem.temp_fresh_mask = 0;
+    const float t_meas = plant_->measuredTempC();
+    for (uint8_t i = 0; i < telem.temp_count; ++i) {
+        float v = (i == BoardConfig::TEMP_CTRL_CHANNEL) ? t_meas : 20.0f;
+        if (temp_fault_ && i == BoardConfig::TEMP_CTRL_CHANNEL) v = NAN;
+        telem.temp_c[i] = v;
+        telem.temp_sample_ms[i] = now_ms;
+        telem.temp_fresh_mask |= static_cast<uint8_t>(1u << i);
+    }
+
+    telem.env_temp_c = NAN;
+    telem.pressure_pa = plant_->measuredPressurePa();
+    telem.pressure_sample_ms = now_ms;
+    telem.pressure_fresh = true;
+}
+
+void SimActuators::apply(const Proto::Outputs &out)
+{
+    heater_pct_ = clampPct(out.heater_power_pct);
+    valve_pct_ = clampPct(out.valve_opening_pct);
+}
@@ -0,0 +1,38 @@
+// sim/SimHal.h
+#pragma once
+
+#include <stdint.h>
+
+#include "../src/proto/Messages.h"
+#include "PlantModel.h"
+
+// 替代 hw/Sensors、hw/Actuators 的仿真 HAL：
+// - SimSensors：按控制器 Sensors 的语义填充 Telemetry（通道数、采样时间戳、fresh 标记）
+// - SimActuators：与驱动一致的钳位（NaN -> 0，0..100%）
+// 控制算法（ModeManager/AutoController/SafetyManager）使用真实源码。
+
+class SimSensors {
+public:
+    void attach(PlantModel *plant) { plant_ = plant; }
+
+    void readAll(Proto::Telemetry &telem, uint32_t now_ms);
+
+    // 故障注入：控制通道温度读数无效（模拟 PT100 断线）
+    void setTempFault(bool on) { temp_fault_ = on; }
+
+private:
+    PlantModel *plant_ = nullptr;
+    bool temp_fault_ = false;
+};
+
+class SimActuators {
+public:
+    void apply(const Proto::Outputs &out);
+
+    float heaterPct() const { return heater_pct_; }
+    float valvePct() const { return valve_pct_; }
+
+private:
+    float heater_pct_ = 0.0f;
+    float valve_pct_ = 0.0f;
+};
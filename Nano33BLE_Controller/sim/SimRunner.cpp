@@ -0,0 +1,93 @@
+// sim/SimRunner.cpp
+#include "SimRunner.h"
+
+#include <chrono>
+
+#include "../src/util/BoardConfig.h"
+
+uint64_t SimClock::now_us = 0;
+
+void SimRunner::begin(const PlantModel::Params &pp, float t0_c)
+{
+    SimClock::now_us = 0;
+    ticks_ = 0;
+    dt_s_ = static_cast<float>(BoardConfig::CONTROL_PERIOD_US) * 1e-6f;
+
+    plant.reset(pp, t0_c);
+    sensors.attach(&plant);
+
+    state.reset();
+    state.mode = ControlMode::SAFE;
+    telem = Proto::Telemetry{};
+    out = Proto::Outputs{};
+
+    mode_mgr.begin();
+    program = SetpointProgram{};
+    safety.begin();
+    safety.setForceOff(&SimRunner::forceOff, this);
+
+    link_ok = true;
+    safety_trips = 0;
+    ctrl_ns_sum = 0;
+    ctrl_ns_max = 0;
+}
+
+void SimRunner::forceOff(void *ctx)
+{
+    static_cast<SimRunner *>(ctx)->act.apply(Proto::Outputs{});
+}
+
+uint32_t SimRunner::nowMs() const
+{
+    return millis();
+}
+
+void SimRunner::tick()
+{
+    const uint32_t now_ms = millis();
+
+    if (link_ok) {
+        state.link_alive = true;
+        state.last_link_heartbeat_ms = now_ms;
+    }
+
+    sensors.readAll(telem, now_ms);
+    for (uint8_t i = 0; i < telem.temp_count; ++i) {
+        if (telem.temp_fresh_mask & (1u << i)) {
+            safety.onTempSample(i, telem.temp_c[i], isfinite(telem.temp_c[i]), micros());
+        }
+    }
+    if (telem.pressure_fresh) {
+        // 仿真无 ADS 码值：取带噪声 Pa 读数的低位代替（只用于卡死判定的变化检测）
+        const int16_t raw = isfinite(telem.pressure_pa) ? static_cast<int16_t>(lroundf(telem.pressure_pa) & 0x7FFF) : 0;
+        safety.onPressureSample(telem.pressure_pa, raw, isfinite(telem.pressure_pa), micros());
+    }
+
+    program.tick(state, telem, now_ms);
+
+    const ControlMode before = state.mode;
+    const auto t0 = std::chrono::steady_clock::now();
+    mode_mgr.compute(state, telem, out);
+    const ControlMode after_ctrl = state.mode;
+    safety.checkAndClamp(state, telem, out, now_ms);
+    const auto t1 = std::chrono::steady_clock::now();
+    (void)before;
+
+    if (after_ctrl != ControlMode::SAFE && state.mode == ControlMode::SAFE) {
+        ++safety_trips;
+    }
+
+    const uint64_t ns = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+    ctrl_ns_sum += ns;
+    if (ns > ctrl_ns_max) ctrl_ns_max = ns;
+
+    act.apply(out);
+    telem.heater_power_pct = act.heaterPct();
+    telem.valve_opening_pct = act.valvePct();
+
+    plant.step(dt_s_, act.heaterPct(), act.valvePct());
+
+    SimClock::advanceUs(BoardConfig::CONTROL_PERIOD_US);
+    ++ticks_;
+}
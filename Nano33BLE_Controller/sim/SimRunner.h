@@ -0,0 +1,52 @@
+// sim/SimRunner.h
+#pragma once
+
+#include <stdint.h>
+
+#include "../src/ctrl/ControlState.h"
+#include "../src/ctrl/ModeManager.h"
+#include "../src/ctrl/SetpointProgram.h"
+#include "../src/util/SafetyManager.h"
+#include "PlantModel.h"
+#include "SimHal.h"
+
+// 控制器在环仿真：按固定控制周期执行与固件相同的控制步
+//   采集 -> SetpointProgram::tick -> ModeManager::compute -> SafetyManager::checkAndClamp -> 输出 -> 对象推进
+// 每拍的新样本同时送入 SafetyManager 快速联锁，跳闸时经回调立即将仿真执行器置零。
+// 链路心跳由仿真按需维持（link_ok=false 模拟断链）。
+
+class SimRunner {
+public:
+    void begin(const PlantModel::Params &pp, float t0_c);
+
+    // 执行一个控制节拍并推进对象 dt = CONTROL_PERIOD_US
+    void tick();
+
+    float timeS() const { return static_cast<float>(ticks_) * dt_s_; }
+    uint32_t nowMs() const;
+
+    ControlState state;
+    Proto::Telemetry telem;
+    Proto::Outputs out;
+
+    PlantModel plant;
+    SimSensors sensors;
+    SimActuators act;
+    ModeManager mode_mgr;
+    SetpointProgram program;
+    SafetyManager safety;
+
+    bool link_ok = true;
+
+    // 统计
+    uint32_t safety_trips = 0;       // 安全管理将非 SAFE 模式切为 SAFE 的次数
+    uint64_t ctrl_ns_sum = 0;        // 控制计算（compute + safety）主机耗时
+    uint64_t ctrl_ns_max = 0;
+    uint32_t ticks() const { return ticks_; }
+
+private:
+    uint32_t ticks_ = 0;
+
+    static void forceOff(void *ctx);
+    float dt_s_ = 0.01f;
+};
@@ -0,0 +1,73 @@
+// sim/sim_main.cpp
+//
+// 控制器主机仿真（对象模型 + 真实控制源码，远快于实时）。
+// 构建与运行（在 Nano33BLE_Controller 目录下）：
+//   g++ -std=c++14 -O2 -Isim sim/*.cpp src/ctrl/*.cpp src/util/SafetyManager.cpp src/util/RtdTable.cpp -o controller_sim
+//   ./controller_sim                  # 运行全部场景，任一失败返回 1
+//   ./controller_sim temp_step        # 仅运行指定场景
+//   ./controller_sim --trace temp_step > trace.csv   # 1 Hz 时序 CSV 输出到 stdout，汇总表输出到 stderr
+//   ./controller_sim --bench-mpc      # MPC 各预测时域的单次求解耗时
+//   ./controller_sim --rtd            # RTD 查表换算与精确反解（含 -200 °C 以下低温段）对比 + 单次换算耗时（误差超限返回 1）
+
+#include <stdio.h>
+#include <string.h>
+
+#include "MpcBench.h"
+#include "RtdBench.h"
+#include "Scenarios.h"
+
+int main(int argc, char **argv)
+{
+    bool trace = false;
+    const char *only[16];
+    int only_n = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--trace") == 0) {
+            trace = true;
+        } else if (strcmp(argv[i], "--bench-mpc") == 0) {
+            runMpcBench(stdout);
+            return 0;
+        } else if (strcmp(argv[i], "--rtd") == 0) {
+            return runRtdBench(stdout) ? 0 : 1;
+        } else if (argv[i][0] == '-') {
+            fprintf(stderr, "usage: %s [--trace] [scenario...] | --bench-mpc | --rtd\n", argv[0]);
+            return 2;
+        } else if (only_n < 16) {
+            only[only_n++] = argv[i];
+        }
+    }
+
+    uint8_t n = 0;
+    const Scenario *list = scenarioList(n);
+
+    FILE *report = trace ? stderr : stdout;
+    fprintf(report, "%-14s %-5s %9s %8s %5s %9s %9s %8s  %s\n",
+            "scenario", "res", "settle_s", "ovs_%", "trips", "ns_avg", "ns_max", "x_rt", "note");
+
+    int failed = 0;
+    int ran = 0;
+    for (uint8_t i = 0; i < n; ++i) {
+        const Scenario &sc = list[i];
+        if (only_n > 0) {
+            bool hit = false;
+            for (int k = 0; k < only_n; ++k) hit = hit || strcmp(only[k], sc.name) == 0;
+            if (!hit) continue;
+        }
+
+        const ScenarioResult r = sc.run(trace ? stdout : nullptr);
+        ++ran;
+        if (!r.pass) ++failed;
+
+        const double x_rt = (r.wall_s > 0.0) ? r.sim_s / r.wall_s : 0.0;
+        fprintf(report, "%-14s %-5s %9.1f %8.2f %5u %9.0f %9.0f %8.0f  %s\n",
+                sc.name, r.pass ? "PASS" : "FAIL", r.settle_s, r.overshoot_pct,
+                static_cast<unsigned>(r.safety_trips), r.ctrl_ns_avg, r.ctrl_ns_max, x_rt, r.note);
+    }
+
+    if (ran == 0) {
+        fprintf(stderr, "no matching scenario\n");
+        return 2;
+    }
+    fprintf(report, "%d/%d passed\n", ran - failed, ran);
+    return failed ? 1 : 0;
+}
@@ -1,10 +1,283 @@
 // ctrl/AutoController.cpp
 #include "AutoController.h"
 
-void AutoController::compute(const ControlState & /*state*/, const Proto::Telemetry & /*telem*/, Proto::Outputs &out)
+#include <math.h>
+#include <string.h>
+
+#include "../util/BoardConfig.h"
+
+static float dtSeconds()
+{
+    return static_cast<float>(BoardConfig::CONTROL_PERIOD_US) * 1e-6f;
+}
+
+void AutoController::begin()
+{
+    tuning_.temp_kp      = BoardConfig::TEMP_PID_KP;
+    tuning_.temp_ki      = BoardConfig::TEMP_PID_KI;
+    tuning_.temp_kd      = BoardConfig::TEMP_PID_KD;
+    tuning_.temp_d_tau_s = BoardConfig::TEMP_PID_D_TAU_S;
+    tuning_.cascade_kp   = BoardConfig::PRESS_CASCADE_KP;
+    tuning_.cascade_ki   = BoardConfig::PRESS_CASCADE_KI;
+    tuning_.press_kp     = BoardConfig::PRESS_PID_KP;
+    tuning_.press_ki     = BoardConfig::PRESS_PID_KI;
+    tuning_.press_kd     = BoardConfig::PRESS_PID_KD;
+
+    configureTempPid();
+    temp_active_ = false;
+
+    configurePressPid(PressMode::DIRECT, 100.0f);
+    press_mode_ = PressMode::OFF;
+    temp_sp_eff_ = NAN;
+
+    const float mpc_dt = dtSeconds() * BoardConfig::MPC_PERIOD_TICKS;
+    mpc_.configure(MpcModel::fromBoardConfig(mpc_dt), MpcWeights::fromBoardConfig(),
+                   BoardConfig::MPC_QP_ITERS, BoardConfig::MPC_DIST_ALPHA);
+    mpc_active_ = false;
+    algo_ = BoardConfig::AUTO_USE_MPC ? Algorithm::MPC : Algorithm::PID;
+}
+
+void AutoController::setAlgorithm(Algorithm a)
+{
+    if (a == algo_) return;
+    algo_ = a;
+    temp_active_ = false;
+    press_mode_ = PressMode::OFF;
+    mpc_active_ = false;
+}
+
+void AutoController::setTempGains(float kp, float ki, float kd)
+{
+    tuning_.temp_kp = kp;
+    tuning_.temp_ki = ki;
+    tuning_.temp_kd = kd;
+    configureTempPid();
+    temp_active_ = false;
+}
+
+void AutoController::setTuning(const Tuning &t)
+{
+    if (memcmp(&t, &tuning_, sizeof(t)) == 0) return;
+    tuning_ = t;
+
+    configureTempPid();
+    temp_active_ = false;
+    // 外环在下一拍按当前模式重新配置并初始化
+    press_pid_.reset();
+    press_mode_ = PressMode::OFF;
+}
+
+void AutoController::configureTempPid()
+{
+    PidController::Gains g;
+    g.kp      = tuning_.temp_kp;
+    g.ki      = tuning_.temp_ki;
+    g.kd      = tuning_.temp_kd;
+    g.d_tau_s = tuning_.temp_d_tau_s;
+    g.out_min = 0.0f;
+    g.out_max = 100.0f;
+    temp_pid_.configure(g, dtSeconds());
+}
+
+void AutoController::configurePressPid(PressMode mode, float temp_sp_max)
+{
+    PidController::Gains g;
+    if (mode == PressMode::CASCADE) {
+        g.kp      = tuning_.cascade_kp;
+        g.ki      = tuning_.cascade_ki;
+        g.kd      = BoardConfig::PRESS_CASCADE_KD;
+        g.out_min = BoardConfig::CASCADE_TEMP_SP_MIN_C;
+        g.out_max = temp_sp_max;
+    } else {
+        g.kp      = tuning_.press_kp;
+        g.ki      = tuning_.press_ki;
+        g.kd      = tuning_.press_kd;
+        g.out_min = 0.0f;
+        g.out_max = 100.0f;
+    }
+    g.d_tau_s = BoardConfig::PRESS_PID_D_TAU_S;
+    press_pid_.configure(g, dtSeconds());
+}
+
+float AutoController::controlTemp(const Proto::Telemetry &telem)
+{
+    if (BoardConfig::TEMP_CTRL_CHANNEL >= telem.temp_count) return NAN;
+    return telem.temp_c[BoardConfig::TEMP_CTRL_CHANNEL];
+}
+
+float AutoController::ambientTemp(const Proto::Telemetry &telem)
+{
+    return isfinite(telem.env_temp_c) ? telem.env_temp_c : BoardConfig::AMBIENT_TEMP_DEFAULT_C;
+}
+
+float AutoController::heaterFeedForward(float temp_sp, float ambient_c, float valve_pct, bool temp_loop)
+{
+    float ff = BoardConfig::PRESS_FF_PCT_PER_VALVE_PCT * valve_pct;
+    if (temp_loop) {
+        const float dT = temp_sp - ambient_c;
+        if (dT > 0.0f) ff += BoardConfig::TEMP_FF_PCT_PER_C * dT;
+    }
+    return ff;
+}
+
+void AutoController::onEnter(const ControlState &state, const Proto::Telemetry &telem, const Proto::Outputs &last_out)
+{
+    // 各环在 compute() 首拍按“未激活 -> 激活”初始化；这里只需让内环/单压力环从切换前的加热输出起步
+    temp_active_ = false;
+    press_mode_ = PressMode::OFF;
+    temp_sp_eff_ = NAN;
+    mpc_active_ = false;
+
+    const float y_t = controlTemp(telem);
+    const float y_p = telem.pressure_pa;
+    const Proto::Setpoints &sp = state.setpoints;
+    const float valve = sp.enable_valve_ctrl ? sp.target_valve_opening_pct : 0.0f;
+    const float t_amb = ambientTemp(telem);
+
+    const bool temp_on  = sp.enable_temp_ctrl && isfinite(y_t) && isfinite(sp.target_temp_c);
+    const bool press_on = sp.enable_pressure_ctrl && isfinite(y_p) && isfinite(sp.target_pressure_pa);
+
+    // MPC 在 compute() 首拍以实测输出为起点，无需在此初始化
+    if (algo_ == Algorithm::MPC && temp_on && press_on) return;
+
+    if (temp_on && press_on) {
+        // 串级：外环从当前温度起步，内环从当前加热功率起步
+        configurePressPid(PressMode::CASCADE, sp.target_temp_c);
+        press_pid_.bumplessInit(sp.target_pressure_pa, y_p, y_t);
+        press_mode_ = PressMode::CASCADE;
+        temp_sp_eff_ = y_t;
+    } else if (press_on) {
+        configurePressPid(PressMode::DIRECT, 100.0f);
+        press_pid_.bumplessInit(sp.target_pressure_pa, y_p, last_out.heater_power_pct,
+                                heaterFeedForward(0.0f, t_amb, valve, false));
+        press_mode_ = PressMode::DIRECT;
+    }
+
+    if (temp_on) {
+        const float t_sp = (press_mode_ == PressMode::CASCADE) ? temp_sp_eff_ : sp.target_temp_c;
+        temp_pid_.bumplessInit(t_sp, y_t, last_out.heater_power_pct,
+                               heaterFeedForward(t_sp, t_amb, valve, true));
+        temp_active_ = true;
+    }
+}
+
+void AutoController::compute(const ControlState &state, const Proto::Telemetry &telem, Proto::Outputs &out)
 {
-    // 占位：自动控制未实现。
     out.heater_power_pct = 0.0f;
     out.valve_opening_pct = 0.0f;
     out.pump_target_temp_c = 0.0f;
+
+    const Proto::Setpoints &sp = state.setpoints;
+
+    // 阀门：开环设定
+    if (sp.enable_valve_ctrl && isfinite(sp.target_valve_opening_pct)) {
+        out.valve_opening_pct = sp.target_valve_opening_pct;
+    }
+
+    const float y_t = controlTemp(telem);
+    const float y_p = telem.pressure_pa;
+    const float t_amb = ambientTemp(telem);
+
+    const bool temp_on  = sp.enable_temp_ctrl && isfinite(y_t) && isfinite(sp.target_temp_c);
+    const bool press_on = sp.enable_pressure_ctrl && isfinite(y_p) && isfinite(sp.target_pressure_pa);
+
+    // ---- MPC：同时决定加热与阀门 ----
+    if (algo_ == Algorithm::MPC && temp_on && press_on) {
+        if (temp_active_ || press_mode_ != PressMode::OFF) {
+            temp_pid_.reset();
+            press_pid_.reset();
+            temp_active_ = false;
+            press_mode_ = PressMode::OFF;
+        }
+        computeMpc(sp, telem, y_t, t_amb, out);
+        return;
+    }
+    mpc_active_ = false;
+
+    // ---- 外环：压力 ----
+    PressMode want = PressMode::OFF;
+    if (press_on) want = temp_on ? PressMode::CASCADE : PressMode::DIRECT;
+
+    if (want != press_mode_) {
+        if (want == PressMode::CASCADE) {
+            configurePressPid(PressMode::CASCADE, sp.target_temp_c);
+            press_pid_.bumplessInit(sp.target_pressure_pa, y_p, y_t);
+        } else if (want == PressMode::DIRECT) {
+            configurePressPid(PressMode::DIRECT, 100.0f);
+            press_pid_.bumplessInit(sp.target_pressure_pa, y_p, telem.heater_power_pct,
+                                    heaterFeedForward(0.0f, t_amb, out.valve_opening_pct, false));
+        } else {
+            press_pid_.reset();
+        }
+        press_mode_ = want;
+    }
+
+    temp_sp_eff_ = NAN;
+
+    if (press_mode_ == PressMode::CASCADE) {
+        // 温度上限随 target_temp_c 变化
+        press_pid_.setOutputLimits(BoardConfig::CASCADE_TEMP_SP_MIN_C, sp.target_temp_c);
+
+        // 内环执行器饱和（以实测输出判断）且外环仍要求同方向加大：冻结外环积分
+        const float e_p = sp.target_pressure_pa - y_p;
+        const bool inner_sat = (e_p > 0.0f && telem.heater_power_pct >= 99.9f) ||
+                               (e_p < 0.0f && telem.heater_power_pct <= 0.1f);
+        temp_sp_eff_ = press_pid_.update(sp.target_pressure_pa, y_p, 0.0f, inner_sat);
+    } else if (press_mode_ == PressMode::DIRECT) {
+        const float ff = heaterFeedForward(0.0f, t_amb, out.valve_opening_pct, false);
+        out.heater_power_pct = press_pid_.update(sp.target_pressure_pa, y_p, ff);
+    }
+
+    // ---- 内环：温度 ----
+    // 温度环未启用或测量/设定无效：温度环不输出，下次启用时从当前输出重新开始
+    if (!temp_on) {
+        if (temp_active_) {
+            temp_pid_.reset();
+            temp_active_ = false;
+        }
+        return;
+    }
+
+    if (press_mode_ != PressMode::CASCADE) {
+        temp_sp_eff_ = sp.target_temp_c;
+    }
+
+    const float ff = heaterFeedForward(temp_sp_eff_, t_amb, out.valve_opening_pct, true);
+    if (!temp_active_) {
+        temp_pid_.bumplessInit(temp_sp_eff_, y_t, telem.heater_power_pct, ff);
+        temp_active_ = true;
+    }
+
+    out.heater_power_pct = temp_pid_.update(temp_sp_eff_, y_t, ff);
+}
+
+void AutoController::computeMpc(const Proto::Setpoints &sp, const Proto::Telemetry &telem,
+                                float y_t, float t_amb, Proto::Outputs &out)
+{
+    const float u_applied[2] = {telem.heater_power_pct, telem.valve_opening_pct};
+    if (!mpc_active_) {
+        mpc_.reset(u_applied);
+        mpc_u_[0] = u_applied[0];
+        mpc_u_[1] = u_applied[1];
+        mpc_div_ = 0;
+        mpc_active_ = true;
+    }
+
+    if (mpc_div_ == 0) {
+        const float mpc_dt = dtSeconds() * BoardConfig::MPC_PERIOD_TICKS;
+        const float x[2] = {y_t, telem.pressure_pa * 1e-3f};
+        const float r[2] = {sp.target_temp_c, sp.target_pressure_pa * 1e-3f};
+        float c[2];
+        MpcModel::affineFromBoardConfig(mpc_dt, t_amb, c);
+        const float valve_rest = (sp.enable_valve_ctrl && isfinite(sp.target_valve_opening_pct))
+                                     ? sp.target_valve_opening_pct
+                                     : 0.0f;
+        mpc_.solve(x, u_applied, c, r, valve_rest, mpc_u_);
+        mpc_div_ = BoardConfig::MPC_PERIOD_TICKS;
+    }
+    --mpc_div_;
+
+    temp_sp_eff_ = sp.target_temp_c;
+    out.heater_power_pct = mpc_u_[0];
+    out.valve_opening_pct = mpc_u_[1];
 }
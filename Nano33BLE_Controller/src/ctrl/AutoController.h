@@ -2,16 +2,91 @@
 #pragma once
 
 #include "ControlState.h"
+#include "MpcController.h"
+#include "PidController.h"
 #include "../proto/Messages.h"
+#include "../util/BoardConfig.h"
 
-// 自动控制器（占位版本）：
-// 按总体架构保留模块，但当前阶段不实现自动控制算法。
+// 自动控制器（各环由 setpoints.enable_* 单独启用）：
+// - 温度环（内环）：target_temp_c -> PID + 前馈 -> heater_power_pct
+//   测量取 BoardConfig::TEMP_CTRL_CHANNEL 通道
+// - 压力环（外环）：target_pressure_pa
+//     * 与温度环同时启用：串级，压力 PID 输出内环温度设定，范围 [CASCADE_TEMP_SP_MIN_C, target_temp_c]
+//       （target_temp_c 作为温度上限）；内环加热饱和时冻结外环积分
+//     * 单独启用：压力 PID 直接输出 heater_power_pct
+// - 阀门：enable_valve_ctrl 时按 target_valve_opening_pct 开环输出
+// - 加热前馈：环境散热补偿 (T_sp - T_amb) + 阀门排气带走热量补偿（与阀门开度成正比）
+// - 算法 MPC 且温度、压力同时启用时：由 MpcController 同时决定加热与阀门（替代串级 PID），
+//   每 MPC_PERIOD_TICKS 拍求解一次，其间保持输出；其余组合仍走 PID
+// - 每个控制节拍调用一次 compute()（采样周期 = BoardConfig::CONTROL_PERIOD_US）
 
 class AutoController {
 public:
-    void begin() {}
+    enum class Algorithm : uint8_t { PID = 0, MPC = 1 };
+
+    // PID 整定参数（缺省取 BoardConfig，运行中由 ConfigStore 整组下发）
+    struct Tuning {
+        float temp_kp;
+        float temp_ki;
+        float temp_kd;
+        float temp_d_tau_s;
+        float cascade_kp;
+        float cascade_ki;
+        float press_kp;
+        float press_ki;
+        float press_kd;
+    };
+
+    void begin();
+
+    // 切换算法；下一拍按“未激活 -> 激活”从当前输出无扰起步
+    void setAlgorithm(Algorithm a);
+    Algorithm algorithm() const { return algo_; }
+
+    // 进入 AUTO 时调用：以切换前的输出初始化控制器（MANUAL -> AUTO 无扰切换）
+    void onEnter(const ControlState &state, const Proto::Telemetry &telem, const Proto::Outputs &last_out);
 
     // 输入 telemetry + setpoints，输出 outputs
-    // 当前返回 SAFE 等价输出：heater=0, valve=0。
     void compute(const ControlState &state, const Proto::Telemetry &telem, Proto::Outputs &out);
+
+    // 更新温度环 PID 参数（例如自整定结果），积分状态随之复位
+    void setTempGains(float kp, float ki, float kd);
+
+    // 整组更新各环参数：与当前相同时不动作；否则下一拍各 PID 环按“未激活 -> 激活”从当前输出重新起步，
+    // 新参数在同一拍全部生效
+    void setTuning(const Tuning &t);
+    const Tuning &tuning() const { return tuning_; }
+
+    // 当前生效的内环温度设定（串级时为外环输出），未启用温度环时为 NAN
+    float effectiveTempSetpoint() const { return temp_sp_eff_; }
+
+    // 内部状态观测（DAQ）
+    const PidController &tempPid() const { return temp_pid_; }
+    const PidController &pressPid() const { return press_pid_; }
+
+private:
+    enum class PressMode : uint8_t { OFF, CASCADE, DIRECT };
+
+    PidController temp_pid_;     // 内环：温度 -> 加热功率
+    PidController press_pid_;    // 外环：压力 -> 温度设定（串级）或加热功率（单环）
+    Tuning        tuning_;
+
+    bool      temp_active_ = false;   // 上一拍温度环是否在工作（用于重新启用时初始化）
+    PressMode press_mode_ = PressMode::OFF;
+    float     temp_sp_eff_ = NAN;
+
+    Algorithm algo_ = Algorithm::PID;
+    MpcController<BoardConfig::MPC_HORIZON> mpc_;
+    bool      mpc_active_ = false;
+    uint16_t  mpc_div_ = 0;           // 距下一次求解的节拍数
+    float     mpc_u_[2] = {0.0f, 0.0f};
+
+    void configureTempPid();
+    void configurePressPid(PressMode mode, float temp_sp_max);
+    void computeMpc(const Proto::Setpoints &sp, const Proto::Telemetry &telem,
+                    float y_t, float t_amb, Proto::Outputs &out);
+
+    static float controlTemp(const Proto::Telemetry &telem);
+    static float ambientTemp(const Proto::Telemetry &telem);
+    static float heaterFeedForward(float temp_sp, float ambient_c, float valve_pct, bool temp_loop);
 };
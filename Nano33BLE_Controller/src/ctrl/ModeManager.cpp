@@ -1,21 +1,79 @@
 // ctrl/ModeManager.cpp
 #include "ModeManager.h"
 
+#include "../util/BoardConfig.h"
+
 void ModeManager::begin()
 {
     auto_ctrl_.begin();
+    prev_mode_ = ControlMode::SAFE;
+    prev_out_ = Proto::Outputs{};
+}
+
+bool ModeManager::takeAutotuneResult(RelayAutotuner::Result &res)
+{
+    if (!tune_result_pending_) return false;
+    tune_result_pending_ = false;
+    res = tuner_.result();
+    return true;
 }
 
-void ModeManager::compute(const ControlState &state,
+void ModeManager::startAutotune(const ControlState &state, const Proto::Telemetry &telem)
+{
+    RelayAutotuner::Config cfg;
+    cfg.setpoint_c = state.setpoints.target_temp_c;
+    cfg.bias_pct   = BoardConfig::TUNE_RELAY_BIAS_PCT;
+    cfg.amp_pct    = BoardConfig::TUNE_RELAY_AMP_PCT;
+    cfg.hyst_c     = BoardConfig::TUNE_HYST_C;
+    cfg.max_temp_c = max_temp_c_ - BoardConfig::TUNE_TEMP_MARGIN_C;
+    cfg.cycles     = BoardConfig::TUNE_CYCLES;
+    cfg.timeout_ms = BoardConfig::TUNE_TIMEOUT_MS;
+    tuner_.start(cfg, telem.timestamp_ms);
+}
+
+void ModeManager::runAutotune(ControlState &state, const Proto::Telemetry &telem, Proto::Outputs &out)
+{
+    const float y = (BoardConfig::TEMP_CTRL_CHANNEL < telem.temp_count)
+                        ? telem.temp_c[BoardConfig::TEMP_CTRL_CHANNEL]
+                        : NAN;
+    out.heater_power_pct = tuner_.update(y, telem.timestamp_ms);
+    if (tuner_.running()) return;
+
+    tune_result_pending_ = true;
+    const RelayAutotuner::Result &r = tuner_.result();
+    // 增益未通过校验：整组不采用，原增益不变，转 SAFE
+    if (r.status == RelayAutotuner::Status::DONE && gain_check_ &&
+        !gain_check_(gain_check_ctx_, r.kp, r.ki, r.kd)) {
+        tuner_.reject();
+    }
+    if (r.status == RelayAutotuner::Status::DONE) {
+        // 整定完成：应用新参数并转入 AUTO（下一拍以当前输出无扰切换）
+        auto_ctrl_.setTempGains(r.kp, r.ki, r.kd);
+        state.mode = ControlMode::AUTO;
+    } else {
+        state.mode = ControlMode::SAFE;
+        out.heater_power_pct = 0.0f;
+    }
+}
+
+void ModeManager::compute(ControlState &state,
                           const Proto::Telemetry &telem,
                           Proto::Outputs &out)
 {
+    const ControlMode mode = state.mode;
+
+    // 整定过程中被切出 AUTOTUNE（操作员切模式或 SafetyManager 强制 SAFE）：中止并上报
+    if (mode != ControlMode::AUTOTUNE && tuner_.running()) {
+        tuner_.abort(RelayAutotuner::Status::ABORT_EXTERNAL);
+        tune_result_pending_ = true;
+    }
+
     // 默认 SAFE
     out.heater_power_pct = 0.0f;
     out.valve_opening_pct = 0.0f;
     out.pump_target_temp_c = 0.0f;
 
-    switch (state.mode) {
+    switch (mode) {
     case ControlMode::SAFE:
         // already zeros
         break;
@@ -34,11 +92,23 @@ void ModeManager::compute(const ControlState &state,
         break;
 
     case ControlMode::AUTO:
-        // 自动控制占位：保留文件/接口，不实现算法
+        if (prev_mode_ != ControlMode::AUTO) {
+            auto_ctrl_.onEnter(state, telem, prev_out_);
+        }
         auto_ctrl_.compute(state, telem, out);
         break;
 
+    case ControlMode::AUTOTUNE:
+        if (prev_mode_ != ControlMode::AUTOTUNE) {
+            startAutotune(state, telem);
+        }
+        runAutotune(state, telem, out);
+        break;
+
     default:
         break;
     }
+
+    prev_mode_ = mode;
+    prev_out_ = out;
 }
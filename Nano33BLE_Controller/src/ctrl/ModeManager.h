@@ -5,17 +5,56 @@
 
 #include "ControlState.h"
 #include "AutoController.h"
+#include "RelayAutotuner.h"
 #include "../proto/Messages.h"
+#include "../util/BoardConfig.h"
 
 class ModeManager {
 public:
+    // 整定增益校验：返回 false 则整组不采用
+    using GainCheckFn = bool (*)(void *ctx, float kp, float ki, float kd);
+
     void begin();
 
     // 根据当前控制状态和遥测，计算输出
-    void compute(const ControlState &state,
+    // AUTOTUNE 结束时会改写 state.mode（完成且增益通过校验 -> AUTO，中止或被拒绝 -> SAFE）
+    void compute(ControlState &state,
                  const Proto::Telemetry &telem,
                  Proto::Outputs &out);
 
+    // 自整定结束（完成/中止）后取走一次结果用于上报；无新结果返回 false
+    bool takeAutotuneResult(RelayAutotuner::Result &res);
+
+    // AUTO 模式算法选择（默认 BoardConfig::AUTO_USE_MPC）
+    void setAutoAlgorithm(AutoController::Algorithm a) { auto_ctrl_.setAlgorithm(a); }
+
+    const AutoController &autoController() const { return auto_ctrl_; }
+
+    // 过温阈值（自整定上限 = 阈值 - TUNE_TEMP_MARGIN_C），与 SafetyManager 保持一致
+    void setMaxTempC(float max_temp_c) { max_temp_c_ = max_temp_c; }
+
+    // PID 整定参数（ConfigStore 整组下发）
+    void setTuning(const AutoController::Tuning &t) { auto_ctrl_.setTuning(t); }
+
+    // 自整定完成时先以此校验三个增益，再决定是否采用并转入 AUTO；未设置时不校验
+    void setGainCheck(GainCheckFn fn, void *ctx)
+    {
+        gain_check_ = fn;
+        gain_check_ctx_ = ctx;
+    }
+
 private:
     AutoController auto_ctrl_;
+    RelayAutotuner tuner_;
+    bool tune_result_pending_ = false;
+    float max_temp_c_ = BoardConfig::SAFETY_MAX_TEMP_C;
+    GainCheckFn gain_check_ = nullptr;
+    void *gain_check_ctx_ = nullptr;
+
+    void startAutotune(const ControlState &state, const Proto::Telemetry &telem);
+    void runAutotune(ControlState &state, const Proto::Telemetry &telem, Proto::Outputs &out);
+
+    // 上一拍的模式与输出：用于检测模式切换并实现 MANUAL -> AUTO 无扰切换
+    ControlMode   prev_mode_ = ControlMode::SAFE;
+    Proto::Outputs prev_out_;
 };
@@ -0,0 +1,44 @@
+// ctrl/MpcController.cpp
+#include "MpcController.h"
+
+#include "../util/BoardConfig.h"
+
+// 连续模型：
+//   dT/dt = k_h·u_h - k_loss·(T - T_amb) - k_vc·u_v
+//   dP/dt = (P_ref + dPdT·(T - T_ref) - P)/tau_p - k_vp·u_v
+MpcModel MpcModel::fromBoardConfig(float dt_s)
+{
+    MpcModel m;
+    const float k_loss = BoardConfig::MPC_MODEL_LOSS_PER_S;
+    const float tau_p  = BoardConfig::MPC_MODEL_P_TAU_S;
+
+    m.a[0][0] = 1.0f - dt_s * k_loss;
+    m.a[0][1] = 0.0f;
+    m.a[1][0] = dt_s * BoardConfig::MPC_MODEL_DPDT_KPA_PER_C / tau_p;
+    m.a[1][1] = 1.0f - dt_s / tau_p;
+
+    m.b[0][0] = dt_s * BoardConfig::MPC_MODEL_HEAT_C_PER_S_PCT;
+    m.b[0][1] = -dt_s * BoardConfig::MPC_MODEL_VENT_C_PER_S_PCT;
+    m.b[1][0] = 0.0f;
+    m.b[1][1] = -dt_s * BoardConfig::MPC_MODEL_VENT_KPA_PER_S_PCT;
+    return m;
+}
+
+void MpcModel::affineFromBoardConfig(float dt_s, float t_amb_c, float c[2])
+{
+    const float tau_p = BoardConfig::MPC_MODEL_P_TAU_S;
+    c[0] = dt_s * BoardConfig::MPC_MODEL_LOSS_PER_S * t_amb_c;
+    c[1] = dt_s / tau_p * (BoardConfig::MPC_MODEL_P_REF_KPA -
+                           BoardConfig::MPC_MODEL_DPDT_KPA_PER_C * BoardConfig::MPC_MODEL_T_REF_C);
+}
+
+MpcWeights MpcWeights::fromBoardConfig()
+{
+    MpcWeights w;
+    w.q[0]    = BoardConfig::MPC_Q_TEMP;
+    w.q[1]    = BoardConfig::MPC_Q_PRESS;
+    w.r_du[0] = BoardConfig::MPC_R_DHEATER;
+    w.r_du[1] = BoardConfig::MPC_R_DVALVE;
+    w.r_rest_valve = BoardConfig::MPC_R_VALVE_REST;
+    return w;
+}
@@ -0,0 +1,264 @@
+// ctrl/MpcController.h
+#pragma once
+
+#include <Arduino.h>
+#include <math.h>
+
+// 加热/阀门双输入线性 MPC（固定时域、凝聚 QP）：
+// - 模型（采样周期 dt）：状态 x = [T(°C), P(kPa)]，输入 u = [heater %, valve %]
+//     x+ = A·x + B·u + c + d
+//   c 为仿射项（环境温度、压力基准，在线给出），d 为在线估计的常值扰动（无静差）
+// - 代价：Σ_{i=1..N} (x_i - r)'Q(x_i - r) + Σ_{i=0..N-1} Δu_i'·R·Δu_i + r_rest·(u_v,i - u_v,rest)²
+// - 约束：0 <= u <= 100
+// - 凝聚后的 Hessian、预测矩阵在 configure() 中一次算好；在线只计算梯度常数项并做
+//   固定次数的加速投影梯度迭代（FISTA），全部静态内存，求解耗时与数据无关
+// - 模板参数 N 为预测时域：存储约 2·(2N)² 个 float，每次迭代约 (2N)² 次乘加
+
+struct MpcModel {
+    float a[2][2] = {{1.0f, 0.0f}, {0.0f, 1.0f}};
+    float b[2][2] = {{0.0f, 0.0f}, {0.0f, 0.0f}};
+
+    // 由 BoardConfig::MPC_MODEL_* 构造（前向欧拉离散，阀门排气在 MPC_MODEL_P_NOM_KPA 处线性化）
+    static MpcModel fromBoardConfig(float dt_s);
+
+    // 仿射项 c：环境温度 t_amb_c 下的散热、压力平衡基准
+    static void affineFromBoardConfig(float dt_s, float t_amb_c, float c[2]);
+};
+
+struct MpcWeights {
+    float q[2]    = {1.0f, 1.0f};      // 跟踪权重：1/°C²、1/kPa²
+    float r_du[2] = {1e-4f, 1e-4f};    // 输入增量权重：1/%²
+    float r_rest_valve = 0.0f;         // 阀门偏离静息开度的权重
+
+    static MpcWeights fromBoardConfig();
+};
+
+template <uint8_t N>
+class MpcController {
+public:
+    static constexpr uint8_t  NX = 2;
+    static constexpr uint8_t  NU = 2;
+    static constexpr uint16_t NV = NU * N;    // 决策变量数
+    static constexpr uint16_t NY = NX * N;    // 预测输出数
+    static constexpr uint8_t  MAX_ITERS = 64;
+
+    static_assert(N >= 1, "horizon must be >= 1");
+
+    void configure(const MpcModel &m, const MpcWeights &w, uint8_t iters, float dist_alpha)
+    {
+        m_ = m;
+        w_ = w;
+        iters_ = (iters > MAX_ITERS) ? MAX_ITERS : iters;
+        alpha_ = dist_alpha;
+
+        // Φ = [A; A²; ...]，Ψ = [I; I+A; ...]（仿射项与扰动的累计系数）
+        float ap[NX][NX] = {{1.0f, 0.0f}, {0.0f, 1.0f}};   // A^i
+        float sp[NX][NX] = {{0.0f, 0.0f}, {0.0f, 0.0f}};   // Σ_{j<i} A^j
+        for (uint8_t i = 0; i < N; ++i) {
+            add2(sp, ap);
+            mul2(ap, m_.a);
+            for (uint8_t r = 0; r < NX; ++r) {
+                for (uint8_t c = 0; c < NX; ++c) {
+                    phi_[i * NX + r][c] = ap[r][c];
+                    psi_[i * NX + r][c] = sp[r][c];
+                }
+            }
+        }
+
+        // Γ：x_i 对 u_k 的系数 A^{i-1-k}·B（k < i），以转置形式存入 g_[v][y]
+        for (uint16_t v = 0; v < NV; ++v) {
+            for (uint16_t y = 0; y < NY; ++y) g_[v][y] = 0.0f;
+        }
+        float akb[NX][NU];
+        for (uint8_t r = 0; r < NX; ++r) {
+            for (uint8_t c = 0; c < NU; ++c) akb[r][c] = m_.b[r][c];
+        }
+        for (uint8_t lag = 0; lag < N; ++lag) {          // lag = i-1-k
+            for (uint8_t k = 0; k + lag < N; ++k) {
+                const uint8_t i = k + lag;                // 行块：x_{i+1}
+                for (uint8_t r = 0; r < NX; ++r) {
+                    for (uint8_t c = 0; c < NU; ++c) g_[k * NU + c][i * NX + r] = akb[r][c];
+                }
+            }
+            float next[NX][NU];
+            for (uint8_t r = 0; r < NX; ++r) {
+                for (uint8_t c = 0; c < NU; ++c) {
+                    next[r][c] = m_.a[r][0] * akb[0][c] + m_.a[r][1] * akb[1][c];
+                }
+            }
+            for (uint8_t r = 0; r < NX; ++r) {
+                for (uint8_t c = 0; c < NU; ++c) akb[r][c] = next[r][c];
+            }
+        }
+
+        // H = Γ'QΓ + D（D：输入增量的三对角项 + 阀门静息项）
+        for (uint16_t i = 0; i < NV; ++i) {
+            for (uint16_t j = i; j < NV; ++j) {
+                float s = 0.0f;
+                for (uint16_t y = 0; y < NY; ++y) s += g_[i][y] * w_.q[y % NX] * g_[j][y];
+                h_[i][j] = s;
+                h_[j][i] = s;
+            }
+        }
+        for (uint8_t k = 0; k < N; ++k) {
+            for (uint8_t c = 0; c < NU; ++c) {
+                const uint16_t v = k * NU + c;
+                h_[v][v] += (k + 1 < N) ? 2.0f * w_.r_du[c] : w_.r_du[c];
+                if (k + 1 < N) {
+                    h_[v][v + NU] -= w_.r_du[c];
+                    h_[v + NU][v] -= w_.r_du[c];
+                }
+            }
+            h_[k * NU + 1][k * NU + 1] += w_.r_rest_valve;
+        }
+
+        // 梯度常数项只需 Γ'Q
+        for (uint16_t v = 0; v < NV; ++v) {
+            for (uint16_t y = 0; y < NY; ++y) g_[v][y] *= w_.q[y % NX];
+        }
+
+        // 步长 1/L，L = λmax(H)（幂迭代，放大 5% 余量）
+        float vec[NV];
+        for (uint16_t v = 0; v < NV; ++v) vec[v] = 1.0f;
+        float lambda = 0.0f;
+        for (uint8_t it = 0; it < 50; ++it) {
+            float tmp[NV];
+            float norm = 0.0f;
+            for (uint16_t i = 0; i < NV; ++i) {
+                float s = 0.0f;
+                for (uint16_t j = 0; j < NV; ++j) s += h_[i][j] * vec[j];
+                tmp[i] = s;
+                norm += s * s;
+            }
+            norm = sqrtf(norm);
+            if (norm <= 0.0f) break;
+            for (uint16_t i = 0; i < NV; ++i) vec[i] = tmp[i] / norm;
+            lambda = norm;
+        }
+        step_ = (lambda > 0.0f) ? 1.0f / (1.05f * lambda) : 0.0f;
+
+        // FISTA 动量系数与数据无关，预先算好
+        float t = 1.0f;
+        for (uint8_t it = 0; it < iters_; ++it) {
+            const float tn = 0.5f * (1.0f + sqrtf(1.0f + 4.0f * t * t));
+            beta_[it] = (t - 1.0f) / tn;
+            t = tn;
+        }
+
+        const float zero[NU] = {0.0f, 0.0f};
+        reset(zero);
+    }
+
+    // 以当前（切换前）输入为起点：预测序列全部取 u_now，扰动估计清零
+    void reset(const float u_now[NU])
+    {
+        for (uint8_t k = 0; k < N; ++k) {
+            for (uint8_t c = 0; c < NU; ++c) u_[k * NU + c] = u_now[c];
+        }
+        d_[0] = d_[1] = 0.0f;
+        have_prev_ = false;
+    }
+
+    // x：当前测量状态；u_applied：上一周期实际施加的输入（用于扰动估计与增量代价）
+    // c：仿射项；r：参考；valve_rest：阀门静息开度；输出 u_out = u_0
+    void solve(const float x[NX], const float u_applied[NU], const float c[NX],
+               const float r[NX], float valve_rest, float u_out[NU])
+    {
+        // 无静差：d ← (1-α)d + α·(x - (A·x_prev + B·u_prev + c))
+        if (have_prev_) {
+            for (uint8_t i = 0; i < NX; ++i) {
+                const float pred = m_.a[i][0] * x_prev_[0] + m_.a[i][1] * x_prev_[1] +
+                                   m_.b[i][0] * u_prev_[0] + m_.b[i][1] * u_prev_[1] + c[i];
+                d_[i] += alpha_ * ((x[i] - pred) - d_[i]);
+            }
+        }
+        x_prev_[0] = x[0];
+        x_prev_[1] = x[1];
+        u_prev_[0] = u_applied[0];
+        u_prev_[1] = u_applied[1];
+        have_prev_ = true;
+
+        // 自由响应偏差 e = Φx + Ψ(c + d) - r
+        const float w0 = c[0] + d_[0];
+        const float w1 = c[1] + d_[1];
+        float e[NY];
+        for (uint16_t y = 0; y < NY; ++y) {
+            e[y] = phi_[y][0] * x[0] + phi_[y][1] * x[1] + psi_[y][0] * w0 + psi_[y][1] * w1 - r[y % NX];
+        }
+
+        // f = Γ'Q·e + 线性项（Δu_0 锚定到已施加输入、阀门静息）
+        float f[NV];
+        for (uint16_t v = 0; v < NV; ++v) {
+            float s = 0.0f;
+            for (uint16_t y = 0; y < NY; ++y) s += g_[v][y] * e[y];
+            f[v] = s;
+        }
+        f[0] -= w_.r_du[0] * u_applied[0];
+        f[1] -= w_.r_du[1] * u_applied[1];
+        for (uint8_t k = 0; k < N; ++k) f[k * NU + 1] -= w_.r_rest_valve * valve_rest;
+
+        // 热启动：上一解左移一步
+        for (uint16_t v = 0; v + NU < NV; ++v) u_[v] = u_[v + NU];
+
+        // FISTA：固定迭代次数
+        float z[NV];
+        for (uint16_t v = 0; v < NV; ++v) z[v] = u_[v];
+        for (uint8_t it = 0; it < iters_; ++it) {
+            for (uint16_t i = 0; i < NV; ++i) {
+                float gsum = f[i];
+                for (uint16_t j = 0; j < NV; ++j) gsum += h_[i][j] * z[j];
+                float un = z[i] - step_ * gsum;
+                if (un < 0.0f) un = 0.0f;
+                if (un > 100.0f) un = 100.0f;
+                tmp_[i] = un;
+            }
+            for (uint16_t i = 0; i < NV; ++i) {
+                z[i] = tmp_[i] + beta_[it] * (tmp_[i] - u_[i]);
+                u_[i] = tmp_[i];
+            }
+        }
+
+        u_out[0] = u_[0];
+        u_out[1] = u_[1];
+    }
+
+    float disturbance(uint8_t i) const { return (i < NX) ? d_[i] : 0.0f; }
+
+private:
+    MpcModel   m_;
+    MpcWeights w_;
+    uint8_t    iters_ = 0;
+    float      alpha_ = 0.0f;
+    float      step_ = 0.0f;
+    float      beta_[MAX_ITERS] = {0};
+
+    float phi_[NY][NX];
+    float psi_[NY][NX];
+    float g_[NV][NY];      // Γ'Q
+    float h_[NV][NV];
+
+    float u_[NV];
+    float tmp_[NV];
+    float d_[NX] = {0.0f, 0.0f};
+    float x_prev_[NX] = {0.0f, 0.0f};
+    float u_prev_[NU] = {0.0f, 0.0f};
+    bool  have_prev_ = false;
+
+    static void add2(float acc[NX][NX], const float m[NX][NX])
+    {
+        for (uint8_t r = 0; r < NX; ++r) {
+            for (uint8_t c = 0; c < NX; ++c) acc[r][c] += m[r][c];
+        }
+    }
+
+    static void mul2(float acc[NX][NX], const float m[NX][NX])
+    {
+        float out[NX][NX];
+        for (uint8_t r = 0; r < NX; ++r) {
+            for (uint8_t c = 0; c < NX; ++c) out[r][c] = acc[r][0] * m[0][c] + acc[r][1] * m[1][c];
+        }
+        for (uint8_t r = 0; r < NX; ++r) {
+            for (uint8_t c = 0; c < NX; ++c) acc[r][c] = out[r][c];
+        }
+    }
+};
@@ -0,0 +1,76 @@
+// ctrl/PidController.cpp
+#include "PidController.h"
+
+#include <math.h>
+
+void PidController::configure(const Gains &g, float dt_s)
+{
+    g_ = g;
+    dt_s_ = (dt_s > 0.0f) ? dt_s : 0.01f;
+    d_alpha_ = (g_.d_tau_s > 0.0f) ? (g_.d_tau_s / (g_.d_tau_s + dt_s_)) : 0.0f;
+    reset();
+}
+
+void PidController::reset()
+{
+    integ_ = 0.0f;
+    d_term_ = 0.0f;
+    prev_meas_ = 0.0f;
+    initialized_ = false;
+}
+
+float PidController::clampOut(float u) const
+{
+    if (u < g_.out_min) return g_.out_min;
+    if (u > g_.out_max) return g_.out_max;
+    return u;
+}
+
+void PidController::setOutputLimits(float out_min, float out_max)
+{
+    if (out_max < out_min) out_max = out_min;
+    g_.out_min = out_min;
+    g_.out_max = out_max;
+}
+
+void PidController::bumplessInit(float setpoint, float measurement, float current_output, float ff)
+{
+    if (!isfinite(setpoint) || !isfinite(measurement) || !isfinite(current_output) || !isfinite(ff)) {
+        reset();
+        return;
+    }
+    // 首拍微分为 0，故 u = ff + P + I  =>  I = u - ff - P
+    const float p = g_.kp * (setpoint - measurement);
+    integ_ = clampOut(current_output) - ff - p;
+    d_term_ = 0.0f;
+    prev_meas_ = measurement;
+    initialized_ = true;
+}
+
+float PidController::update(float setpoint, float measurement, float ff, bool freeze_integral)
+{
+    if (!initialized_) {
+        prev_meas_ = measurement;
+        d_term_ = 0.0f;
+        initialized_ = true;
+    }
+
+    const float err = setpoint - measurement;
+    const float p = g_.kp * err;
+
+    // 微分作用于测量值：-Kd * dy/dt，一阶低通
+    const float d_raw = -g_.kd * (measurement - prev_meas_) / dt_s_;
+    d_term_ = d_alpha_ * d_term_ + (1.0f - d_alpha_) * d_raw;
+    prev_meas_ = measurement;
+
+    // 条件积分：试算积分后的输出，若已饱和且误差继续推向饱和方向，则不累加
+    const float integ_next = integ_ + g_.ki * err * dt_s_;
+    const float u_try = ff + p + integ_next + d_term_;
+    const bool push_high = (u_try > g_.out_max) && (err > 0.0f);
+    const bool push_low  = (u_try < g_.out_min) && (err < 0.0f);
+    if (!freeze_integral && !push_high && !push_low) {
+        integ_ = integ_next;
+    }
+
+    return clampOut(ff + p + integ_ + d_term_);
+}
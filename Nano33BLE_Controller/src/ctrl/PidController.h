@@ -0,0 +1,53 @@
+// ctrl/PidController.h
+#pragma once
+
+#include <Arduino.h>
+
+// 离散 PID（单精度浮点）：
+// - 微分作用于测量值（设定值阶跃不产生微分冲击），并经一阶低通滤波
+// - 条件积分抗饱和：输出饱和且误差继续推向饱和方向时暂停积分
+// - 无扰切换：bumplessInit() 以当前输出反算积分器初值
+// - 前馈：ff 直接叠加到输出，参与饱和判断；串级外环可在内环饱和时冻结积分
+
+class PidController {
+public:
+    struct Gains {
+        float kp = 0.0f;          // 输出单位 / 测量单位
+        float ki = 0.0f;          // 输出单位 / (测量单位·s)
+        float kd = 0.0f;          // 输出单位·s / 测量单位
+        float d_tau_s = 0.0f;     // 微分滤波时间常数（s），0 表示不滤波
+        float out_min = 0.0f;
+        float out_max = 100.0f;
+    };
+
+    void configure(const Gains &g, float dt_s);
+
+    const Gains &gains() const { return g_; }
+
+    // 运行中调整输出限幅（串级外环的设定值范围随设定变化）
+    void setOutputLimits(float out_min, float out_max);
+
+    // 清空内部状态；下一次 update() 视为首次运行
+    void reset();
+
+    // 无扰切换：使下一次 update() 在误差不变时输出等于 current_output
+    void bumplessInit(float setpoint, float measurement, float current_output, float ff = 0.0f);
+
+    // 计算一次输出（每个控制节拍调用一次）
+    // ff：前馈量；freeze_integral：外部要求本拍不积分（例如下游执行器已饱和）
+    float update(float setpoint, float measurement, float ff = 0.0f, bool freeze_integral = false);
+
+    float integral() const { return integ_; }
+
+private:
+    Gains g_;
+    float dt_s_ = 0.01f;
+    float d_alpha_ = 0.0f;      // 微分滤波系数 tau/(tau+dt)
+
+    float integ_ = 0.0f;
+    float d_term_ = 0.0f;
+    float prev_meas_ = 0.0f;
+    bool  initialized_ = false;
+
+    float clampOut(float u) const;
+};
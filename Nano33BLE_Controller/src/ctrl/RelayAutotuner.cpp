@@ -0,0 +1,114 @@
+// ctrl/RelayAutotuner.cpp
+#include "RelayAutotuner.h"
+
+#include <math.h>
+
+void RelayAutotuner::start(const Config &cfg, uint32_t now_ms)
+{
+    cfg_ = cfg;
+    result_ = Result{};
+    result_.status = Status::RUNNING;
+
+    relay_high_ = true;
+    start_ms_ = now_ms;
+    have_rise_ = false;
+    last_rise_ms_ = now_ms;
+    y_max_ = -INFINITY;
+    y_min_ = INFINITY;
+    prev_tu_s_ = 0.0f;
+    prev_a_ = 0.0f;
+    stable_ = 0;
+}
+
+void RelayAutotuner::abort(Status why)
+{
+    if (result_.status == Status::RUNNING) {
+        result_.status = why;
+    }
+}
+
+float RelayAutotuner::update(float temp_c, uint32_t now_ms)
+{
+    if (result_.status != Status::RUNNING) return 0.0f;
+
+    if (!isfinite(temp_c) || !isfinite(cfg_.setpoint_c)) {
+        abort(Status::ABORT_SENSOR);
+        return 0.0f;
+    }
+    if (temp_c > cfg_.max_temp_c) {
+        abort(Status::ABORT_LIMIT);
+        return 0.0f;
+    }
+    if (cfg_.timeout_ms != 0 && (now_ms - start_ms_) > cfg_.timeout_ms) {
+        abort(Status::ABORT_TIMEOUT);
+        return 0.0f;
+    }
+
+    if (temp_c > y_max_) y_max_ = temp_c;
+    if (temp_c < y_min_) y_min_ = temp_c;
+
+    // 带回差继电器
+    if (relay_high_ && temp_c > cfg_.setpoint_c + cfg_.hyst_c) {
+        relay_high_ = false;
+    } else if (!relay_high_ && temp_c < cfg_.setpoint_c - cfg_.hyst_c) {
+        relay_high_ = true;
+
+        // 每次“低 -> 高”切换为一个完整周期的结束
+        if (have_rise_) {
+            const float tu_s = static_cast<float>(now_ms - last_rise_ms_) * 1e-3f;
+            const float a = 0.5f * (y_max_ - y_min_);
+            onCycle(tu_s, a);
+        }
+        have_rise_ = true;
+        last_rise_ms_ = now_ms;
+        y_max_ = temp_c;
+        y_min_ = temp_c;
+    }
+
+    // 本拍整定完成：输出继电平均功率 bias（约为设定点附近的稳态功率），调用方以此无扰切入 AUTO
+    if (result_.status == Status::DONE) return cfg_.bias_pct;
+    if (result_.status != Status::RUNNING) return 0.0f;
+
+    float u = cfg_.bias_pct + (relay_high_ ? cfg_.amp_pct : -cfg_.amp_pct);
+    if (u < 0.0f) u = 0.0f;
+    if (u > 100.0f) u = 100.0f;
+    return u;
+}
+
+void RelayAutotuner::onCycle(float tu_s, float a)
+{
+    ++result_.cycles;
+
+    // 与上一周期相比周期/幅值偏差均 < 10% 视为稳定
+    const bool similar = (prev_tu_s_ > 0.0f) && (prev_a_ > 0.0f) &&
+                         (fabsf(tu_s - prev_tu_s_) < 0.1f * prev_tu_s_) &&
+                         (fabsf(a - prev_a_) < 0.1f * prev_a_);
+    stable_ = similar ? static_cast<uint8_t>(stable_ + 1) : 0;
+    prev_tu_s_ = tu_s;
+    prev_a_ = a;
+
+    if (stable_ + 1 >= cfg_.cycles) {
+        finish(tu_s, a);
+    }
+}
+
+void RelayAutotuner::finish(float tu_s, float a)
+{
+    const float a2 = a * a - cfg_.hyst_c * cfg_.hyst_c;
+    if (a2 <= 0.0f || tu_s <= 0.0f) {
+        result_.status = Status::ABORT_SENSOR;
+        return;
+    }
+
+    result_.amplitude_c = a;
+    result_.tu_s = tu_s;
+    result_.ku = (4.0f * cfg_.amp_pct) / (3.14159265f * sqrtf(a2));
+
+    const float kp = 0.6f * result_.ku;
+    const float ti = 0.5f * tu_s;
+    const float td = 0.125f * tu_s;
+    result_.kp = kp;
+    result_.ki = kp / ti;
+    result_.kd = kp * td;
+    result_.status = Status::DONE;
+}
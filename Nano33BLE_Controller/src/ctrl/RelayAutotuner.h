@@ -0,0 +1,81 @@
+// ctrl/RelayAutotuner.h
+#pragma once
+
+#include <Arduino.h>
+
+// 继电反馈自整定（Åström–Hägglund）：
+// - 加热功率在 bias ± amp 之间按温度（带回差 hyst）切换，使对象进入极限环振荡
+// - 在线检测振荡周期 Tu 与幅值 a，连续若干周期稳定后：
+//     Ku = 4·amp / (π·sqrt(a² - hyst²))
+//   按 Ziegler–Nichols 计算 PID：Kp = 0.6·Ku, Ti = Tu/2, Td = Tu/8
+// - 温度超出 max_temp_c、测量无效或超时即中止（由调用方切 SAFE）
+
+class RelayAutotuner {
+public:
+    enum class Status : uint8_t {
+        IDLE = 0,
+        RUNNING,
+        DONE,
+        ABORT_LIMIT,     // 温度超出整定允许上限
+        ABORT_SENSOR,    // 测量/设定无效
+        ABORT_TIMEOUT,   // 超时仍未收敛
+        ABORT_EXTERNAL,  // 被模式切换/安全管理中断
+        REJECTED         // 已完成，但增益未通过调用方校验（超出参数表范围），未被采用
+    };
+
+    struct Config {
+        float    setpoint_c   = 0.0f;
+        float    bias_pct     = 30.0f;
+        float    amp_pct      = 30.0f;
+        float    hyst_c       = 0.2f;
+        float    max_temp_c   = 70.0f;
+        uint8_t  cycles       = 3;       // 需要连续稳定的振荡周期数
+        uint32_t timeout_ms   = 0;
+    };
+
+    struct Result {
+        Status  status    = Status::IDLE;
+        uint8_t cycles    = 0;       // 实际检测到的完整周期数
+        float   amplitude_c = 0.0f;  // 振荡半幅值 a
+        float   ku        = 0.0f;
+        float   tu_s      = 0.0f;
+        float   kp        = 0.0f;
+        float   ki        = 0.0f;
+        float   kd        = 0.0f;
+    };
+
+    void start(const Config &cfg, uint32_t now_ms);
+
+    // 每个控制节拍调用：返回加热功率；完成的那一拍返回 bias_pct，中止及之后返回 0
+    float update(float temp_c, uint32_t now_ms);
+
+    // 外部中断整定（模式切换、安全触发）
+    void abort(Status why);
+
+    // 调用方拒绝采用已完成的结果：DONE -> REJECTED（增益等其余字段保留，供上报）
+    void reject()
+    {
+        if (result_.status == Status::DONE) result_.status = Status::REJECTED;
+    }
+
+    bool running() const { return result_.status == Status::RUNNING; }
+    const Result &result() const { return result_; }
+
+private:
+    Config cfg_;
+    Result result_;
+
+    bool     relay_high_ = true;
+    uint32_t start_ms_ = 0;
+    uint32_t last_rise_ms_ = 0;     // 上一次切到高输出的时刻（周期起点）
+    bool     have_rise_ = false;
+    float    y_max_ = 0.0f;
+    float    y_min_ = 0.0f;
+
+    float    prev_tu_s_ = 0.0f;
+    float    prev_a_ = 0.0f;
+    uint8_t  stable_ = 0;
+
+    void onCycle(float tu_s, float a);
+    void finish(float tu_s, float a);
+};
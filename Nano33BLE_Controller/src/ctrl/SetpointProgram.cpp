@@ -0,0 +1,166 @@
+// ctrl/SetpointProgram.cpp
+#include "SetpointProgram.h"
+
+#include <math.h>
+
+#include "../util/BoardConfig.h"
+
+static constexpr uint8_t kDrivable = Proto::SP_ENABLE_TEMP | Proto::SP_ENABLE_PRESSURE;
+
+bool SetpointProgram::load(const Proto::ProgramSegmentV1 *segs, uint8_t count)
+{
+    if (!segs || count == 0 || count > Proto::PROGRAM_MAX_SEGMENTS) return false;
+
+    for (uint8_t i = 0; i < count; ++i) {
+        const Proto::ProgramSegmentV1 &s = segs[i];
+        if (s.type > Proto::PROGRAM_SEG_STEP) return false;
+        if ((s.enable_mask & ~kDrivable) != 0) return false;
+        if (s.type == Proto::PROGRAM_SEG_RAMP && s.duration_ms == 0) return false;
+        if (s.type != Proto::PROGRAM_SEG_HOLD && s.enable_mask == 0) return false;
+
+        // 目标值必须落在安全联锁阈值以内，避免程序本身把系统推向跳闸
+        if (s.enable_mask & Proto::SP_ENABLE_TEMP) {
+            if (!isfinite(s.temp_c) || s.temp_c >= max_temp_c_) return false;
+        }
+        if (s.enable_mask & Proto::SP_ENABLE_PRESSURE) {
+            if (!isfinite(s.pressure_pa) || s.pressure_pa < 0.0f ||
+                s.pressure_pa >= max_press_pa_) return false;
+        }
+    }
+
+    for (uint8_t i = 0; i < count; ++i) segs_[i] = segs[i];
+    count_ = count;
+    state_ = Proto::PROGRAM_READY;
+    seg_ = 0;
+    entered_ = false;
+    return true;
+}
+
+bool SetpointProgram::command(uint8_t op, const ControlState &state, uint32_t now_ms)
+{
+    switch (op) {
+    case Proto::PROGRAM_OP_START:
+        if (count_ == 0 || state.mode != ControlMode::AUTO) return false;
+        state_ = Proto::PROGRAM_RUNNING;
+        seg_ = 0;
+        entered_ = false;
+        return true;
+
+    case Proto::PROGRAM_OP_STOP:
+        if (!active()) return false;
+        finish(Proto::PROGRAM_ABORTED);
+        return true;
+
+    case Proto::PROGRAM_OP_PAUSE:
+        if (state_ != Proto::PROGRAM_RUNNING) return false;
+        state_ = Proto::PROGRAM_PAUSED;
+        paused_at_ms_ = now_ms;
+        return true;
+
+    case Proto::PROGRAM_OP_RESUME:
+        if (state_ != Proto::PROGRAM_PAUSED) return false;
+        if (state.mode != ControlMode::AUTO) return false;
+        seg_start_ms_ += now_ms - paused_at_ms_;   // 暂停时长不计入段内时间
+        state_ = Proto::PROGRAM_RUNNING;
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+void SetpointProgram::onOperatorSetpoint()
+{
+    if (active()) finish(Proto::PROGRAM_ABORTED);
+}
+
+void SetpointProgram::finish(uint8_t final_state)
+{
+    state_ = final_state;
+    entered_ = false;
+}
+
+void SetpointProgram::enterSegment(ControlState &state, const Proto::Telemetry &telem, uint32_t now_ms)
+{
+    const Proto::ProgramSegmentV1 &s = segs_[seg_];
+    Proto::Setpoints &sp = state.setpoints;
+
+    // 段起点：已启用通道沿用当前设定值（曲线连续）；未启用通道从测量值起步
+    start_temp_c_ = sp.target_temp_c;
+    if ((s.enable_mask & Proto::SP_ENABLE_TEMP) && !sp.enable_temp_ctrl) {
+        const float t = telem.temp_c[BoardConfig::TEMP_CTRL_CHANNEL];
+        if (isfinite(t)) start_temp_c_ = t;
+    }
+    start_pressure_pa_ = sp.target_pressure_pa;
+    if ((s.enable_mask & Proto::SP_ENABLE_PRESSURE) && !sp.enable_pressure_ctrl) {
+        if (isfinite(telem.pressure_pa)) start_pressure_pa_ = telem.pressure_pa;
+    }
+
+    if (s.enable_mask & Proto::SP_ENABLE_TEMP) sp.enable_temp_ctrl = true;
+    if (s.enable_mask & Proto::SP_ENABLE_PRESSURE) sp.enable_pressure_ctrl = true;
+
+    seg_start_ms_ = now_ms;
+    entered_ = true;
+}
+
+void SetpointProgram::applySegment(ControlState &state, uint32_t elapsed_ms, uint32_t now_ms)
+{
+    const Proto::ProgramSegmentV1 &s = segs_[seg_];
+    Proto::Setpoints &sp = state.setpoints;
+
+    float k = 1.0f;   // 段内进度（RAMP）；STEP 直接到终点
+    if (s.type == Proto::PROGRAM_SEG_RAMP) {
+        k = (elapsed_ms >= s.duration_ms) ? 1.0f
+                                          : static_cast<float>(elapsed_ms) / static_cast<float>(s.duration_ms);
+    } else if (s.type == Proto::PROGRAM_SEG_HOLD) {
+        k = 0.0f;
+    }
+
+    if (s.enable_mask & Proto::SP_ENABLE_TEMP) {
+        const float target = (s.type == Proto::PROGRAM_SEG_HOLD) ? start_temp_c_ : s.temp_c;
+        sp.target_temp_c = start_temp_c_ + (target - start_temp_c_) * k;
+    }
+    if (s.enable_mask & Proto::SP_ENABLE_PRESSURE) {
+        const float target = (s.type == Proto::PROGRAM_SEG_HOLD) ? start_pressure_pa_ : s.pressure_pa;
+        sp.target_pressure_pa = start_pressure_pa_ + (target - start_pressure_pa_) * k;
+    }
+    state.last_setpoint_ms = now_ms;
+}
+
+void SetpointProgram::tick(ControlState &state, const Proto::Telemetry &telem, uint32_t now_ms)
+{
+    if (state_ == Proto::PROGRAM_RUNNING && state.mode != ControlMode::AUTO) {
+        finish(Proto::PROGRAM_ABORTED);
+    }
+
+    if (state_ == Proto::PROGRAM_RUNNING) {
+        if (!entered_) enterSegment(state, telem, now_ms);
+
+        // 段到期：先把本段终点写入设定值，再进入下一段（同一拍内可跨过零时长段）
+        while (state_ == Proto::PROGRAM_RUNNING && now_ms - seg_start_ms_ >= segs_[seg_].duration_ms) {
+            const uint32_t end_ms = seg_start_ms_ + segs_[seg_].duration_ms;
+            applySegment(state, segs_[seg_].duration_ms, now_ms);
+            if (++seg_ >= count_) {
+                seg_ = static_cast<uint8_t>(count_ - 1);
+                finish(Proto::PROGRAM_DONE);
+                break;
+            }
+            enterSegment(state, telem, end_ms);
+        }
+        if (state_ == Proto::PROGRAM_RUNNING) {
+            applySegment(state, now_ms - seg_start_ms_, now_ms);
+        }
+    }
+
+    status_.state = state_;
+    status_.segment = seg_;
+    if (state_ == Proto::PROGRAM_RUNNING) {
+        status_.seg_elapsed_ms = now_ms - seg_start_ms_;
+    } else if (state_ == Proto::PROGRAM_PAUSED) {
+        status_.seg_elapsed_ms = paused_at_ms_ - seg_start_ms_;
+    } else if (state_ != Proto::PROGRAM_DONE) {
+        status_.seg_elapsed_ms = 0;
+    }
+    status_.sp_temp_c = state.setpoints.target_temp_c;
+    status_.sp_pressure_pa = state.setpoints.target_pressure_pa;
+}
@@ -0,0 +1,68 @@
+// ctrl/SetpointProgram.h
+#pragma once
+
+#include <Arduino.h>
+
+#include "ControlState.h"
+#include "../proto/Messages.h"
+#include "../proto/Protocol.h"
+#include "../util/BoardConfig.h"
+
+// 设定值程序（斜坡/保持/阶跃多段曲线），在控制器本地按控制节拍执行：
+// - 地面一次性上传（MSG_PROGRAM_V1，可靠下发），START 后每拍在 ModeManager::compute 之前
+//   改写 ControlState::setpoints，曲线形状不再受链路延迟/丢包影响
+// - 每段只改写 enable_mask 指定的通道（温度/压力），并置位对应的 enable_*_ctrl；
+//   段起点取进入该段时的设定值，若该通道此前未启用则取当前测量值
+// - 仅在 AUTO 下执行：START 需处于 AUTO，运行中离开 AUTO（含安全联锁切 SAFE）即中止；
+//   运行中收到操作员的设定值命令同样中止（操作员优先）
+// - PAUSE 冻结当前设定值与段内计时，RESUME 从暂停处继续
+
+class SetpointProgram {
+public:
+    struct Status {
+        uint8_t  state          = Proto::PROGRAM_EMPTY;
+        uint8_t  segment        = 0;
+        uint32_t seg_elapsed_ms = 0;
+        float    sp_temp_c      = 0.0f;   // 本拍生效的设定值（程序未运行时同样反映当前设定）
+        float    sp_pressure_pa = 0.0f;
+    };
+
+    // 校验并装载（段数、类型、时长、目标值范围）；失败时保持原程序不变。正在执行的程序被停止。
+    bool load(const Proto::ProgramSegmentV1 *segs, uint8_t count);
+
+    // 控制命令（Proto::PROGRAM_OP_*）；不适用于当前状态时返回 false
+    bool command(uint8_t op, const ControlState &state, uint32_t now_ms);
+
+    // 过温阈值（装载时校验温度目标），与 SafetyManager 保持一致
+    void setMaxTempC(float max_temp_c) { max_temp_c_ = max_temp_c; }
+    void setMaxPressPa(float max_press_pa) { max_press_pa_ = max_press_pa; }
+
+    // 操作员改写设定值：运行/暂停中的程序中止
+    void onOperatorSetpoint();
+
+    // 每个控制节拍调用（采集之后、控制计算之前）
+    void tick(ControlState &state, const Proto::Telemetry &telem, uint32_t now_ms);
+
+    bool active() const { return state_ == Proto::PROGRAM_RUNNING || state_ == Proto::PROGRAM_PAUSED; }
+    const Status &status() const { return status_; }
+
+private:
+    Proto::ProgramSegmentV1 segs_[Proto::PROGRAM_MAX_SEGMENTS];
+    uint8_t  count_ = 0;
+    uint8_t  state_ = Proto::PROGRAM_EMPTY;
+    float    max_temp_c_ = BoardConfig::SAFETY_MAX_TEMP_C;
+    float    max_press_pa_ = BoardConfig::SAFETY_MAX_PRESS_PA;
+
+    uint8_t  seg_ = 0;
+    bool     entered_ = false;        // 当前段起点是否已记录
+    uint32_t seg_start_ms_ = 0;
+    uint32_t paused_at_ms_ = 0;
+    float    start_temp_c_ = 0.0f;
+    float    start_pressure_pa_ = 0.0f;
+
+    Status   status_;
+
+    void enterSegment(ControlState &state, const Proto::Telemetry &telem, uint32_t now_ms);
+    void applySegment(ControlState &state, uint32_t elapsed_ms, uint32_t now_ms);
+    void finish(uint8_t final_state);
+};
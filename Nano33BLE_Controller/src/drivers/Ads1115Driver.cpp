@@ -1,8 +1,9 @@
 // drivers/Ads1115Driver.cpp
 #include "Ads1115Driver.h"
 
-void Ads1115Driver::begin() {
+void Ads1115Driver::begin(uint32_t i2c_hz) {
     Wire.begin();
+    Wire.setClock(i2c_hz);
 }
 
 void Ads1115Driver::writeReg16(uint8_t reg, uint16_t value)
@@ -57,4 +58,29 @@ int16_t Ads1115Driver::readDiff01(uint16_t config, uint16_t settle_ms)
     writeReg16(0x01, config);
     delay(settle_ms);
     return readReg16(0x00);
-}
\ No newline at end of file
+}
+
+void Ads1115Driver::startContinuous(uint16_t config)
+{
+    // MODE(bit8)=0 -> 连续转换；连续模式下 OS 位写入无意义，一并清掉
+    writeReg16(0x01, static_cast<uint16_t>(config & ~0x8100u));
+}
+
+void Ads1115Driver::startSingleShot(uint16_t config)
+{
+    writeReg16(0x01, static_cast<uint16_t>(config | 0x8100u));
+}
+
+bool Ads1115Driver::conversionReady()
+{
+    const uint16_t cfg = static_cast<uint16_t>(readReg16(0x01));
+    return last_ok_ && (cfg & 0x8000u) != 0;
+}
+
+bool Ads1115Driver::readLatest(int16_t &raw)
+{
+    const int16_t v = readReg16(0x00);
+    if (!last_ok_) return false;
+    raw = v;
+    return true;
+}
@@ -7,19 +7,34 @@
 // 极简 ADS1115 驱动：
 // - 不依赖 Adafruit 库
 // - 支持写配置寄存器、读转换寄存器
+// - 非阻塞接口：连续转换模式下直接读取最近一次转换结果；
+//   单次模式下通过配置寄存器 OS 位轮询转换是否完成（不 delay）
 
 class Ads1115Driver {
 public:
     explicit Ads1115Driver(uint8_t i2c_addr = 0x48) : addr_(i2c_addr) {}
 
-    void begin();
+    // i2c_hz：总线时钟（高速连续采样时用 400kHz）
+    void begin(uint32_t i2c_hz = 100000);
 
     void writeReg16(uint8_t reg, uint16_t value);
     int16_t readReg16(uint8_t reg);
 
-    // 差分 AIN0-AIN1，使用用户传入的 config
+    // 差分 AIN0-AIN1，使用用户传入的 config（阻塞：写配置后 delay 再读，仅保留兼容）
     int16_t readDiff01(uint16_t config, uint16_t settle_ms = 10);
 
+    // 连续转换：写入 MODE=0 的 config 后，ADC 按数据率自行转换
+    void startContinuous(uint16_t config);
+
+    // 单次转换：写入 config 并置 OS=1 启动一次转换，立即返回
+    void startSingleShot(uint16_t config);
+
+    // 单次转换是否完成（读配置寄存器 OS 位，1=空闲/完成）
+    bool conversionReady();
+
+    // 读取转换寄存器中的最近一次结果（不等待）；I2C 失败返回 false
+    bool readLatest(int16_t &raw);
+
     // 新增：上一次 I2C 读写是否成功
     bool lastOk() const { return last_ok_; }
 
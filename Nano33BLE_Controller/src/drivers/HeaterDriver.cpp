@@ -2,6 +2,16 @@
 #include "HeaterDriver.h"
 #include <math.h>
 
+#if defined(NRF52840_XXAA)
+#include <nrf.h>
+
+// 加热 PWM 使用 PWM3（Arduino analogWrite 默认从 PWM0 起分配）
+#define HEATER_PWM NRF_PWM3
+
+// 序列值 bit15 = 1：每个周期先输出高电平，计数到 COMP 时拉低（占空比 = COMP / COUNTERTOP）
+static constexpr uint16_t kPolarityHighFirst = 0x8000u;
+#endif
+
 static float clampPct(float v)
 {
     if (!isfinite(v)) return 0.0f;  // NaN/Inf -> 安全退化
@@ -14,9 +24,51 @@ void HeaterDriver::begin()
 {
     pinMode(pin_, OUTPUT);
     digitalWrite(pin_, LOW);
+    last_code_ = 0xFFFFFFFFu;
 
-    // Nano 33 BLE: analogWrite 分辨率可配置
+#if defined(NRF52840_XXAA)
+    // 选最小分频使 COUNTERTOP 不超过 15 bit，分辨率最高
+    uint32_t freq = (freq_hz_ == 0) ? 1000 : freq_hz_;
+    uint8_t prescaler = 0;
+    uint32_t top = 16000000UL / freq;
+    while (top > 32767UL && prescaler < 7) {
+        ++prescaler;
+        top = (16000000UL >> prescaler) / freq;
+    }
+    if (top < 2) top = 2;
+    if (top > 32767UL) top = 32767UL;
+    top_ = static_cast<uint16_t>(top);
+
+    HEATER_PWM->ENABLE = PWM_ENABLE_ENABLE_Disabled;
+    HEATER_PWM->PSEL.OUT[0] = static_cast<uint32_t>(digitalPinToPinName(pin_));
+    HEATER_PWM->PSEL.OUT[1] = PWM_PSEL_OUT_CONNECT_Disconnected << PWM_PSEL_OUT_CONNECT_Pos;
+    HEATER_PWM->PSEL.OUT[2] = PWM_PSEL_OUT_CONNECT_Disconnected << PWM_PSEL_OUT_CONNECT_Pos;
+    HEATER_PWM->PSEL.OUT[3] = PWM_PSEL_OUT_CONNECT_Disconnected << PWM_PSEL_OUT_CONNECT_Pos;
+    HEATER_PWM->MODE       = PWM_MODE_UPDOWN_Up;
+    HEATER_PWM->PRESCALER  = prescaler;
+    HEATER_PWM->COUNTERTOP = top_;
+    HEATER_PWM->DECODER    = (PWM_DECODER_LOAD_Common << PWM_DECODER_LOAD_Pos) |
+                             (PWM_DECODER_MODE_RefreshCount << PWM_DECODER_MODE_Pos);
+    HEATER_PWM->LOOP       = 0;
+    HEATER_PWM->SEQ[0].CNT      = DITHER_LEN;
+    HEATER_PWM->SEQ[0].REFRESH  = 0;
+    HEATER_PWM->SEQ[0].ENDDELAY = 0;
+    // 序列播放完立即重播：输出连续，PTR 在每次重播时重新装载
+    HEATER_PWM->SHORTS = PWM_SHORTS_SEQEND0_SEQSTART0_Msk;
+
+    for (uint8_t b = 0; b < 2; ++b) {
+        for (uint8_t i = 0; i < DITHER_LEN; ++i) seq_[b][i] = kPolarityHighFirst;
+    }
+    active_ = 0;
+    HEATER_PWM->SEQ[0].PTR = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(seq_[active_]));
+    HEATER_PWM->ENABLE = PWM_ENABLE_ENABLE_Enabled;
+    HEATER_PWM->TASKS_SEQSTART[0] = 1;
+    last_code_ = 0;
+#else
+    // 其他平台：8-bit analogWrite，无抖动
     analogWriteResolution(8);
+    top_ = 255;
+#endif
 }
 
 void HeaterDriver::setPowerPct(float pct)
@@ -24,6 +76,46 @@ void HeaterDriver::setPowerPct(float pct)
     pct = clampPct(pct);
     last_pct_ = pct;
 
-    const int duty = map(static_cast<int>(pct + 0.5f), 0, 100, 0, 255);
-    analogWrite(pin_, duty);
+#if defined(NRF52840_XXAA)
+    const uint32_t full = static_cast<uint32_t>(top_) * DITHER_LEN;
+#else
+    const uint32_t full = top_;
+#endif
+    const uint32_t code = static_cast<uint32_t>(pct * 0.01f * static_cast<float>(full) + 0.5f);
+
+    // 量化结果不变则不动寄存器
+    if (code == last_code_) return;
+    last_code_ = code;
+    writeCode(code);
+}
+
+void HeaterDriver::forceOff()
+{
+    last_pct_ = 0.0f;
+    last_code_ = 0;
+    writeCode(0);
+#if defined(NRF52840_XXAA)
+    // 以新 PTR 立即重启序列，当前 PWM 周期即输出低电平
+    HEATER_PWM->TASKS_SEQSTART[0] = 1;
+#endif
+}
+
+void HeaterDriver::writeCode(uint32_t code)
+{
+#if defined(NRF52840_XXAA)
+    // 一阶 sigma-delta：累加目标值，每周期输出整数部分，余数留给后续周期
+    const uint8_t next = active_ ^ 1u;
+    uint32_t acc = 0;
+    for (uint8_t i = 0; i < DITHER_LEN; ++i) {
+        acc += code;
+        const uint32_t v = acc / DITHER_LEN;
+        acc -= v * DITHER_LEN;
+        seq_[next][i] = static_cast<uint16_t>(v) | kPolarityHighFirst;
+    }
+    // 切换缓冲区：当前序列播放完后自动装载新 PTR
+    HEATER_PWM->SEQ[0].PTR = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(seq_[next]));
+    active_ = next;
+#else
+    analogWrite(pin_, static_cast<int>(code));
+#endif
 }
@@ -3,9 +3,21 @@
 
 #include <Arduino.h>
 
+// 加热片 PWM 驱动：
+// - nRF52840：直接使用 PWM 外设（NRF_PWM3，16 MHz 计数），载波频率可配置，
+//   COUNTERTOP = 16 MHz / 分频 / f（1 kHz 时 16000 级，约 14 bit；500 Hz 时 15 bit）
+// - 一阶 sigma-delta 抖动：DITHER_LEN 个 PWM 周期组成一个序列，各周期占空比整数部分之和
+//   等于目标值 × DITHER_LEN，有效分辨率 = 1 / (COUNTERTOP × DITHER_LEN)（1 kHz 时约 0.0004 %）
+// - 仅在量化后的目标值变化时改写寄存器：新序列写入备用缓冲区并切换 SEQ[0].PTR，
+//   在当前序列播放完后无缝生效
+// - 其他平台退化为 8-bit analogWrite（同样只在变化时写入）
+
 class HeaterDriver {
 public:
-    explicit HeaterDriver(uint8_t pin = 2) : pin_(pin) {}
+    static constexpr uint8_t DITHER_LEN = 16;
+
+    explicit HeaterDriver(uint8_t pin = 2, uint32_t pwm_freq_hz = 1000)
+        : pin_(pin), freq_hz_(pwm_freq_hz) {}
 
     void begin();
 
@@ -14,7 +26,25 @@ public:
 
     float lastPowerPct() const { return last_pct_; }
 
+    // 立即关断：不等当前抖动序列播放完（安全联锁用）
+    void forceOff();
+
+    // PWM 计数上限（每个 PWM 周期的占空比级数）
+    uint16_t counterTop() const { return top_; }
+
 private:
-    uint8_t pin_;
-    float last_pct_{0.0f};
+    uint8_t  pin_;
+    uint32_t freq_hz_;
+    float    last_pct_{0.0f};
+
+    uint16_t top_{255};
+    uint32_t last_code_{0xFFFFFFFFu};   // 上次写入的量化目标（0..top_ × DITHER_LEN）
+
+#if defined(NRF52840_XXAA)
+    // EasyDMA 读取的序列缓冲区（必须位于 RAM），双缓冲
+    uint16_t seq_[2][DITHER_LEN] = {};
+    uint8_t  active_{0};
+#endif
+
+    void writeCode(uint32_t code);
 };
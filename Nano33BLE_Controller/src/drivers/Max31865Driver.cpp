@@ -1,15 +1,16 @@
 // drivers/Max31865Driver.cpp
 #include "Max31865Driver.h"
 
-#include <math.h>
-
-void Max31865Driver::configure(uint8_t cs_pin, float rtd_r0, float rref, float a, float b)
+void Max31865Driver::configure(uint8_t cs_pin, float rtd_r0, float rref)
 {
     cs_pin_ = cs_pin;
     rtd_r0_ = rtd_r0;
-    rref_   = rref;
-    a_      = a;
-    b_      = b;
+    conv_.configure(rtd_r0, rref);
+}
+
+void Max31865Driver::setRref(float rref)
+{
+    conv_.configure(rtd_r0_, rref);
 }
 
 void Max31865Driver::begin()
@@ -23,7 +24,8 @@ void Max31865Driver::begin()
     // VBIAS=1, MODE=1(连续), 1SHOT=0, 3-wire=0(2/4线), Fault=00,
     // FaultClear=0, Filter=1(50Hz)
     // 0b1100 0011 = 0xC3
-    writeReg8(0x00, 0xC3);
+    cfg_ = 0xC3;
+    writeReg8(0x00, cfg_);
 
     // 清一次故障
     clearFault();
@@ -39,113 +41,94 @@ void Max31865Driver::writeReg8(uint8_t addr, uint8_t value)
     SPI.endTransaction();
 }
 
-uint16_t Max31865Driver::readReg16(uint8_t addr)
+void Max31865Driver::readRegs(uint8_t addr, uint8_t *buf, uint8_t n)
 {
+    // 读地址自动递增：一次 CS 周期读出连续寄存器
     SPI.beginTransaction(spi_);
     digitalWrite(cs_pin_, LOW);
     SPI.transfer(addr & 0x7F); // 读寄存器：最高位=0
-    const uint8_t msb = SPI.transfer(0x00);
-    const uint8_t lsb = SPI.transfer(0x00);
+    for (uint8_t i = 0; i < n; ++i) {
+        buf[i] = SPI.transfer(0x00);
+    }
     digitalWrite(cs_pin_, HIGH);
     SPI.endTransaction();
+}
 
-    return (static_cast<uint16_t>(msb) << 8) | static_cast<uint16_t>(lsb);
+void Max31865Driver::readFrame(Frame &f)
+{
+    // 0x01 RTD_MSB, 0x02 RTD_LSB, 0x03/0x04 高阈值, 0x05/0x06 低阈值, 0x07 故障
+    uint8_t b[7];
+    readRegs(0x01, b, sizeof(b));
+
+    const uint16_t rtd = (static_cast<uint16_t>(b[0]) << 8) | b[1];
+    f.rtd_raw   = rtd >> 1;          // bit0 为 fault
+    f.rtd_fault = (rtd & 0x0001u) != 0;
+    f.hi_thresh = (static_cast<uint16_t>(b[2]) << 8) | b[3];
+    f.lo_thresh = (static_cast<uint16_t>(b[4]) << 8) | b[5];
+    f.fault     = b[6];
 }
 
 uint16_t Max31865Driver::readRawRtd()
 {
     // RTD_MSB = 0x01, RTD_LSB = 0x02
-    uint16_t raw = readReg16(0x01);
-    raw >>= 1; // bit0 为 fault
-    return raw;
+    uint8_t b[2];
+    readRegs(0x01, b, sizeof(b));
+    const uint16_t raw = (static_cast<uint16_t>(b[0]) << 8) | b[1];
+    return raw >> 1; // bit0 为 fault
 }
 
 uint8_t Max31865Driver::readFault()
 {
     // Fault Status = 0x07
-    SPI.beginTransaction(spi_);
-    digitalWrite(cs_pin_, LOW);
-    SPI.transfer(0x07 & 0x7F);
-    uint8_t v = SPI.transfer(0x00);
-    digitalWrite(cs_pin_, HIGH);
-    SPI.endTransaction();
+    uint8_t v = 0;
+    readRegs(0x07, &v, 1);
     return v;
 }
 
 void Max31865Driver::clearFault()
 {
-    // 置位 FaultClear(bit1) 即可清除。
-    // 读取当前配置，然后 OR 0x02。
-    SPI.beginTransaction(spi_);
-    digitalWrite(cs_pin_, LOW);
-    SPI.transfer(0x00 & 0x7F);
-    uint8_t cfg = SPI.transfer(0x00);
-    digitalWrite(cs_pin_, HIGH);
-    SPI.endTransaction();
-
-    cfg |= 0x02;
-    writeReg8(0x00, cfg);
+    // 置位 FaultClear(bit1) 清除；同时 D5/D3/D2 须写 0（不启动故障检测周期）。
+    // 配置取本地缓存，单次写入。
+    writeReg8(0x00, static_cast<uint8_t>((cfg_ & ~0x2Cu) | 0x02u));
 }
 
-float Max31865Driver::resistanceToTempC(float rt_ohm)
-{
-    // 正温区解析解 (T >= 0 °C)
-    const float Z1 = -a_;
-    const float Z2 = a_ * a_ - (4.0f * b_);
-    const float Z3 = (4.0f * b_) / rtd_r0_;
-    const float Z4 = 2.0f * b_;
-
-    float temp = Z2 + (Z3 * rt_ohm);
-    temp = (sqrtf(temp) + Z1) / Z4;
-
-    if (temp >= 0.0f) {
-        return temp;
-    }
-
-    // 负温区近似多项式（与之前版本保持一致）
-    float rpoly = rt_ohm;
-    temp  = -242.02f;
-    temp += 2.2228f * rpoly;
-    rpoly *= rt_ohm;
-    temp += 2.5859e-3f * rpoly;
-    rpoly *= rt_ohm;
-    temp -= 4.8260e-6f * rpoly;
-    rpoly *= rt_ohm;
-    temp -= 2.8183e-8f * rpoly;
-    rpoly *= rt_ohm;
-    temp += 1.5243e-10f * rpoly;
-
-    return temp;
-}
-
-bool Max31865Driver::readResistanceOhm(float &rt_ohm)
+bool Max31865Driver::readCode(uint16_t &code)
 {
     if (cs_pin_ == 255) return false;
 
-    const uint8_t fault = readFault();
-    if (fault != 0) {
+    Frame f;
+    readFrame(f);
+    if (f.fault != 0 || f.rtd_fault) {
         clearFault();
         return false;
     }
 
-    const uint16_t raw = readRawRtd();
-    const float ratio = static_cast<float>(raw) / 32768.0f;
-    rt_ohm = ratio * rref_;
+    // 未写过阈值，应为上电默认值（高 0xFFFF、低 0x0000）；不符说明 SPI 通讯异常（例如 MISO 悬空/掉电）
+    if (f.hi_thresh != 0xFFFFu || f.lo_thresh != 0x0000u) {
+        return false;
+    }
 
-    // 粗略 sanity check
-    if (!isfinite(rt_ohm) || rt_ohm < 1.0f || rt_ohm > 2000.0f) {
+    // 粗略 sanity check：满量程/零读数视为开路或短路
+    if (f.rtd_raw == 0 || f.rtd_raw >= 0x7FFFu) {
         return false;
     }
 
+    code = f.rtd_raw;
+    return true;
+}
+
+bool Max31865Driver::readResistanceOhm(float &rt_ohm)
+{
+    uint16_t code = 0;
+    if (!readCode(code)) return false;
+    rt_ohm = conv_.codeToOhm(code);
     return true;
 }
 
 bool Max31865Driver::readTemperatureC(float &temp_c)
 {
-    float rt;
-    if (!readResistanceOhm(rt)) {
-        return false;
-    }
-    temp_c = resistanceToTempC(rt);
-    return isfinite(temp_c);
+    uint16_t code = 0;
+    if (!readCode(code)) return false;
+    last_code_ = code;
+    return conv_.codeToTempC(code, temp_c);
 }
@@ -4,33 +4,53 @@
 #include <Arduino.h>
 #include <SPI.h>
 
+#include "../util/RtdTable.h"
+
 // 极简 MAX31865 驱动：不依赖第三方库。
 // 配置为：
-// - 4 线 PT100
+// - 4 线 PT100 / PT1000（R0、RREF 按通道配置）
 // - 连续转换
 // - 50 Hz 工频滤波
+// 每次读取为一次 SPI 事务：从 0x01 连续读到 0x07（RTD、上下限阈值、故障），
+// 仅在出现故障时再写一次配置寄存器清除（配置取本地缓存，不做读-改-写）。
 
 class Max31865Driver {
 public:
+    // 一次突发读取得到的寄存器内容
+    struct Frame {
+        uint16_t rtd_raw   = 0;      // 15-bit RTD 码
+        bool     rtd_fault = false;  // RTD LSB bit0
+        uint16_t hi_thresh = 0;      // 0x03/0x04
+        uint16_t lo_thresh = 0;      // 0x05/0x06
+        uint8_t  fault     = 0;      // 0x07
+    };
+
     Max31865Driver() = default;
 
     void configure(uint8_t cs_pin,
                    float rtd_r0 = 100.0f,
-                   float rref   = 402.0f,
-                   float a      = 3.9083e-3f,
-                   float b      = -5.775e-7f);
+                   float rref   = 402.0f);
 
     void begin();
 
-    // 读取温度（°C）。返回 false 表示出现故障位或读数明显异常。
+    // 更换参考电阻标定值（现场标定）；R0 不变
+    void setRref(float rref);
+
+    // 读取温度（°C，查表插值）。返回 false 表示出现故障位、读数异常或超出 -259..850 °C（低温表 + CVD 表的覆盖范围）。
     bool readTemperatureC(float &temp_c);
 
     // 读取电阻（Ω）。返回 false 表示故障。
     bool readResistanceOhm(float &rt_ohm);
 
+    // 突发读取 0x01..0x07
+    void readFrame(Frame &f);
+
     // 原始 15-bit RTD 码（已去掉 fault bit）
     uint16_t readRawRtd();
 
+    // 最近一次有效读数的 15-bit RTD 码（观测用）
+    uint16_t lastCode() const { return last_code_; }
+
     // 故障寄存器（0x07）
     uint8_t readFault();
 
@@ -40,14 +60,17 @@ public:
 private:
     uint8_t cs_pin_{255};
     float rtd_r0_{100.0f};
-    float rref_{402.0f};
-    float a_{3.9083e-3f};
-    float b_{-5.775e-7f};
+    uint16_t last_code_{0};
+    RtdConverter conv_;
 
     SPISettings spi_{500000, MSBFIRST, SPI_MODE1};
 
+    // 配置寄存器缓存（begin() 写入的值）
+    uint8_t cfg_{0xC3};
+
     void writeReg8(uint8_t addr, uint8_t value);
-    uint16_t readReg16(uint8_t addr);
+    void readRegs(uint8_t addr, uint8_t *buf, uint8_t n);
 
-    float resistanceToTempC(float rt_ohm);
+    // 突发读取并检查故障，得到有效的 15-bit RTD 码
+    bool readCode(uint16_t &code);
 };
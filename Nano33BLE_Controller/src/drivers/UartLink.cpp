@@ -1,15 +1,35 @@
 // drivers/UartLink.cpp
 #include "UartLink.h"
 
+#include <math.h>
 #include <string.h>
 
+static uint16_t sat16(uint32_t v)
+{
+    return (v > 0xFFFFu) ? 0xFFFFu : static_cast<uint16_t>(v);
+}
+
+// 百分比 -> 0.01 % 整数（0..10000）
+static uint16_t pctToCpct(float pct)
+{
+    if (!(pct > 0.0f)) return 0;
+    if (pct >= 100.0f) return 10000;
+    return static_cast<uint16_t>(pct * 100.0f + 0.5f);
+}
+
 void UartLink::begin(uint32_t baud)
 {
     serial_.begin(baud);
+    bytes_per_s_ = baud / 10;   // 8N1：每字节 10 bit
+    tx_credit_ = 0;
+    tx_last_us_ = micros();
 }
 
 void UartLink::poll(ControlState &state, uint32_t now_ms)
 {
+    // 先发出上一条已生效命令的追踪记录，再解析新命令（新命令会覆盖追踪槽）
+    serviceCmdTrace();
+
     while (serial_.available() > 0) {
         uint8_t b = static_cast<uint8_t>(serial_.read());
         FrameCodec::FrameView f;
@@ -17,6 +37,152 @@ void UartLink::poll(ControlState &state, uint32_t now_ms)
             handleFrame(f, state, now_ms);
         }
     }
+
+    serviceTx();
+}
+
+// ===== 发送队列 =====
+
+void UartLink::queueFrame(TxClass cls, uint8_t msg_type, uint8_t seq, const void *payload, size_t len)
+{
+    uint8_t buf[MAX_FRAME];
+    const size_t n = FrameCodec::encode(msg_type, seq,
+                                        static_cast<const uint8_t*>(payload),
+                                        static_cast<uint8_t>(len),
+                                        buf, sizeof(buf));
+    if (n == 0) return;
+
+    if (cls == TxClass::URGENT) {
+        // 帧以 [len][bytes] 存入环形缓冲；放不下整帧则丢弃，绝不拆帧
+        if (hi_used_ + 1u + n > sizeof(hi_ring_)) {
+            ++hi_drops_;
+            return;
+        }
+        uint16_t w = static_cast<uint16_t>((hi_head_ + hi_used_) % sizeof(hi_ring_));
+        hi_ring_[w] = static_cast<uint8_t>(n);
+        for (size_t i = 0; i < n; ++i) {
+            if (++w >= sizeof(hi_ring_)) w = 0;
+            hi_ring_[w] = buf[i];
+        }
+        hi_used_ = static_cast<uint16_t>(hi_used_ + 1u + n);
+    } else {
+        // 遥测/诊断/DAQ/分段耗时只关心最新值：未发出的旧帧直接被覆盖（只有遥测/诊断计覆盖数）
+        TxSlot *slot = &diag_slot_;
+        if (cls == TxClass::TELEM) {
+            slot = &telem_slot_;
+            if (slot->len) ++telem_overwrites_;
+        } else if (cls == TxClass::DAQ) {
+            slot = &daq_slot_;
+#if CTRL_PROFILE
+        } else if (cls == TxClass::PROFILE) {
+            slot = &prof_slot_;
+#endif
+        } else if (slot->len) {
+            ++diag_overwrites_;
+        }
+        memcpy(slot->buf, buf, n);
+        slot->len = static_cast<uint8_t>(n);
+    }
+
+    const uint32_t q = queuedBytes();
+    if (q > queued_max_) queued_max_ = q;
+
+    serviceTx();
+}
+
+bool UartLink::loadNextFrame()
+{
+    if (hi_used_) {
+        const uint8_t n = hi_ring_[hi_head_];
+        uint16_t r = hi_head_;
+        for (uint8_t i = 0; i < n; ++i) {
+            if (++r >= sizeof(hi_ring_)) r = 0;
+            cur_[i] = hi_ring_[r];
+        }
+        hi_head_ = static_cast<uint16_t>((r + 1u) % sizeof(hi_ring_));
+        hi_used_ = static_cast<uint16_t>(hi_used_ - 1u - n);
+        cur_len_ = n;
+    } else if (telem_slot_.len) {
+        memcpy(cur_, telem_slot_.buf, telem_slot_.len);
+        cur_len_ = telem_slot_.len;
+        telem_slot_.len = 0;
+    } else if (diag_slot_.len) {
+        memcpy(cur_, diag_slot_.buf, diag_slot_.len);
+        cur_len_ = diag_slot_.len;
+        diag_slot_.len = 0;
+#if CTRL_PROFILE
+    } else if (prof_slot_.len) {
+        memcpy(cur_, prof_slot_.buf, prof_slot_.len);
+        cur_len_ = prof_slot_.len;
+        prof_slot_.len = 0;
+#endif
+    } else if (daq_slot_.len) {
+        memcpy(cur_, daq_slot_.buf, daq_slot_.len);
+        cur_len_ = daq_slot_.len;
+        daq_slot_.len = 0;
+    } else {
+        return false;
+    }
+    cur_off_ = 0;
+    return true;
+}
+
+// 按线路速率写出：Serial1 在 mbed 内核上的 write() 逐字节等待 UARTE 收下，
+// 这里只写出自上次以来线路已送走、且 UARTE 能立即收下的字节数（额度上限 UART_TX_BURST_BYTES），
+// 使 write() 不阻塞主循环；线路空闲时积攒的额度不会变成一次长时间的阻塞写
+void UartLink::serviceTx()
+{
+    const uint32_t now_us = micros();
+    uint32_t dt_us = now_us - tx_last_us_;
+    tx_last_us_ = now_us;
+    if (dt_us > 100000u) dt_us = 100000u;
+
+    static constexpr uint32_t BYTE_UNIT = 1000000u;
+    static constexpr uint32_t CREDIT_MAX = BoardConfig::UART_TX_BURST_BYTES * BYTE_UNIT;
+    const uint64_t credit = tx_credit_ + static_cast<uint64_t>(dt_us) * bytes_per_s_;
+    tx_credit_ = (credit > CREDIT_MAX) ? CREDIT_MAX : static_cast<uint32_t>(credit);
+
+    while (tx_credit_ >= BYTE_UNIT) {
+        if (cur_off_ >= cur_len_ && !loadNextFrame()) break;
+
+        uint32_t n = tx_credit_ / BYTE_UNIT;
+        const uint32_t left = static_cast<uint32_t>(cur_len_ - cur_off_);
+        if (n > left) n = left;
+        serial_.write(cur_ + cur_off_, n);
+        cur_off_ = static_cast<uint8_t>(cur_off_ + n);
+        tx_credit_ -= n * BYTE_UNIT;
+    }
+}
+
+uint32_t UartLink::queuedBytes() const
+{
+    // 高优先级环中每帧另有 1 字节长度前缀，不计入待发字节
+    uint32_t q = static_cast<uint32_t>(cur_len_ - cur_off_) + telem_slot_.len + diag_slot_.len;
+#if CTRL_PROFILE
+    q += prof_slot_.len;
+#endif
+    q += daq_slot_.len;
+    uint16_t r = hi_head_;
+    uint16_t left = hi_used_;
+    while (left) {
+        const uint8_t n = hi_ring_[r];
+        q += n;
+        left = static_cast<uint16_t>(left - 1u - n);
+        r = static_cast<uint16_t>((r + 1u + n) % sizeof(hi_ring_));
+    }
+    return q;
+}
+
+UartLink::TxStats UartLink::takeTxStats()
+{
+    TxStats s;
+    s.queued_bytes = queuedBytes();
+    s.queued_max = (queued_max_ > s.queued_bytes) ? queued_max_ : s.queued_bytes;
+    s.hi_drops = hi_drops_;
+    s.telem_overwrites = telem_overwrites_;
+    s.diag_overwrites = diag_overwrites_;
+    queued_max_ = s.queued_bytes;
+    return s;
 }
 
 void UartLink::handleFrame(const FrameCodec::FrameView &f, ControlState &state, uint32_t now_ms)
@@ -40,18 +206,20 @@ void UartLink::handleFrame(const FrameCodec::FrameView &f, ControlState &state,
             Proto::PayloadModeSwitch p;
             memcpy(&p, f.payload, sizeof(p));
 
+            bool ok = true;
             if (p.mode == Proto::MODE_SAFE) {
                 state.mode = ControlMode::SAFE;
-                sendAck(f.msg_type, f.seq, Proto::ACK_OK);
             } else if (p.mode == Proto::MODE_MANUAL) {
                 state.mode = ControlMode::MANUAL;
-                sendAck(f.msg_type, f.seq, Proto::ACK_OK);
             } else if (p.mode == Proto::MODE_AUTO) {
                 state.mode = ControlMode::AUTO;
-                sendAck(f.msg_type, f.seq, Proto::ACK_OK);
+            } else if (p.mode == Proto::MODE_AUTOTUNE) {
+                state.mode = ControlMode::AUTOTUNE;
             } else {
-                sendAck(f.msg_type, f.seq, Proto::ACK_ERR);
+                ok = false;
             }
+            if (ok) traceCommand(f, millis());
+            sendAck(f.msg_type, f.seq, ok ? Proto::ACK_OK : Proto::ACK_ERR);
         } else {
             sendAck(f.msg_type, f.seq, Proto::ACK_ERR);
         }
@@ -71,6 +239,7 @@ void UartLink::handleFrame(const FrameCodec::FrameView &f, ControlState &state,
             state.manual_cmd.pump_target_temp_c = p.pump_target_temp_c;
 
             state.last_manual_ms = now_ms;
+            traceCommand(f, millis());
             sendAck(f.msg_type, f.seq, Proto::ACK_OK);
         } else {
             sendAck(f.msg_type, f.seq, Proto::ACK_ERR);
@@ -92,44 +261,440 @@ void UartLink::handleFrame(const FrameCodec::FrameView &f, ControlState &state,
             state.setpoints.enable_valve_ctrl     = (p.enable_mask & Proto::SP_ENABLE_VALVE) != 0;
 
             state.last_setpoint_ms = now_ms;
+            if (program_) program_->onOperatorSetpoint();
+            traceCommand(f, millis());
             sendAck(f.msg_type, f.seq, Proto::ACK_OK);
         } else {
             sendAck(f.msg_type, f.seq, Proto::ACK_ERR);
         }
         break;
 
+    case Proto::MSG_PROGRAM_V1: {
+        // 变长：头 + count 段
+        bool ok = false;
+        if (program_ && f.payload_len >= sizeof(Proto::PayloadProgramV1)) {
+            Proto::PayloadProgramV1 h;
+            memcpy(&h, f.payload, sizeof(h));
+            if (h.count <= Proto::PROGRAM_MAX_SEGMENTS &&
+                f.payload_len == sizeof(h) + h.count * sizeof(Proto::ProgramSegmentV1)) {
+                Proto::ProgramSegmentV1 segs[Proto::PROGRAM_MAX_SEGMENTS];
+                memcpy(segs, f.payload + sizeof(h), h.count * sizeof(Proto::ProgramSegmentV1));
+                ok = program_->load(segs, h.count);
+            }
+        }
+        sendAck(f.msg_type, f.seq, ok ? Proto::ACK_OK : Proto::ACK_ERR);
+        break;
+    }
+
+    case Proto::MSG_PROGRAM_CTRL:
+        if (program_ && f.payload_len == sizeof(Proto::PayloadProgramCtrl)) {
+            Proto::PayloadProgramCtrl p;
+            memcpy(&p, f.payload, sizeof(p));
+            const bool ok = program_->command(p.op, state, now_ms);
+            sendAck(f.msg_type, f.seq, ok ? Proto::ACK_OK : Proto::ACK_ERR);
+        } else {
+            sendAck(f.msg_type, f.seq, Proto::ACK_ERR);
+        }
+        break;
+
+    case Proto::MSG_CAPTURE_CMD:
+        // 应答即状态帧/分块本身；丢失时由地面重新请求
+        if (capture_ && f.payload_len == sizeof(Proto::PayloadCaptureCmd)) {
+            Proto::PayloadCaptureCmd p;
+            memcpy(&p, f.payload, sizeof(p));
+            handleCaptureCmd(p, now_ms);
+        }
+        break;
+
+    case Proto::MSG_DAQ_CMD:
+        handleDaqCmd(f);
+        break;
+
+    case Proto::MSG_CONFIG_CMD:
+        // 应答即 MSG_CONFIG_VALUE（携带命令 seq），地面据此完成可靠下发
+        if (f.payload_len == sizeof(Proto::PayloadConfigCmd)) {
+            Proto::PayloadConfigCmd p;
+            memcpy(&p, f.payload, sizeof(p));
+            handleConfigCmd(p, f.seq, state);
+        } else {
+            sendAck(f.msg_type, f.seq, Proto::ACK_ERR);
+        }
+        break;
+
+    case Proto::MSG_PARAM_BATCH:
+        handleParamBatch(f);
+        break;
+
+    case Proto::MSG_TIME_SYNC:
+        handleTimeSync(f);
+        break;
+
+    case Proto::MSG_METRICS_CMD:
+        handleMetricsCmd(f);
+        break;
+
     default:
         // 未识别消息：不回 ACK，避免误触发重发机制
         break;
     }
 }
 
+void UartLink::handleCaptureCmd(const Proto::PayloadCaptureCmd &p, uint32_t now_ms)
+{
+    switch (p.op) {
+    case Proto::CAPTURE_OP_TRIGGER:
+        capture_->trigger(Proto::CAPTURE_REASON_OPERATOR, now_ms);
+        sendCaptureInfo();
+        break;
+    case Proto::CAPTURE_OP_ARM:
+        capture_->arm();
+        sendCaptureInfo();
+        break;
+    case Proto::CAPTURE_OP_READ:
+        sendCaptureChunk(p.index);
+        break;
+    case Proto::CAPTURE_OP_INFO:
+    default:
+        sendCaptureInfo();
+        break;
+    }
+}
+
+void UartLink::sendCaptureInfo()
+{
+    if (!capture_) return;
+
+    Proto::PayloadCaptureInfoV1 p;
+    capture_->fillInfo(p);
+
+    queueFrame(TxClass::URGENT, Proto::MSG_CAPTURE_INFO, tx_seq_++, &p, sizeof(p));
+}
+
+void UartLink::sendCaptureChunk(uint16_t index)
+{
+    static_assert(sizeof(Proto::PayloadCaptureChunkV1) + Proto::CAPTURE_CHUNK_RECORDS * sizeof(Proto::CaptureRecordV1) <=
+                      FrameCodec::MAX_PAYLOAD,
+                  "capture chunk must fit in one frame");
+
+    // 变长负载：分块头 + count 条记录；越界时 count = 0（告知地面已到末尾）
+    uint8_t payload[sizeof(Proto::PayloadCaptureChunkV1) +
+                    Proto::CAPTURE_CHUNK_RECORDS * sizeof(Proto::CaptureRecordV1)];
+    Proto::CaptureRecordV1 recs[Proto::CAPTURE_CHUNK_RECORDS];
+
+    Proto::PayloadCaptureInfoV1 info;
+    capture_->fillInfo(info);
+
+    Proto::PayloadCaptureChunkV1 h;
+    h.capture_id = info.capture_id;
+    h.index = index;
+    h.count = capture_->read(index, recs, Proto::CAPTURE_CHUNK_RECORDS);
+
+    memcpy(payload, &h, sizeof(h));
+    memcpy(payload + sizeof(h), recs, h.count * sizeof(Proto::CaptureRecordV1));
+    const uint8_t len = static_cast<uint8_t>(sizeof(h) + h.count * sizeof(Proto::CaptureRecordV1));
+
+    queueFrame(TxClass::URGENT, Proto::MSG_CAPTURE_CHUNK, tx_seq_++, payload, len);
+}
+
+void UartLink::handleDaqCmd(const FrameCodec::FrameView &f)
+{
+    // 变长：头 + count 个变量 id（仅 START 使用）
+    Proto::PayloadDaqCmdV1 p;
+    if (f.payload_len < sizeof(p)) {
+        sendAck(f.msg_type, f.seq, Proto::ACK_ERR);
+        return;
+    }
+    memcpy(&p, f.payload, sizeof(p));
+
+    if (daq_ && p.op == Proto::DAQ_OP_CATALOG) {
+        uint8_t payload[FrameCodec::MAX_PAYLOAD];
+        const uint8_t len = daq_->fillCatalog(p.index, payload, sizeof(payload));
+        queueFrame(TxClass::URGENT, Proto::MSG_DAQ_CATALOG, f.seq, payload, len);
+        return;
+    }
+
+    uint8_t status = Proto::DAQ_OK;
+    if (!daq_) {
+        status = Proto::DAQ_ERR_OP;
+    } else if (p.op == Proto::DAQ_OP_START) {
+        if (p.count > Proto::DAQ_MAX_VARS || f.payload_len != sizeof(p) + p.count) {
+            status = Proto::DAQ_ERR_SIZE;
+        } else {
+            status = daq_->start(f.payload + sizeof(p), p.count, p.divider, p.samples_per_frame);
+        }
+    } else if (p.op == Proto::DAQ_OP_STOP) {
+        daq_->stop();
+    } else if (p.op != Proto::DAQ_OP_STATUS) {
+        status = Proto::DAQ_ERR_OP;
+    }
+
+    Proto::PayloadDaqStatusV1 s;
+    if (daq_) {
+        daq_->fillStatus(s, status);
+    } else {
+        memset(&s, 0, sizeof(s));
+        s.status = status;
+    }
+    queueFrame(TxClass::URGENT, Proto::MSG_DAQ_STATUS, f.seq, &s, sizeof(s));
+}
+
+void UartLink::sendDaq(const uint8_t *payload, uint8_t len)
+{
+    queueFrame(TxClass::DAQ, Proto::MSG_DAQ_V1, tx_seq_++, payload, len);
+}
+
+void UartLink::handleParamBatch(const FrameCodec::FrameView &f)
+{
+    Proto::PayloadParamBatchV1 p;
+    if (f.payload_len < sizeof(p)) {
+        sendAck(f.msg_type, f.seq, Proto::ACK_ERR);
+        return;
+    }
+    memcpy(&p, f.payload, sizeof(p));
+    const uint8_t *items = f.payload + sizeof(p);
+    const size_t items_len = f.payload_len - sizeof(p);
+
+    const bool by_value = (p.op == Proto::PARAM_OP_STAGE || p.op == Proto::PARAM_OP_SET_COMMIT);
+    const bool by_id = (p.op == Proto::PARAM_OP_GET || p.op == Proto::PARAM_OP_INFO);
+    if (p.count > Proto::PARAM_BATCH_MAX ||
+        (by_value && (p.count == 0 || items_len != p.count * sizeof(Proto::ParamSetItemV1))) ||
+        (by_id && items_len != p.count) ||
+        (!by_value && !by_id && items_len != 0)) {
+        sendAck(f.msg_type, f.seq, Proto::ACK_ERR);
+        return;
+    }
+
+    // 本批涉及的参数：显式列表，或 GET/INFO 的 count = 0（从 first 起的全部参数）
+    uint8_t ids[Proto::CFG_ID_LIMIT];
+    float   values[Proto::PARAM_BATCH_MAX];
+    uint8_t item_status[Proto::CFG_ID_LIMIT];
+    uint8_t n = 0;
+    if (by_value) {
+        for (uint8_t i = 0; i < p.count; ++i) {
+            Proto::ParamSetItemV1 it;
+            memcpy(&it, items + i * sizeof(it), sizeof(it));
+            ids[n] = it.id;
+            values[n] = it.value;
+            ++n;
+        }
+    } else if (by_id && p.count > 0) {
+        for (uint8_t i = 0; i < p.count; ++i) ids[n++] = items[i];
+    } else if (by_id) {
+        for (uint16_t id = p.first; id < Proto::CFG_ID_LIMIT; ++id) {
+            uint8_t type;
+            float lo, hi;
+            if (ConfigStore::info(static_cast<uint8_t>(id), type, lo, hi)) ids[n++] = static_cast<uint8_t>(id);
+        }
+    }
+
+    Proto::PayloadParamReplyV1 r;
+    r.op = p.op;
+    r.status = Proto::CONFIG_OK;
+    r.count = 0;
+    for (uint8_t i = 0; i < n; ++i) item_status[i] = Proto::CONFIG_OK;
+
+    if (!config_) {
+        r.status = Proto::CONFIG_ERR_STATE;
+    } else if (p.expect_version != 0 && p.expect_version != config_->version() &&
+               (by_value || p.op == Proto::PARAM_OP_COMMIT)) {
+        r.status = Proto::CONFIG_ERR_VERSION;
+    } else if (by_value) {
+        r.status = config_->stage(ids, values, n, item_status);
+        if (r.status == Proto::CONFIG_OK && p.op == Proto::PARAM_OP_SET_COMMIT) {
+            r.status = config_->applyStaged();
+        }
+    } else if (p.op == Proto::PARAM_OP_COMMIT) {
+        r.status = config_->applyStaged();
+    } else if (p.op == Proto::PARAM_OP_ROLLBACK) {
+        config_->rollback();
+    } else if (!by_id) {
+        r.status = Proto::CONFIG_ERR_OP;
+    }
+    if (by_value && r.status != Proto::CONFIG_OK) {
+        for (uint8_t i = 0; i < n; ++i) {
+            if (item_status[i] == Proto::CONFIG_OK) item_status[i] = r.status;
+        }
+    }
+
+    // 应答：放不下的项截断（count 为实际条数，地面按最后一项 id 续读）
+    uint8_t payload[FrameCodec::MAX_PAYLOAD];
+    size_t len = sizeof(r);
+    for (uint8_t i = 0; config_ && i < n; ++i) {
+        uint8_t type = Proto::DAQ_T_F32;
+        float lo = 0.0f, hi = 0.0f;
+        const bool known = ConfigStore::info(ids[i], type, lo, hi);
+        if (p.op == Proto::PARAM_OP_INFO) {
+            if (!known) continue;
+            if (len + sizeof(Proto::ParamInfoItemV1) > sizeof(payload)) break;
+            Proto::ParamInfoItemV1 it;
+            it.id = ids[i];
+            it.type = type;
+            it.min_v = lo;
+            it.max_v = hi;
+            memcpy(payload + len, &it, sizeof(it));
+            len += sizeof(it);
+        } else {
+            if (len + sizeof(Proto::ParamValueItemV1) > sizeof(payload)) break;
+            Proto::ParamValueItemV1 it;
+            it.id = ids[i];
+            it.type = type;
+            it.value = NAN;
+            it.status = (p.op == Proto::PARAM_OP_STAGE) ? config_->getStaged(ids[i], it.value)
+                                                        : config_->get(ids[i], it.value);
+            if (it.status == Proto::CONFIG_OK) it.status = item_status[i];
+            memcpy(payload + len, &it, sizeof(it));
+            len += sizeof(it);
+        }
+        ++r.count;
+    }
+
+    r.staged = (config_ && config_->staged()) ? 1 : 0;
+    r.version = config_ ? config_->version() : 0;
+    memcpy(payload, &r, sizeof(r));
+    queueFrame(TxClass::URGENT, Proto::MSG_PARAM_REPLY, f.seq, payload, len);
+}
+
+void UartLink::handleTimeSync(const FrameCodec::FrameView &f)
+{
+    // 收到时刻取 millis()（poll 的 now_ms 为本轮循环起点，可能已滞后）
+    const uint32_t t2 = millis();
+    if (f.payload_len != sizeof(Proto::PayloadTimeSyncV1)) return;
+
+    Proto::PayloadTimeSyncV1 req;
+    memcpy(&req, f.payload, sizeof(req));
+    clock_synced_ = req.synced != 0;
+    clock_offset_ms_ = req.offset_ms;
+    clock_rx_ms_ = t2;
+
+    Proto::PayloadTimeSyncV1 r;
+    memset(&r, 0, sizeof(r));
+    r.id = req.id;
+    r.t1_ms = req.t1_ms;
+    r.t2_ms = t2;
+    r.t3_ms = millis();
+    queueFrame(TxClass::URGENT, Proto::MSG_TIME_SYNC_REPLY, f.seq, &r, sizeof(r));
+}
+
+void UartLink::handleMetricsCmd(const FrameCodec::FrameView &f)
+{
+    if (f.payload_len != sizeof(Proto::PayloadMetricsCmdV1)) return;
+    Proto::PayloadMetricsCmdV1 p;
+    memcpy(&p, f.payload, sizeof(p));
+    if (p.node != Proto::METRICS_NODE_CTRL) return;
+
+    uint8_t payload[FrameCodec::MAX_PAYLOAD];
+    uint8_t len = 0;
+    if (p.op == Proto::METRICS_OP_SNAPSHOT) {
+        len = Metrics::encodeSnapshot(p.node, p.first, payload, sizeof(payload));
+    } else if (p.op == Proto::METRICS_OP_CATALOG) {
+        len = Metrics::encodeCatalog(p.node, p.first, payload, sizeof(payload));
+    }
+    // 应答即数据本身；丢失时由地面重新请求
+    if (len) queueFrame(TxClass::URGENT, Proto::MSG_METRICS_V1, f.seq, payload, len);
+}
+
+void UartLink::traceCommand(const FrameCodec::FrameView &f, uint32_t parse_ms)
+{
+    trace_.msg_type = f.msg_type;
+    trace_.seq = f.seq;
+    trace_.parse_ms = parse_ms;
+    trace_.applied = false;
+    trace_.pending = true;
+}
+
+void UartLink::serviceCmdTrace()
+{
+    if (!trace_.pending || !trace_.applied) return;
+    trace_.pending = false;
+
+    Proto::PayloadCmdTraceV1 p;
+    memset(&p, 0, sizeof(p));
+    p.msg_type = trace_.msg_type;
+    p.ctrl_parse_ms = trace_.parse_ms;
+    p.ctrl_apply_ms = trace_.apply_ms;
+    // 排在 ACK 之后（同一高优先级队列，先进先出）
+    queueFrame(TxClass::URGENT, Proto::MSG_CMD_TRACE, trace_.seq, &p, sizeof(p));
+}
+
+void UartLink::handleConfigCmd(const Proto::PayloadConfigCmd &p, uint8_t seq, const ControlState &state)
+{
+    Proto::PayloadConfigValueV1 r;
+    r.op = p.op;
+    r.id = p.id;
+    r.status = Proto::CONFIG_OK;
+    r.dirty = 0;
+    r.value = 0.0f;
+    r.commit_seq = 0;
+
+    if (!config_) {
+        r.status = Proto::CONFIG_ERR_STATE;
+        queueFrame(TxClass::URGENT, Proto::MSG_CONFIG_VALUE, seq, &r, sizeof(r));
+        return;
+    }
+
+    switch (p.op) {
+    case Proto::CONFIG_OP_GET:
+        break;
+    case Proto::CONFIG_OP_SET:
+        r.status = config_->set(p.id, p.value);
+        break;
+    case Proto::CONFIG_OP_COMMIT:
+        // 扇区擦除期间 CPU 停顿数十 ms，控制节拍会丢失：只在输出已归零的 SAFE 下写 Flash
+        if (state.mode != ControlMode::SAFE) {
+            r.status = Proto::CONFIG_ERR_STATE;
+        } else if (!config_->commit()) {
+            r.status = Proto::CONFIG_ERR_FLASH;
+        }
+        break;
+    case Proto::CONFIG_OP_DEFAULTS:
+        config_->restoreDefaults();
+        break;
+    case Proto::CONFIG_OP_RELOAD:
+        config_->reload();
+        break;
+    default:
+        r.status = Proto::CONFIG_ERR_OP;
+        break;
+    }
+
+    // 回显参数当前值（id 无效时保留 GET/SET 的错误码，其余操作不因 id 失败）
+    float v = 0.0f;
+    const uint8_t st = config_->get(p.id, v);
+    if (st == Proto::CONFIG_OK) {
+        r.value = v;
+    } else if (r.status == Proto::CONFIG_OK && (p.op == Proto::CONFIG_OP_GET || p.op == Proto::CONFIG_OP_SET)) {
+        r.status = st;
+    }
+    r.dirty = config_->dirty() ? 1 : 0;
+    r.commit_seq = config_->commitSeq();
+
+    queueFrame(TxClass::URGENT, Proto::MSG_CONFIG_VALUE, seq, &r, sizeof(r));
+}
+
 void UartLink::sendAck(uint8_t acked_msg_type, uint8_t seq, uint8_t status)
 {
     Proto::PayloadAck p;
     p.acked_msg_type = acked_msg_type;
     p.status = status;
 
-    uint8_t buf[32];
-    const size_t n = FrameCodec::encode(Proto::MSG_ACK, seq,
-                                        reinterpret_cast<uint8_t*>(&p),
-                                        static_cast<uint8_t>(sizeof(p)),
-                                        buf, sizeof(buf));
-    if (n) {
-        serial_.write(buf, n);
-    }
+    queueFrame(TxClass::URGENT, Proto::MSG_ACK, seq, &p, sizeof(p));
 }
 
 void UartLink::sendTelemetry(const Proto::Telemetry &telem,
                             const Proto::Outputs &out,
                             uint32_t now_ms)
 {
-    Proto::PayloadTelemetryV1 p;
+    const SetpointProgram::Status prog = program_ ? program_->status() : SetpointProgram::Status{};
+    const bool synced = clock_synced_ && (now_ms - clock_rx_ms_) < BoardConfig::TIME_SYNC_STALE_MS;
+
+    // 只发 V3（V1/V2 布局冻结，不再追加字段）
+    Proto::PayloadTelemetryV3 p;
     p.timestamp_ms = now_ms;
 
-    const uint8_t nT = (telem.temp_count > 4) ? 4 : telem.temp_count;
+    const uint8_t kCap = sizeof(p.temp_c) / sizeof(p.temp_c[0]);
+    const uint8_t nT = (telem.temp_count > kCap) ? kCap : telem.temp_count;
     p.temp_count = nT;
-    for (uint8_t i = 0; i < 4; ++i) {
+    for (uint8_t i = 0; i < kCap; ++i) {
         p.temp_c[i] = (i < nT) ? telem.temp_c[i] : 0.0f;
     }
 
@@ -137,12 +702,82 @@ void UartLink::sendTelemetry(const Proto::Telemetry &telem,
     p.heater_power_pct  = out.heater_power_pct;
     p.valve_opening_pct = out.valve_opening_pct;
 
-    uint8_t buf[256];
-    const size_t n = FrameCodec::encode(Proto::MSG_TELEM_V1, tx_seq_++,
-                                        reinterpret_cast<uint8_t*>(&p),
-                                        static_cast<uint8_t>(sizeof(p)),
-                                        buf, sizeof(buf));
-    if (n) {
-        serial_.write(buf, n);
+    p.prog_state          = prog.state;
+    p.prog_segment        = prog.segment;
+    p.prog_seg_elapsed_ms = prog.seg_elapsed_ms;
+    p.sp_temp_c           = prog.sp_temp_c;
+    p.sp_pressure_pa      = prog.sp_pressure_pa;
+
+    p.clock_offset_ms = synced ? clock_offset_ms_ : 0;
+    p.clock_synced    = synced ? 1 : 0;
+
+    queueFrame(TxClass::TELEM, Proto::MSG_TELEM_V3, tx_seq_++, &p, sizeof(p));
+}
+
+void UartLink::sendDiagnostics(const Proto::Diagnostics &diag, uint32_t now_ms)
+{
+    Proto::PayloadTelemDiagV1 p;
+    p.timestamp_ms = now_ms;
+
+    p.ctrl_period_us     = diag.ctrl_period_us;
+    p.ctrl_ticks         = diag.ctrl_ticks;
+    p.ctrl_overruns      = diag.ctrl_overruns;
+    p.ctrl_jitter_max_us = sat16(diag.ctrl_jitter_max_us);
+    p.ctrl_jitter_avg_us = sat16(diag.ctrl_jitter_avg_us);
+    p.ctrl_exec_max_us   = sat16(diag.ctrl_exec_max_us);
+    p.valve_cmd_cpct     = pctToCpct(diag.valve_cmd_pct);
+    p.valve_duty_cpct    = pctToCpct(diag.valve_duty_pct);
+    p.safety_active        = diag.safety_active_mask;
+    p.safety_last_trip     = diag.safety_last_trip;
+    p.safety_trips         = sat16(diag.safety_trips);
+    p.safety_react_last_us = sat16(diag.safety_react_last_us);
+    p.safety_react_max_us  = sat16(diag.safety_react_max_us);
+    p.uart_txq_bytes        = sat16(diag.uart_txq_bytes);
+    p.uart_txq_max          = sat16(diag.uart_txq_max);
+    p.uart_tx_drops         = sat16(diag.uart_tx_drops);
+    p.uart_telem_overwrites = sat16(diag.uart_telem_overwrites);
+    p.uart_diag_overwrites  = sat16(diag.uart_diag_overwrites);
+
+    queueFrame(TxClass::DIAG, Proto::MSG_TELEM_DIAG_V1, tx_seq_++, &p, sizeof(p));
+}
+
+void UartLink::sendAutotuneResult(const RelayAutotuner::Result &res)
+{
+    Proto::PayloadAutotuneResultV1 p;
+    switch (res.status) {
+    case RelayAutotuner::Status::DONE:          p.status = Proto::TUNE_DONE; break;
+    case RelayAutotuner::Status::ABORT_LIMIT:   p.status = Proto::TUNE_ABORT_LIMIT; break;
+    case RelayAutotuner::Status::ABORT_SENSOR:  p.status = Proto::TUNE_ABORT_SENSOR; break;
+    case RelayAutotuner::Status::ABORT_TIMEOUT: p.status = Proto::TUNE_ABORT_TIMEOUT; break;
+    case RelayAutotuner::Status::REJECTED:      p.status = Proto::TUNE_REJECTED; break;
+    default:                                    p.status = Proto::TUNE_ABORT_EXTERNAL; break;
     }
+    p.cycles      = res.cycles;
+    p.amplitude_c = res.amplitude_c;
+    p.ku          = res.ku;
+    p.tu_s        = res.tu_s;
+    p.kp          = res.kp;
+    p.ki          = res.ki;
+    p.kd          = res.kd;
+
+    queueFrame(TxClass::URGENT, Proto::MSG_AUTOTUNE_RESULT, tx_seq_++, &p, sizeof(p));
+}
+
+#if CTRL_PROFILE
+void UartLink::sendProfile(const StageProfiler::StageStats stats[StageProfiler::STAGE_COUNT], uint32_t now_ms)
+{
+    Proto::PayloadProfileV1 p;
+    p.timestamp_ms = now_ms;
+    p.cycles_per_us = StageProfiler::cyclesPerUs();
+    p.stage_count = StageProfiler::STAGE_COUNT;
+    for (uint8_t i = 0; i < StageProfiler::STAGE_COUNT; ++i) {
+        p.stage[i].count    = sat16(stats[i].count);
+        p.stage[i].min_cyc  = stats[i].min_cyc;
+        p.stage[i].mean_cyc = stats[i].mean_cyc;
+        p.stage[i].p99_cyc  = stats[i].p99_cyc;
+        p.stage[i].max_cyc  = stats[i].max_cyc;
+    }
+
+    queueFrame(TxClass::PROFILE, Proto::MSG_PROFILE_V1, tx_seq_++, &p, sizeof(p));
 }
+#endif
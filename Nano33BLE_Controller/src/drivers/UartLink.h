@@ -7,11 +7,39 @@
 #include "../proto/Protocol.h"
 #include "../proto/Messages.h"
 #include "../ctrl/ControlState.h"
+#include "../ctrl/RelayAutotuner.h"
+#include "../ctrl/SetpointProgram.h"
+#include "../util/CaptureBuffer.h"
+#include "../util/BoardConfig.h"
+#include "../util/ConfigStore.h"
+#include "../util/DaqRegistry.h"
+#include "../util/Metrics.h"
+#include "../util/StageProfiler.h"
 
 // UartLink：
 // - 负责 Serial1 的帧收发
 // - poll() 内部解析帧并更新 ControlState
 // - sendTelemetry() 周期发送遥测
+// - sendDiagnostics() 低频发送诊断遥测
+// - 高速捕获命令（MSG_CAPTURE_CMD）在 poll() 中直接应答：状态帧或记录分块（不回 ACK）
+// - 设定值程序上传/控制（MSG_PROGRAM_V1 / MSG_PROGRAM_CTRL）交给 SetpointProgram，回 ACK；
+//   遥测帧附带程序进度与当前生效设定值
+// - 配置参数读写（MSG_CONFIG_CMD）交给 ConfigStore，以 MSG_CONFIG_VALUE 应答（不回 ACK）；
+//   写入 Flash（COMMIT）只在 SAFE 模式下执行
+// - 批量参数（MSG_PARAM_BATCH）：一帧读/暂存多项参数，COMMIT 整组生效、ROLLBACK 丢弃，
+//   以 MSG_PARAM_REPLY 应答（不回 ACK）；整组生效发生在主循环，下一个控制节拍同时用上
+// - 变量采集（MSG_DAQ_CMD）交给 DaqRegistry：START/STOP/STATUS 以 MSG_DAQ_STATUS 应答，
+//   CATALOG 以 MSG_DAQ_CATALOG 应答（均不回 ACK）；数据帧 MSG_DAQ_V1 由 sendDaq() 发送
+// - 时间同步（MSG_TIME_SYNC，空中端发起）：立即以 MSG_TIME_SYNC_REPLY 回送收/发时刻；
+//   请求中携带的时钟偏差估计随遥测上报，地面据此换算端到端延迟
+// - 命令时延追踪：被接受的模式/手动/设定值命令记下解析时刻，控制节拍执行输出后
+//   （noteActuation）由 poll() 以 MSG_CMD_TRACE 上报（两拍之间多条命令只追踪最后一条）
+// - 运行指标（MSG_METRICS_CMD，node = CTRL）：以 MSG_METRICS_V1 应答快照/目录分块（不回 ACK）
+// - 发送不阻塞：各 send*() 只把编码好的帧放入发送队列，由 poll() 按线路速率逐步写出
+//   - 高优先级（ACK / 自整定结果 / 捕获）：字节环形队列，满则丢弃并计数
+//   - 遥测、诊断（及启用剖析时的分段耗时）：各一个最新值槽位，积压时新帧覆盖旧帧（计数）
+//   - DAQ 数据帧：最新值槽位，只占用线路空闲（未发出即被覆盖时由地面按采样序号跳号识别）
+//   - 出队顺序 高优先级 > 遥测 > 诊断 > 分段耗时 > DAQ；已开始写出的帧总是先写完
 
 class UartLink {
 public:
@@ -25,11 +53,126 @@ public:
                       const Proto::Outputs &out,
                       uint32_t now_ms);
 
+    void sendDiagnostics(const Proto::Diagnostics &diag, uint32_t now_ms);
+
+    void sendAutotuneResult(const RelayAutotuner::Result &res);
+
+    // 控制节拍中执行器输出后调用：记录待追踪命令的生效时刻（只记录，不发送）
+    void noteActuation(uint32_t apply_ms)
+    {
+        if (trace_.pending && !trace_.applied) {
+            trace_.apply_ms = apply_ms;
+            trace_.applied = true;
+        }
+    }
+
+    // 高速捕获（可为空：不响应捕获命令）
+    void attachCapture(CaptureBuffer *cap) { capture_ = cap; }
+    void sendCaptureInfo();
+
+    // 设定值程序（可为空：拒绝程序命令，遥测中进度为 EMPTY）
+    void attachProgram(SetpointProgram *prog) { program_ = prog; }
+
+    // 配置存储（可为空：配置命令回 CONFIG_ERR_STATE）
+    void attachConfig(ConfigStore *cfg) { config_ = cfg; }
+
+    // 变量采集（可为空：DAQ 命令回 DAQ_ERR_OP）
+    void attachDaq(DaqRegistry *daq) { daq_ = daq; }
+    void sendDaq(const uint8_t *payload, uint8_t len);
+
+#if CTRL_PROFILE
+    // 分段耗时（MSG_PROFILE_V1，可选诊断消息）
+    void sendProfile(const StageProfiler::StageStats stats[StageProfiler::STAGE_COUNT], uint32_t now_ms);
+#endif
+
+    struct TxStats {
+        uint32_t queued_bytes;      // 当前待发字节（含正在写出的帧）
+        uint32_t queued_max;        // 自上次读取以来的最大待发字节
+        uint32_t hi_drops;          // 高优先级队列满被丢弃的帧
+        uint32_t telem_overwrites;  // 未发出即被新遥测覆盖的帧
+        uint32_t diag_overwrites;   // 未发出即被新诊断覆盖的帧
+    };
+
+    // 读取发送统计；queued_max 随之清零（重新统计下一个窗口）
+    TxStats takeTxStats();
+
+    // 实时读取（不清零，供运行指标快照）；queuedMax 为当前窗口内的最大待发字节
+    uint32_t txDrops() const { return hi_drops_; }
+    uint32_t telemOverwrites() const { return telem_overwrites_; }
+    uint32_t queuedMax() const { return queued_max_; }
+
 private:
+    enum class TxClass : uint8_t { URGENT, TELEM, DIAG, PROFILE, DAQ };
+
+    static constexpr size_t MAX_FRAME = FrameCodec::MAX_PAYLOAD + 7;
+
+    struct TxSlot {
+        uint8_t buf[MAX_FRAME];
+        uint8_t len;
+    };
+
     HardwareSerial &serial_;
     FrameCodec::Parser parser_;
     uint8_t tx_seq_{0};
+    CaptureBuffer *capture_{nullptr};
+    SetpointProgram *program_{nullptr};
+    ConfigStore *config_{nullptr};
+    DaqRegistry *daq_{nullptr};
+
+    // 空中端估计的“本机时钟 − 空中端时钟”（随遥测上报）
+    int32_t  clock_offset_ms_{0};
+    bool     clock_synced_{false};
+    uint32_t clock_rx_ms_{0};
+
+    // 命令时延追踪
+    struct CmdTrace {
+        bool     pending;
+        bool     applied;
+        uint8_t  msg_type;
+        uint8_t  seq;
+        uint32_t parse_ms;
+        uint32_t apply_ms;
+    };
+    CmdTrace trace_{false, false, 0, 0, 0, 0};
+
+    // 发送队列
+    uint8_t  hi_ring_[BoardConfig::UART_TX_RING_BYTES];
+    uint16_t hi_head_{0};
+    uint16_t hi_used_{0};
+    TxSlot   telem_slot_{{0}, 0};
+    TxSlot   diag_slot_{{0}, 0};
+#if CTRL_PROFILE
+    TxSlot   prof_slot_{{0}, 0};
+#endif
+    TxSlot   daq_slot_{{0}, 0};
+    uint8_t  cur_[MAX_FRAME];
+    uint8_t  cur_len_{0};
+    uint8_t  cur_off_{0};
+
+    // 线路速率令牌桶（单位：字节 × 1e6）
+    uint32_t bytes_per_s_{0};
+    uint32_t tx_credit_{0};
+    uint32_t tx_last_us_{0};
+
+    uint32_t queued_max_{0};
+    uint32_t hi_drops_{0};
+    uint32_t telem_overwrites_{0};
+    uint32_t diag_overwrites_{0};
 
     void handleFrame(const FrameCodec::FrameView &f, ControlState &state, uint32_t now_ms);
     void sendAck(uint8_t acked_msg_type, uint8_t seq, uint8_t status);
+    void handleCaptureCmd(const Proto::PayloadCaptureCmd &p, uint32_t now_ms);
+    void sendCaptureChunk(uint16_t index);
+    void handleDaqCmd(const FrameCodec::FrameView &f);
+    void handleConfigCmd(const Proto::PayloadConfigCmd &p, uint8_t seq, const ControlState &state);
+    void handleParamBatch(const FrameCodec::FrameView &f);
+    void handleTimeSync(const FrameCodec::FrameView &f);
+    void handleMetricsCmd(const FrameCodec::FrameView &f);
+    void traceCommand(const FrameCodec::FrameView &f, uint32_t parse_ms);
+    void serviceCmdTrace();
+
+    void queueFrame(TxClass cls, uint8_t msg_type, uint8_t seq, const void *payload, size_t len);
+    bool loadNextFrame();
+    void serviceTx();
+    uint32_t queuedBytes() const;
 };
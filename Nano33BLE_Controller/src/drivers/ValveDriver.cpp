@@ -14,34 +14,122 @@ void ValveDriver::begin()
 {
     pinMode(pin_, OUTPUT);
     digitalWrite(pin_, LOW);
+    level_ = false;
+    on_us_ = 0;
+    cyc_on_us_ = 0;
+    cyc_valid_ = false;
+    win_on_us_ = 0;
+    win_cycle_us_ = 0;
+    win_cycles_ = 0;
     cycle_start_ms_ = millis();
+
+#if defined(ARDUINO_ARCH_MBED)
+    cycle_ticker_.attach(mbed::callback(this, &ValveDriver::onCycleStart),
+                         std::chrono::microseconds(cycle_ms_ * 1000UL));
+#endif
 }
 
-void ValveDriver::setOpeningPct(float pct, uint32_t now_ms)
+void ValveDriver::setLevel(bool high, uint32_t now_us)
 {
-    pct = clampPct(pct);
-    last_pct_ = pct;
+    if (high) {
+        if (!level_) digitalWrite(pin_, HIGH);
+        level_ = true;
+        rise_us_ = now_us;
+    } else if (level_) {
+        digitalWrite(pin_, LOW);
+        level_ = false;
+        cyc_on_us_ = cyc_on_us_ + (now_us - rise_us_);
+    }
+}
 
-    const int ipct = static_cast<int>(pct + 0.5f);
+// 结算一个周期：高电平持续跨周期时在周期边界切分
+void ValveDriver::closeCycle(uint32_t now_us)
+{
+    if (level_) {
+        cyc_on_us_ = cyc_on_us_ + (now_us - rise_us_);
+        rise_us_ = now_us;
+    }
+    if (cyc_valid_) {
+        win_on_us_    = win_on_us_ + cyc_on_us_;
+        win_cycle_us_ = win_cycle_us_ + (now_us - cyc_start_us_);
+        win_cycles_   = win_cycles_ + 1;
+    }
+    cyc_on_us_ = 0;
+    cyc_start_us_ = now_us;
+    cyc_valid_ = true;
+}
 
-    if (ipct <= 0) {
-        digitalWrite(pin_, LOW);
+#if defined(ARDUINO_ARCH_MBED)
+void ValveDriver::onCycleStart()
+{
+    // 中断上下文：结算上一周期，按当前开通时长开阀并排定关断沿
+    const uint32_t now = micros();
+    closeCycle(now);
+
+    const uint32_t on = on_us_;
+    if (on == 0) {
+        setLevel(false, now);
         return;
     }
-    if (ipct >= 100) {
-        digitalWrite(pin_, HIGH);
-        return;
+    setLevel(true, now);
+    if (on < cycle_ms_ * 1000UL) {
+        off_timeout_.attach(mbed::callback(this, &ValveDriver::onOff),
+                            std::chrono::microseconds(on));
     }
+}
+
+void ValveDriver::onOff()
+{
+    setLevel(false, micros());
+}
+#endif
+
+void ValveDriver::setOpeningPct(float pct, uint32_t now_ms)
+{
+    pct = clampPct(pct);
+    last_pct_ = pct;
 
+    const uint32_t cycle_us = cycle_ms_ * 1000UL;
+    const uint32_t on_us = static_cast<uint32_t>(pct * 0.01f * static_cast<float>(cycle_us) + 0.5f);
+
+#if defined(ARDUINO_ARCH_MBED)
+    (void)now_ms;
+    on_us_ = on_us;
+    if (on_us == 0 && level_) {
+        // 关阀立即生效（安全退化不等到下一周期）
+        noInterrupts();
+        off_timeout_.detach();
+        setLevel(false, micros());
+        interrupts();
+    }
+#else
     // 对齐周期起点，避免 millis 溢出导致误差累积
     const uint32_t elapsed = static_cast<uint32_t>(now_ms - cycle_start_ms_);
     if (elapsed >= cycle_ms_) {
         const uint32_t cycles = elapsed / cycle_ms_;
         cycle_start_ms_ += cycles * cycle_ms_;
+        closeCycle(micros());
     }
 
-    const uint32_t phase  = static_cast<uint32_t>(now_ms - cycle_start_ms_);
-    const uint32_t on_ms  = (cycle_ms_ * static_cast<uint32_t>(ipct)) / 100UL;
+    on_us_ = on_us;
+    const uint32_t phase_us = static_cast<uint32_t>(now_ms - cycle_start_ms_) * 1000UL;
+    setLevel(on_us > phase_us, micros());
+#endif
+}
+
+ValveDriver::DutyStats ValveDriver::takeDutyStats()
+{
+    noInterrupts();
+    const uint32_t on = win_on_us_;
+    const uint32_t total = win_cycle_us_;
+    const uint32_t cycles = win_cycles_;
+    win_on_us_ = 0;
+    win_cycle_us_ = 0;
+    win_cycles_ = 0;
+    interrupts();
 
-    digitalWrite(pin_, (phase < on_ms) ? HIGH : LOW);
+    DutyStats s;
+    s.cycles = cycles;
+    s.duty_pct = (total > 0) ? (100.0f * static_cast<float>(on) / static_cast<float>(total)) : 0.0f;
+    return s;
 }
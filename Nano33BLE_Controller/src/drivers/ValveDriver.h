@@ -3,12 +3,25 @@
 
 #include <Arduino.h>
 
+#if defined(ARDUINO_ARCH_MBED)
+#include <mbed.h>
+#endif
+
 // 电磁阀时间比例控制（Time-Proportioning Control, TPC）
 // - 周期 cycle_ms
 // - pct=0/100 时强制关/开
+// - Nano 33 BLE (mbed)：周期起点由 mbed::Ticker 产生，关断沿由 mbed::Timeout 在开通时长后触发，
+//   开关沿与主循环速率无关；主循环只更新开通时长（下一周期生效），pct=0 立即关断。
+// - 其他平台：退化为 millis() 相位比较（保持相同接口）。
+// - 实测占空比：在实际开关沿打时间戳累计开通时间，只统计完整周期。
 
 class ValveDriver {
 public:
+    struct DutyStats {
+        float    duty_pct = 0.0f;   // 窗口内完整周期的实测占空比
+        uint32_t cycles   = 0;      // 窗口内完整周期数
+    };
+
     ValveDriver(uint8_t pin = 3, uint32_t cycle_ms = 500)
         : pin_(pin), cycle_ms_(cycle_ms) {}
 
@@ -19,9 +32,35 @@ public:
 
     float lastOpeningPct() const { return last_pct_; }
 
+    // 读取实测占空比并清零窗口
+    DutyStats takeDutyStats();
+
 private:
     uint8_t pin_;
     uint32_t cycle_ms_;
     uint32_t cycle_start_ms_{0};
     float last_pct_{0.0f};
+
+    // 开通时长（us）：主循环写，周期起点读
+    volatile uint32_t on_us_{0};
+
+    // 实测：当前电平、上升沿时刻、本周期已累计开通时间、窗口累计
+    volatile bool     level_{false};
+    volatile uint32_t rise_us_{0};
+    volatile uint32_t cyc_on_us_{0};
+    volatile uint32_t cyc_start_us_{0};
+    volatile bool     cyc_valid_{false};
+    volatile uint32_t win_on_us_{0};
+    volatile uint32_t win_cycle_us_{0};
+    volatile uint32_t win_cycles_{0};
+
+    void setLevel(bool high, uint32_t now_us);
+    void closeCycle(uint32_t now_us);
+
+#if defined(ARDUINO_ARCH_MBED)
+    mbed::Ticker  cycle_ticker_;
+    mbed::Timeout off_timeout_;
+    void onCycleStart();
+    void onOff();
+#endif
 };
@@ -1,13 +1,8 @@
 // hw/Actuators.cpp
 #include "Actuators.h"
 
-#include "../util/BoardConfig.h"
-
 void Actuators::begin()
 {
-    heater_ = HeaterDriver(BoardConfig::HEATER_PIN);
-    valve_  = ValveDriver(BoardConfig::VALVE_PIN, BoardConfig::VALVE_CYCLE_MS);
-
     heater_.begin();
     valve_.begin();
 }
@@ -17,3 +12,14 @@ void Actuators::apply(const Proto::Outputs &out, uint32_t now_ms)
     heater_.setPowerPct(out.heater_power_pct);
     valve_.setOpeningPct(out.valve_opening_pct, now_ms);
 }
+
+void Actuators::forceOff()
+{
+    heater_.forceOff();
+    valve_.setOpeningPct(0.0f, millis());
+}
+
+ValveDriver::DutyStats Actuators::takeValveDutyStats()
+{
+    return valve_.takeDutyStats();
+}
@@ -6,6 +6,7 @@
 #include "../proto/Messages.h"
 #include "../drivers/HeaterDriver.h"
 #include "../drivers/ValveDriver.h"
+#include "../util/BoardConfig.h"
 
 class Actuators {
 public:
@@ -14,7 +15,18 @@ public:
     // 根据 outputs 输出到硬件
     void apply(const Proto::Outputs &out, uint32_t now_ms);
 
+    // 安全联锁：加热/阀门立即关断（不等下一控制节拍）
+    void forceOff();
+
+    // 实际生效的输出（经驱动钳位后）
+    float heaterPct() const { return heater_.lastPowerPct(); }
+    float valvePct() const { return valve_.lastOpeningPct(); }
+
+    // 阀门实测占空比（读取后清零窗口）
+    ValveDriver::DutyStats takeValveDutyStats();
+
 private:
-    HeaterDriver heater_;
-    ValveDriver  valve_;
+    // 阀门驱动持有 mbed 定时器（不可拷贝），就地构造
+    HeaterDriver heater_{BoardConfig::HEATER_PIN, BoardConfig::HEATER_PWM_FREQ_HZ};
+    ValveDriver  valve_{BoardConfig::VALVE_PIN, BoardConfig::VALVE_CYCLE_MS};
 };
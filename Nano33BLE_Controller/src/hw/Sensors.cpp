@@ -5,32 +5,142 @@
 
 #include "../util/BoardConfig.h"
 
+bool Sensors::PollTask::due(uint32_t now)
+{
+    if (period == 0) return false;
+    if (static_cast<int32_t>(now - next_due) < 0) return false;
+
+    // 保持相位：按周期推进；若落后多个周期（例如长时间阻塞），直接跳到下一个未来时刻
+    next_due += period;
+    if (static_cast<int32_t>(now - next_due) >= 0) {
+        const uint32_t behind = now - next_due;
+        next_due += (behind / period + 1) * period;
+    }
+    return true;
+}
+
 void Sensors::begin()
 {
     SPI.begin();
 
-    // 2 路 PT100（可扩展至 4 路）
-    for (uint8_t i = 0; i < BoardConfig::TEMP_SENSOR_COUNT; ++i) {
+    // PT100：通道数见 BoardConfig::TEMP_SENSOR_COUNT（最多 8 路）
+    for (uint8_t i = 0; i < kTempCount; ++i) {
         pt100_[i].configure(BoardConfig::PT100_CS_PINS[i],
-                            BoardConfig::PT100_R0,
-                            BoardConfig::PT100_RREF,
-                            BoardConfig::PT100_A,
-                            BoardConfig::PT100_B);
+                            BoardConfig::RTD_R0[i],
+                            BoardConfig::RTD_RREF[i]);
         pt100_[i].begin();
     }
+    // 首次读取等一个转换周期；之后每个时隙读一个通道
+    const uint32_t slot_us = BoardConfig::PT100_POLL_PERIOD_MS * 1000UL / kTempCount;
+    temp_task_.start(micros(), slot_us, BoardConfig::PT100_POLL_PERIOD_MS * 1000UL);
+    temp_next_ch_ = 0;
 
     ads1115_ = Ads1115Driver(BoardConfig::ADS1115_ADDR);
-    ads1115_.begin();
+    ads1115_.begin(BoardConfig::I2C_CLOCK_HZ);
+
+    // 连续转换模式：主循环只读取最新结果，不再写配置 + delay 等待
+    startPressureConversion();
 }
 
-float Sensors::readPressurePa()
+void Sensors::startPressureConversion()
 {
-    // ADS1115 AIN0-AIN1 差分读数（±0.256V）。
-    const int16_t raw = ads1115_.readDiff01(BoardConfig::ADS1115_CONFIG_DIFF_0_1, 10);
-    if (!ads1115_.lastOk()) {
-        return NAN;
+    ads1115_.startContinuous(BoardConfig::ADS1115_CONFIG_DIFF_0_1_CONT);
+    ads_running_ = ads1115_.lastOk();
+    press_filt_.reset();
+    // 首个转换结果在一个转换周期后才有效
+    press_task_.start(micros(), BoardConfig::ADS1115_CONV_PERIOD_US, BoardConfig::ADS1115_CONV_PERIOD_US);
+}
+
+void Sensors::poll(uint32_t now_ms)
+{
+    // 轮转：本时隙读一个通道（落后多个时隙时也只读一个，不在一次 poll() 中补读）
+    if (temp_task_.due(micros())) {
+        pollTemp(temp_next_ch_, now_ms);
+        if (++temp_next_ch_ >= kTempCount) temp_next_ch_ = 0;
     }
-    const float volts = static_cast<float>(raw) * BoardConfig::ADS1115_LSB_V; // V
+
+    if (!press_task_.due(micros())) return;
+
+    if (!ads_running_) {
+        // 模块掉线：按转换周期重试（写配置为阻塞 I2C 操作，不在每次 poll() 中重试）
+        startPressureConversion();
+        if (!ads_running_) {
+            pressure_.valid = false;
+            pressure_.value = NAN;
+            if (safety_) safety_->onPressureSample(NAN, 0, false, micros());
+        }
+        return;
+    }
+    pollPressure(now_ms);
+}
+
+uint32_t Sensors::takePressureSampleCount()
+{
+    const uint32_t n = press_sample_count_;
+    press_sample_count_ = 0;
+    return n;
+}
+
+void Sensors::pollTemp(uint8_t ch, uint32_t now_ms)
+{
+    Sample &s = temp_[ch];
+    float tc = NAN;
+    s.valid = pt100_[ch].readTemperatureC(tc);
+    s.value = s.valid ? tc : NAN;
+    s.t_ms = now_ms;
+    s.fresh = true;
+
+    if (safety_) safety_->onTempSample(ch, s.value, s.valid, micros());
+}
+
+void Sensors::pollPressure(uint32_t now_ms)
+{
+    int16_t raw = 0;
+    if (!ads1115_.readLatest(raw)) {
+        // I2C 异常：下次重新写配置（模块可能掉电复位回单次模式）
+        ads_running_ = false;
+        pressure_.valid = false;
+        pressure_.value = NAN;
+        if (safety_) safety_->onPressureSample(NAN, 0, false, micros());
+        return;
+    }
+
+    // 联锁按单个原始样本判定（不经抽取滤波，表决抑制单点尖峰）
+    if (safety_) safety_->onPressureSample(rawToPressurePa(raw), raw, true, micros());
+
+    press_filt_.push(raw);
+    press_last_raw_ = raw;
+    press_last_sample_ms_ = now_ms;
+    ++press_sample_count_;
+}
+
+void Sensors::publishPressure()
+{
+    // 抽取：每个控制节拍取一次滤波结果；本节拍内无新样本则保持上一值（fresh=false）
+    if (press_filt_.takePending() == 0 || !press_filt_.ready()) return;
+
+    const float raw_mean = static_cast<float>(press_filt_.sum()) / PressureFilter::window();
+    pressure_.value = rawToPressurePa(raw_mean);
+    pressure_.t_ms = press_last_sample_ms_;
+    pressure_.valid = true;
+    pressure_.fresh = true;
+}
+
+void Sensors::setPressureCal(float v0_mv, float sens_mv_per_kpa)
+{
+    press_v0_mv_ = v0_mv;
+    press_sens_mv_ = sens_mv_per_kpa;
+}
+
+void Sensors::setRtdRref(uint8_t ch, float rref_ohm)
+{
+    if (ch < kTempCount) pt100_[ch].setRref(rref_ohm);
+}
+
+float Sensors::rawToPressurePa(float raw) const
+{
+    // ADS1115 AIN0-AIN1 差分读数（±0.256V），raw 为滤波后的平均码值。
+    const float volts = raw * BoardConfig::ADS1115_LSB_V; // V
     float mv = volts * 1000.0f;
 
     // 与旧版 Sensors.cpp 处理方式保持一致：
@@ -38,7 +148,7 @@ float Sensors::readPressurePa()
     // - 标定后若出现负压，钳位到 0
     if (mv < 0.0f) mv = -mv;
 
-    float kPa = (mv - BoardConfig::PRESS_V0_mV) / BoardConfig::PRESS_SENS_mV_PER_kPa;
+    float kPa = (mv - press_v0_mv_) / press_sens_mv_;
     if (kPa < 0.0f) kPa = 0.0f;
 
     return kPa * 1000.0f;
@@ -47,15 +157,25 @@ float Sensors::readPressurePa()
 void Sensors::readAll(Proto::Telemetry &telem)
 {
     telem.timestamp_ms = millis();
+    poll(telem.timestamp_ms);
+    publishPressure();
 
-    telem.temp_count = BoardConfig::TEMP_SENSOR_COUNT;
+    telem.temp_count = kTempCount;
+    telem.temp_fresh_mask = 0;
     for (uint8_t i = 0; i < telem.temp_count; ++i) {
-        float tc = NAN;
-        if (!pt100_[i].readTemperatureC(tc)) {
-            tc = NAN;
-        }
-        telem.temp_c[i] = tc;
+        Sample &s = temp_[i];
+        telem.temp_c[i] = s.valid ? s.value : NAN;
+        telem.temp_sample_ms[i] = s.t_ms;
+        if (s.fresh) telem.temp_fresh_mask |= static_cast<uint8_t>(1u << i);
+        s.fresh = false;
     }
 
-    telem.pressure_pa = readPressurePa();
+    telem.env_temp_c = (BoardConfig::AMBIENT_TEMP_CHANNEL < telem.temp_count)
+                           ? telem.temp_c[BoardConfig::AMBIENT_TEMP_CHANNEL]
+                           : NAN;
+
+    telem.pressure_pa = pressure_.valid ? pressure_.value : NAN;
+    telem.pressure_sample_ms = pressure_.t_ms;
+    telem.pressure_fresh = pressure_.fresh;
+    pressure_.fresh = false;
 }
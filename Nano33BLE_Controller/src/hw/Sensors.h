@@ -6,16 +6,95 @@
 #include "../proto/Messages.h"
 #include "../drivers/Max31865Driver.h"
 #include "../drivers/Ads1115Driver.h"
+#include "../util/BoardConfig.h"
+#include "../util/DecimatingFilter.h"
+#include "../util/SafetyManager.h"
+
+// Sensors：
+// - 各传感器按自身的更新率轮询，避免每轮 loop 都去总线上读一次“尚未更新”的数据。
+// - PT100：各 MAX31865 连续转换（约 20ms），读取在通道间轮转，时隙 = 20ms / 通道数，
+//   每次 poll() 至多读一个通道；通道数（BoardConfig::TEMP_SENSOR_COUNT，≤8）增加只缩短时隙。
+// - 压力：ADS1115 以 860SPS 连续转换，poll() 按转换周期（micros）读取每个样本送入定点
+//   中值 + 滑动平均滤波；readAll() 在控制节拍取一次滤波结果（抽取到控制频率）。
+//   poll() 需在节拍间隙的后台循环中调用，以跟上采样率。
+// - 每个读数带采样时间戳与 fresh 标记（自上次 readAll() 以来是否有新样本）。
+// - 每个原始样本（PT100 单通道读数、ADS1115 单次转换）同时送入 SafetyManager 快速联锁。
 
 class Sensors {
 public:
+    // 最近一次采样（附采样时间戳）
+    struct Sample {
+        float    value = NAN;
+        uint32_t t_ms  = 0;      // 取得该样本的 millis()
+        bool     valid = false;
+        bool     fresh = false;  // 自上次 readAll() 以来更新过
+    };
+
     void begin();
 
+    // 现场标定（ConfigStore）：压力零点/灵敏度、各通道 PT100 参考电阻；未调用时为 BoardConfig 缺省值
+    void setPressureCal(float v0_mv, float sens_mv_per_kpa);
+    void setRtdRref(uint8_t ch, float rref_ohm);
+
+    // 样本级安全联锁（可为空）
+    void attachSafety(SafetyManager *safety) { safety_ = safety; }
+
+    // 轮询到期的采集任务（不阻塞等待转换）
+    void poll(uint32_t now_ms);
+
+    // 最近一个统计窗口内送入压力滤波的样本数（诊断用，读后清零）
+    uint32_t takePressureSampleCount();
+
+    // poll() 后把最新样本写入遥测，并清除 fresh 标记
     void readAll(Proto::Telemetry &telem);
 
+    // 原始码值（观测用）：各通道最近一次有效 RTD 码、ADS1115 最近一个转换结果
+    uint16_t lastRtdCode(uint8_t ch) const { return (ch < kTempCount) ? pt100_[ch].lastCode() : 0; }
+    int16_t  lastPressureRaw() const { return press_last_raw_; }
+
+    const Sample &latestPressure() const { return pressure_; }
+    const Sample &latestTemp(uint8_t ch) const { return temp_[ch < kTempCount ? ch : 0]; }
+
 private:
-    Max31865Driver pt100_[4];
+    // 固定周期 + 相位的轮询任务（时间单位由调用方决定，目前 PT100 轮转时隙与 ADS1115 均用 us）
+    struct PollTask {
+        uint32_t period   = 0;
+        uint32_t next_due = 0;
+
+        void start(uint32_t now, uint32_t period_, uint32_t phase) {
+            period = period_;
+            next_due = now + phase;
+        }
+        bool due(uint32_t now);
+    };
+
+    using PressureFilter = Median3BoxcarFilter<BoardConfig::PRESS_FILTER_LEN>;
+
+    static constexpr uint8_t kTempCount = BoardConfig::TEMP_SENSOR_COUNT;
+
+    Max31865Driver pt100_[kTempCount];
     Ads1115Driver ads1115_;
 
-    float readPressurePa();
+    PollTask temp_task_;         // 轮转时隙（us）
+    uint8_t  temp_next_ch_ = 0;
+    PollTask press_task_;
+
+    Sample temp_[kTempCount];
+    Sample pressure_;
+    PressureFilter press_filt_;
+    uint32_t press_last_sample_ms_ = 0;
+    uint32_t press_sample_count_ = 0;
+    int16_t  press_last_raw_ = 0;
+    bool ads_running_ = false;   // 连续转换是否已启动（I2C 故障后需重新写配置）
+
+    SafetyManager *safety_ = nullptr;
+
+    float press_v0_mv_   = BoardConfig::PRESS_V0_mV;
+    float press_sens_mv_ = BoardConfig::PRESS_SENS_mV_PER_kPa;
+
+    void pollTemp(uint8_t ch, uint32_t now_ms);
+    void pollPressure(uint32_t now_ms);
+    void publishPressure();
+    void startPressureConversion();
+    float rawToPressurePa(float raw) const;
 };
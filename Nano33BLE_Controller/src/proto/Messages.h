@@ -15,9 +15,13 @@ struct Telemetry {
     // 温度传感器
     float    temp_c[kMaxTempSensors] = {0};  // 摄氏度
     uint8_t  temp_count = 0;                 // 实际有效通道数
+    uint32_t temp_sample_ms[kMaxTempSensors] = {0}; // 各通道采样时间戳
+    uint8_t  temp_fresh_mask = 0;            // bit i=1：通道 i 自上次遥测以来有新样本
 
     // 压力
     float    pressure_pa = 0.0f;             // Pa
+    uint32_t pressure_sample_ms = 0;         // 压力采样时间戳
+    bool     pressure_fresh = false;         // 自上次遥测以来有新样本
 
     // 阀门与加热状态（当前状态，非指令）
     float    valve_opening_pct = 0.0f;       // 0~100%
@@ -35,6 +39,36 @@ struct Telemetry {
     uint32_t telem_seq         = 0;
 };
 
+// 诊断数据：控制器运行状态（低频上报，用于时序/性能评估）
+struct Diagnostics {
+    // 固定周期控制节拍
+    uint32_t ctrl_period_us     = 0;
+    uint32_t ctrl_ticks         = 0;
+    uint32_t ctrl_overruns      = 0;
+    uint32_t ctrl_jitter_max_us = 0;
+    uint32_t ctrl_jitter_avg_us = 0;
+    uint32_t ctrl_exec_max_us   = 0;
+
+    // 阀门时间比例输出：当前指令开度、上个窗口实测占空比
+    float    valve_cmd_pct      = 0.0f;
+    float    valve_duty_pct     = 0.0f;
+    uint32_t valve_cycles       = 0;
+
+    // 快速安全联锁（Proto::SAFETY_TRIP_* 位掩码）
+    uint8_t  safety_active_mask = 0;
+    uint8_t  safety_last_trip   = 0;
+    uint32_t safety_trips       = 0;
+    uint32_t safety_react_last_us = 0;
+    uint32_t safety_react_max_us  = 0;
+
+    // 串口发送队列（UartLink::TxStats）
+    uint32_t uart_txq_bytes        = 0;
+    uint32_t uart_txq_max          = 0;
+    uint32_t uart_tx_drops         = 0;
+    uint32_t uart_telem_overwrites = 0;
+    uint32_t uart_diag_overwrites  = 0;
+};
+
 // 控制输出：控制算法给执行器使用（只在控制板内部/机载 ESP32 显示用）
 struct Outputs {
     float heater_power_pct     = 0.0f;       // 加热功率 0~100%
@@ -9,23 +9,42 @@
 namespace BoardConfig {
 
 // ===== PT100 / MAX31865 (SPI) =====
-static constexpr uint8_t TEMP_SENSOR_MAX_COUNT = 4;
-static constexpr uint8_t TEMP_SENSOR_COUNT     = 2;  // 当前已接 2 路
+static constexpr uint8_t TEMP_SENSOR_MAX_COUNT = 8;  // 与 Proto::kMaxTempSensors 一致
+static constexpr uint8_t TEMP_SENSOR_COUNT     = 2;  // 当前已接 2 路（1..TEMP_SENSOR_MAX_COUNT）
+static_assert(TEMP_SENSOR_COUNT >= 1 && TEMP_SENSOR_COUNT <= TEMP_SENSOR_MAX_COUNT,
+              "TEMP_SENSOR_COUNT out of range");
 
-// MAX31865 的 CS 引脚；目前只使用前 TEMP_SENSOR_COUNT 项。
-// 备注：PT100 #1 = D10, PT100 #2 = D9 为当前硬件连接。
-// D8/D7 仅作为未来扩展占位。
-static constexpr uint8_t PT100_CS_PINS[TEMP_SENSOR_MAX_COUNT] = {10, 9, 8, 7};
+// MAX31865 的 CS 引脚；只使用前 TEMP_SENSOR_COUNT 项。
+// 备注：PT100 #1 = D10, PT100 #2 = D9 为当前硬件连接；其余为扩展占位
+// （D2/D3 为执行器，A4/A5 为 I2C，14 = A0）。
+static constexpr uint8_t PT100_CS_PINS[TEMP_SENSOR_MAX_COUNT] = {10, 9, 8, 7, 6, 5, 4, 14};
 
-// 模块参考电阻 402 Ω（丝印“4020”）
-static constexpr float PT100_R0   = 100.0f;
-static constexpr float PT100_RREF = 402.0f;
+// 每通道 RTD 类型：R0 = 100 Ω（PT100）或 1000 Ω（PT1000）；RREF 为模块参考电阻
+// 当前模块参考电阻 402 Ω（丝印“4020”）；PT1000 模块一般为 4300 Ω
+static constexpr float RTD_R0[TEMP_SENSOR_MAX_COUNT]   = {100.0f, 100.0f, 100.0f, 100.0f,
+                                                          100.0f, 100.0f, 100.0f, 100.0f};
+static constexpr float RTD_RREF[TEMP_SENSOR_MAX_COUNT] = {402.0f, 402.0f, 402.0f, 402.0f,
+                                                          402.0f, 402.0f, 402.0f, 402.0f};
+// Callendar–Van Dusen 系数（IEC 60751），用于编译期生成换算表（util/RtdTable.h）
 static constexpr float PT100_A    = 3.9083e-3f;
 static constexpr float PT100_B    = -5.775e-7f;
+static constexpr float PT100_C    = -4.183e-12f;
+
+// MAX31865 连续转换 + 50Hz 滤波约 20ms 更新一次；各通道独立转换。
+// 读取按通道轮转：每 PT100_POLL_PERIOD_MS / TEMP_SENSOR_COUNT 读一个通道，
+// 每次 poll() 至多一次 SPI 事务，通道数增加不会拉长单次循环
+static constexpr uint32_t PT100_POLL_PERIOD_MS = 20;
 
 // ===== ADS1115 (I2C) =====
 static constexpr uint8_t  ADS1115_ADDR             = 0x48;
 static constexpr uint16_t ADS1115_CONFIG_DIFF_0_1  = 0x8B83; // 单次、差分AIN0-AIN1、±0.256V、128SPS
+static constexpr uint16_t ADS1115_CONFIG_DIFF_0_1_CONT = 0x0AE3; // 连续、差分AIN0-AIN1、±0.256V、860SPS
+// 860SPS 对应约 1.163ms 一次转换；后台按该周期（micros）读取最新结果送入抽取滤波。
+// ADS1115 内部振荡器有 ±10% 偏差，偶尔重复/漏读一个样本对滑动平均影响可忽略。
+static constexpr uint32_t ADS1115_CONV_PERIOD_US   = 1163;
+static constexpr uint32_t I2C_CLOCK_HZ             = 400000;  // Fast-mode：单次读取约 0.1ms
+// 压力抽取滤波：3 点中值 + PRESS_FILTER_LEN 点滑动平均（约 9.3ms ≈ 一个控制周期）
+static constexpr uint8_t  PRESS_FILTER_LEN         = 8;
 static constexpr float    ADS1115_LSB_V            = 0.256f / 32768.0f;
 
 // 压力传感器标定：0 kPa 时 2.73 mV，灵敏度 0.117 mV/kPa
@@ -34,12 +53,126 @@ static constexpr float PRESS_SENS_mV_PER_kPa  = 0.117f;
 
 // ===== 执行器 =====
 static constexpr uint8_t  HEATER_PIN       = 2;  // XY-GMOS 加热片 PWM
+// 加热 PWM 载波：nRF52840 PWM 外设 16 MHz 计数，1 kHz 时 16000 级（约 14 bit），
+// 再叠加 16 周期 sigma-delta 抖动；降到 500 Hz 可得 15 bit
+static constexpr uint32_t HEATER_PWM_FREQ_HZ = 1000;
 static constexpr uint8_t  VALVE_PIN        = 3;  // 电磁阀 时间比例控制
 static constexpr uint32_t VALVE_CYCLE_MS   = 500;
 
+// ===== 控制节拍 =====
+// 固定周期控制步：采集 -> 计算 -> 安全 -> 输出；通讯/调试在节拍间隙执行
+static constexpr uint32_t CONTROL_PERIOD_US     = 10000;  // 100 Hz
+
+// ===== 自动控制：温度环 PID（输出为加热功率 %）=====
+static constexpr uint8_t TEMP_CTRL_CHANNEL  = 0;       // 参与闭环的 PT100 通道
+static constexpr float   TEMP_PID_KP        = 8.0f;    // %/°C
+static constexpr float   TEMP_PID_KI        = 0.05f;   // %/(°C·s)
+static constexpr float   TEMP_PID_KD        = 20.0f;   // %·s/°C
+static constexpr float   TEMP_PID_D_TAU_S   = 2.0f;    // 微分低通时间常数
+
+// ===== 自动控制：压力环 =====
+// 串级（压力+温度同时启用）：压力 PID 输出内环温度设定（°C）
+// 内环温度闭环要数百秒才稳定，外环积分须远慢于它（Ti = Kp/Ki = 50 s），否则外环进入慢极限环
+static constexpr float   PRESS_CASCADE_KP   = 5.0e-4f; // °C/Pa
+static constexpr float   PRESS_CASCADE_KI   = 1.0e-5f; // °C/(Pa·s)
+static constexpr float   PRESS_CASCADE_KD   = 0.0f;    // °C·s/Pa
+static constexpr float   CASCADE_TEMP_SP_MIN_C = -60.0f; // 外环输出下限；上限为 target_temp_c
+// 单压力环：压力 PID 直接输出加热功率（%）
+static constexpr float   PRESS_PID_KP       = 5.0e-3f; // %/Pa
+static constexpr float   PRESS_PID_KI       = 5.0e-4f; // %/(Pa·s)
+static constexpr float   PRESS_PID_KD       = 0.0f;    // %·s/Pa
+static constexpr float   PRESS_PID_D_TAU_S  = 1.0f;
+
+// ===== 自动控制：加热前馈 =====
+// 环境散热补偿：heater += TEMP_FF_PCT_PER_C * max(0, T_sp - T_amb)
+static constexpr float   TEMP_FF_PCT_PER_C  = 0.5f;
+// 阀门排气补偿：heater += PRESS_FF_PCT_PER_VALVE_PCT * valve_pct（压力环启用时）
+static constexpr float   PRESS_FF_PCT_PER_VALVE_PCT = 0.3f;
+// 环境温度：AMBIENT_TEMP_CHANNEL 有效时取该 PT100 通道，否则使用默认值
+static constexpr uint8_t AMBIENT_TEMP_CHANNEL   = 0xFF;   // 0xFF = 未接环境温度传感器
+static constexpr float   AMBIENT_TEMP_DEFAULT_C = 20.0f;
+
+// ===== 自动控制：MPC（温度+压力同时启用时可替代串级 PID）=====
+// 同时决定加热与阀门：跟踪 target_temp_c / target_pressure_pa；enable_valve_ctrl 时
+// target_valve_opening_pct 作为阀门静息开度，否则静息开度为 0
+static constexpr bool     AUTO_USE_MPC        = false;  // 上电默认算法（false = 串级 PID）
+static constexpr uint8_t  MPC_HORIZON         = 20;     // 预测步数（RAM 约 8·(2N)² 字节）
+static constexpr uint16_t MPC_PERIOD_TICKS    = 200;    // 每 200 个控制节拍（2 s）求解一次
+static constexpr uint8_t  MPC_QP_ITERS        = 30;     // FISTA 固定迭代次数
+static constexpr float    MPC_DIST_ALPHA      = 0.2f;   // 扰动估计低通系数
+// 预测模型（需按实际储罐辨识；默认值与 sim/PlantModel 一致）
+static constexpr float    MPC_MODEL_HEAT_C_PER_S_PCT  = 2.5e-3f;  // 加热 1% 的升温速率
+static constexpr float    MPC_MODEL_LOSS_PER_S        = 2.5e-3f;  // 对环境散热 UA/C
+static constexpr float    MPC_MODEL_VENT_C_PER_S_PCT  = 3.0e-4f;  // 阀门 1% 排气带走热量（在 P_NOM 处）
+static constexpr float    MPC_MODEL_P_TAU_S           = 30.0f;
+static constexpr float    MPC_MODEL_DPDT_KPA_PER_C    = 2.0f;     // 平衡压力随温度斜率
+static constexpr float    MPC_MODEL_P_REF_KPA         = 20.0f;    // T_REF 时平衡压力
+static constexpr float    MPC_MODEL_T_REF_C           = 20.0f;
+static constexpr float    MPC_MODEL_VENT_KPA_PER_S_PCT = 3.0e-2f; // 阀门 1% 排气降压速率（在 P_NOM 处）
+// 代价权重
+static constexpr float    MPC_Q_TEMP          = 1.0f;    // 1/°C²
+static constexpr float    MPC_Q_PRESS         = 1.0f;    // 1/kPa²
+static constexpr float    MPC_R_DHEATER       = 1.0e-4f; // 1/%²
+static constexpr float    MPC_R_DVALVE        = 1.0e-4f;
+static constexpr float    MPC_R_VALVE_REST    = 1.0e-5f;
+
+// ===== 自整定（继电反馈，AUTOTUNE 模式）=====
+// 设定值取 setpoints.target_temp_c；加热在 BIAS±AMP 之间切换
+static constexpr float    TUNE_RELAY_BIAS_PCT = 30.0f;
+static constexpr float    TUNE_RELAY_AMP_PCT  = 30.0f;
+static constexpr float    TUNE_HYST_C         = 0.2f;
+static constexpr uint8_t  TUNE_CYCLES         = 3;          // 连续稳定周期数
+static constexpr uint32_t TUNE_TIMEOUT_MS     = 30UL * 60UL * 1000UL;
+static constexpr float    TUNE_TEMP_MARGIN_C  = 5.0f;       // 整定上限 = SAFETY_MAX_TEMP_C - 余量
+
+// ===== 安全 =====
+static constexpr float SAFETY_MAX_TEMP_C = 80.0f;   // 任一通道超过即强制 SAFE
+// 快速联锁（每个新样本判定，越限后立即关断输出，回滞解除后才允许重新进入控制模式）
+static constexpr float    SAFETY_TEMP_HYST_C          = 5.0f;
+static constexpr float    SAFETY_MAX_RATE_C_PER_S     = 1.0f;      // 温升速率上限
+static constexpr float    SAFETY_RATE_HYST_C_PER_S    = 0.5f;
+static constexpr uint32_t SAFETY_RATE_WINDOW_MS       = 1000;      // 速率基线（抑制测温噪声）
+static constexpr float    SAFETY_MAX_PRESS_PA         = 200000.0f; // 按储罐额定压力设置
+static constexpr float    SAFETY_PRESS_HYST_PA        = 10000.0f;
+// 表决：最近 N 个样本中 ≥K 个越限/故障才跳闸；解除需最近 N 个样本全部回到回滞阈值内
+static constexpr uint8_t  SAFETY_VOTE_N               = 4;
+static constexpr uint8_t  SAFETY_VOTE_K               = 3;
+// 卡死：读数完全不变超过该时长视为故障（测温仅在控制通道、且加热输出 ≥ 阈值时判定；
+// 测压按 ADS 原始码值判定，且仅在加热或阀门输出 ≥ 阈值时判定——换算后的 Pa 在零点以下被钳位为 0，
+// 管路通大气时恒为 0.0，不能用于卡死判定）
+static constexpr uint32_t SAFETY_TEMP_STUCK_MS        = 30000;
+static constexpr float    SAFETY_STUCK_MIN_HEATER_PCT = 20.0f;
+static constexpr uint32_t SAFETY_PRESS_STUCK_MS       = 2000;
+static constexpr float    SAFETY_STUCK_MIN_VALVE_PCT  = 5.0f;
+
+// ===== 高速捕获 =====
+// 每控制节拍记录一条定点记录（26 B，含全部 8 路温度）；触发后保留触发前 CAPTURE_PRE_RECORDS 条，再采集其余记录后冻结
+static constexpr uint16_t CAPTURE_RECORDS     = 1024;   // 100 Hz 下约 10 s，约 26 KB RAM
+static constexpr uint16_t CAPTURE_PRE_RECORDS = 512;
+
 // ===== 串口 / 链路 =====
 static constexpr uint32_t UART_BAUD             = 115200;
 static constexpr uint32_t TELEMETRY_PERIOD_MS   = 200;
+static constexpr uint32_t DIAG_PERIOD_MS        = 1000;  // 诊断遥测周期
 static constexpr uint32_t LINK_TIMEOUT_MS       = 1500;
+// 时间同步：空中端约每秒发起一次；超过该时长未收到则遥测中的时钟偏差标为无效
+static constexpr uint32_t TIME_SYNC_STALE_MS    = 5000;
+// 发送队列：高优先级帧（ACK 等）环形缓冲字节数；按 UART_BAUD 线路速率限速，每次轮询最多写出的字节数。
+// mbed 的 Serial1.write() 逐字节等待 UARTE，能立即收下的只有移位中的 1 字节 + 发送寄存器 1 字节；
+// 积攒的空闲额度若超过这个量，多出的每字节都会让主循环阻塞一个字节时间（115200 baud 约 87 us）
+static constexpr uint16_t UART_TX_RING_BYTES    = 512;
+static constexpr uint16_t UART_TX_BURST_BYTES   = 2;
+
+// ===== 配置存储（片内 Flash，见 util/ConfigStore.h）=====
+// 占用片内 Flash 末尾 CONFIG_FLASH_SECTORS 个扇区（nRF52840 每扇区 4 KB，程序区远小于 1 MB，不会重叠）。
+// 每次提交追加一条 CONFIG_SLOT_BYTES 的记录；4 扇区共 128 个槽位，每 32 次提交才擦除一个扇区，
+// 单扇区擦写寿命 10000 次对应约 128 万次提交
+static constexpr uint8_t  CONFIG_FLASH_SECTORS  = 4;
+static constexpr uint32_t CONFIG_SECTOR_BYTES   = 4096;
+static constexpr uint16_t CONFIG_SLOT_BYTES     = 128;
+// 现场可调的过温阈值上限（编译期 SAFETY_MAX_TEMP_C 为缺省值）
+static constexpr float    CONFIG_MAX_TEMP_CEIL_C = 120.0f;
+// 现场可调的超压阈值上限（储罐爆破片以下留足余量）
+static constexpr float    CONFIG_MAX_PRESS_CEIL_PA = 300000.0f;
 
 } // namespace BoardConfig
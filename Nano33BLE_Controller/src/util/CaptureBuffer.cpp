@@ -0,0 +1,132 @@
+// util/CaptureBuffer.cpp
+#include "CaptureBuffer.h"
+
+#include <math.h>
+
+static int16_t toCentiC(float c)
+{
+    if (!isfinite(c)) return INT16_MIN;
+    const float v = c * 100.0f;
+    if (v >= 32767.0f) return 32767;
+    if (v <= -32767.0f) return -32767;
+    return static_cast<int16_t>(lroundf(v));
+}
+
+static uint16_t toDecaPa(float pa)
+{
+    if (!isfinite(pa)) return 0xFFFFu;
+    if (pa <= 0.0f) return 0;
+    const float v = pa * 0.1f;
+    if (v >= 65534.0f) return 65534u;
+    return static_cast<uint16_t>(v + 0.5f);
+}
+
+static uint16_t toCentiPct(float pct)
+{
+    if (!(pct > 0.0f)) return 0;
+    if (pct >= 100.0f) return 10000;
+    return static_cast<uint16_t>(pct * 100.0f + 0.5f);
+}
+
+static uint8_t toProtoMode(ControlMode m)
+{
+    switch (m) {
+    case ControlMode::MANUAL:   return Proto::MODE_MANUAL;
+    case ControlMode::AUTO:     return Proto::MODE_AUTO;
+    case ControlMode::AUTOTUNE: return Proto::MODE_AUTOTUNE;
+    case ControlMode::SAFE:     break;
+    }
+    return Proto::MODE_SAFE;
+}
+
+void CaptureBuffer::begin(uint32_t period_us)
+{
+    period_us_ = period_us;
+    capture_id_ = 0;
+    arm();
+}
+
+void CaptureBuffer::arm()
+{
+    head_ = 0;
+    filled_ = 0;
+    post_left_ = 0;
+    pre_count_ = 0;
+    count_ = 0;
+    reason_ = Proto::CAPTURE_REASON_NONE;
+    trigger_ms_ = 0;
+    ready_event_ = false;
+    state_ = Proto::CAPTURE_ARMED;
+}
+
+void CaptureBuffer::push(const Proto::Telemetry &telem, ControlMode mode, uint8_t safety_mask)
+{
+    if (state_ == Proto::CAPTURE_READY) return;
+
+    Proto::CaptureRecordV1 &r = ring_[head_];
+    r.t_ms = static_cast<uint16_t>(telem.timestamp_ms);
+    for (uint8_t i = 0; i < sizeof(r.temp_cc) / sizeof(r.temp_cc[0]); ++i) {
+        r.temp_cc[i] = (i < telem.temp_count) ? toCentiC(telem.temp_c[i]) : INT16_MIN;
+    }
+    r.pressure_dapa = toDecaPa(telem.pressure_pa);
+    r.heater_cpct = toCentiPct(telem.heater_power_pct);
+    r.valve_cpct = toCentiPct(telem.valve_opening_pct);
+    r.mode = toProtoMode(mode);
+    r.safety = safety_mask;
+
+    if (++head_ >= kLen) head_ = 0;
+    if (filled_ < kLen) ++filled_;
+
+    if (state_ == Proto::CAPTURE_POST && --post_left_ == 0) {
+        count_ = static_cast<uint16_t>(pre_count_ + kPost);
+        if (count_ > filled_) count_ = filled_;
+        state_ = Proto::CAPTURE_READY;
+        ready_event_ = true;
+    }
+}
+
+bool CaptureBuffer::trigger(uint8_t reason, uint32_t now_ms)
+{
+    if (state_ != Proto::CAPTURE_ARMED) return false;
+
+    pre_count_ = (filled_ < kPre) ? filled_ : kPre;
+    post_left_ = kPost;
+    reason_ = reason;
+    trigger_ms_ = now_ms;
+    ++capture_id_;
+    state_ = Proto::CAPTURE_POST;
+    return true;
+}
+
+bool CaptureBuffer::takeReady()
+{
+    const bool r = ready_event_;
+    ready_event_ = false;
+    return r;
+}
+
+void CaptureBuffer::fillInfo(Proto::PayloadCaptureInfoV1 &info) const
+{
+    info.state = state_;
+    info.reason = reason_;
+    info.capture_id = capture_id_;
+    info.count = count();
+    info.pre_count = (state_ == Proto::CAPTURE_ARMED) ? 0 : pre_count_;
+    info.period_us = static_cast<uint16_t>(period_us_ > 0xFFFFu ? 0xFFFFu : period_us_);
+    info.record_size = static_cast<uint8_t>(sizeof(Proto::CaptureRecordV1));
+    info.trigger_ms = trigger_ms_;
+}
+
+uint8_t CaptureBuffer::read(uint16_t index, Proto::CaptureRecordV1 *out, uint8_t max) const
+{
+    if (state_ != Proto::CAPTURE_READY || index >= count_) return 0;
+
+    // 最早一条位于 head_ 之前 count_ 处
+    const uint16_t start = static_cast<uint16_t>((head_ + kLen - count_) % kLen);
+    uint8_t n = 0;
+    while (n < max && index + n < count_) {
+        out[n] = ring_[(start + index + n) % kLen];
+        ++n;
+    }
+    return n;
+}
@@ -0,0 +1,62 @@
+// util/CaptureBuffer.h
+#pragma once
+
+#include <Arduino.h>
+
+#include "../ctrl/ControlModes.h"
+#include "../proto/Messages.h"
+#include "../proto/Protocol.h"
+#include "BoardConfig.h"
+
+// CaptureBuffer：控制节拍级高速捕获（事故取证）
+// - ARMED：每节拍把采集值与实际输出压成定点记录（Proto::CaptureRecordV1）写入环形缓冲
+// - 触发（安全联锁跳闸 / 操作员命令）：保留触发前最多 CAPTURE_PRE_RECORDS 条，
+//   继续记录 CAPTURE_RECORDS - CAPTURE_PRE_RECORDS 条后冻结为 READY
+// - READY：停止记录，按记录序号（0 = 最早）分块读取；arm() 丢弃并重新开始记录
+// 全部静态内存；push()/trigger() 只在主循环上下文调用。
+
+class CaptureBuffer {
+public:
+    static constexpr uint16_t kLen  = BoardConfig::CAPTURE_RECORDS;
+    static constexpr uint16_t kPre  = BoardConfig::CAPTURE_PRE_RECORDS;
+    static constexpr uint16_t kPost = kLen - kPre;
+
+    static_assert(kPre < kLen, "pre-trigger window must leave room for post-trigger records");
+
+    void begin(uint32_t period_us);
+
+    // 控制节拍末尾调用：telem 中的执行器字段应为实际生效值
+    void push(const Proto::Telemetry &telem, ControlMode mode, uint8_t safety_mask);
+
+    // 非 ARMED 状态下忽略（保留第一次触发的现场），返回是否生效
+    bool trigger(uint8_t reason, uint32_t now_ms);
+
+    // 丢弃当前捕获并重新开始记录
+    void arm();
+
+    // 刚进入 READY 时返回一次 true（用于主动上报）
+    bool takeReady();
+
+    uint8_t  state() const { return state_; }
+    uint16_t count() const { return (state_ == Proto::CAPTURE_READY) ? count_ : 0; }
+
+    void fillInfo(Proto::PayloadCaptureInfoV1 &info) const;
+
+    // READY 时按序号复制至多 max 条，返回实际条数
+    uint8_t read(uint16_t index, Proto::CaptureRecordV1 *out, uint8_t max) const;
+
+private:
+    Proto::CaptureRecordV1 ring_[kLen];
+    uint16_t head_ = 0;         // 下一条写入位置
+    uint16_t filled_ = 0;       // 环内有效记录数
+    uint16_t post_left_ = 0;
+    uint16_t pre_count_ = 0;
+    uint16_t count_ = 0;
+
+    uint8_t  state_ = Proto::CAPTURE_ARMED;
+    uint8_t  reason_ = Proto::CAPTURE_REASON_NONE;
+    uint16_t capture_id_ = 0;
+    uint32_t trigger_ms_ = 0;
+    uint32_t period_us_ = 0;
+    bool     ready_event_ = false;
+};
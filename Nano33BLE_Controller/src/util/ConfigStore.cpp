@@ -0,0 +1,422 @@
+// util/ConfigStore.cpp
+#include "ConfigStore.h"
+
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "../proto/FrameCodec.h"
+
+namespace {
+
+// 参数表：id -> Data 内偏移 + 取值范围；整数参数在链路上同样以 float 传输
+struct ParamDef {
+    uint8_t offset;
+    bool    integer;
+    float   min_v;
+    float   max_v;
+};
+
+bool findParam(uint8_t id, ParamDef &def)
+{
+    using Data = ConfigStore::Data;
+    switch (id) {
+    case Proto::CFG_PRESS_V0_MV:
+        def = {offsetof(Data, press_v0_mv), false, -50.0f, 50.0f};
+        return true;
+    case Proto::CFG_PRESS_SENS_MV_KPA:
+        def = {offsetof(Data, press_sens_mv_per_kpa), false, 0.001f, 10.0f};
+        return true;
+    case Proto::CFG_SAFETY_MAX_TEMP_C:
+        def = {offsetof(Data, safety_max_temp_c), false, 0.0f, BoardConfig::CONFIG_MAX_TEMP_CEIL_C};
+        return true;
+    case Proto::CFG_TELEMETRY_PERIOD_MS:
+        def = {offsetof(Data, telemetry_period_ms), true, 20.0f, 10000.0f};
+        return true;
+    case Proto::CFG_DIAG_PERIOD_MS:
+        def = {offsetof(Data, diag_period_ms), true, 100.0f, 60000.0f};
+        return true;
+    case Proto::CFG_SAFETY_MAX_PRESS_PA:
+        def = {offsetof(Data, safety_max_press_pa), false, 20000.0f, BoardConfig::CONFIG_MAX_PRESS_CEIL_PA};
+        return true;
+    case Proto::CFG_SAFETY_MAX_RATE_C_S:
+        def = {offsetof(Data, safety_max_rate_c_per_s), false, 0.6f, 20.0f};
+        return true;
+    case Proto::CFG_TEMP_KP:
+        def = {offsetof(Data, temp_kp), false, 0.0f, 100.0f};
+        return true;
+    case Proto::CFG_TEMP_KI:
+        def = {offsetof(Data, temp_ki), false, 0.0f, 10.0f};
+        return true;
+    case Proto::CFG_TEMP_KD:
+        def = {offsetof(Data, temp_kd), false, 0.0f, 1000.0f};
+        return true;
+    case Proto::CFG_TEMP_D_TAU_S:
+        def = {offsetof(Data, temp_d_tau_s), false, 0.0f, 60.0f};
+        return true;
+    case Proto::CFG_CASCADE_KP:
+        def = {offsetof(Data, cascade_kp), false, 0.0f, 1.0f};
+        return true;
+    case Proto::CFG_CASCADE_KI:
+        def = {offsetof(Data, cascade_ki), false, 0.0f, 1.0f};
+        return true;
+    case Proto::CFG_PRESS_KP:
+        def = {offsetof(Data, press_kp), false, 0.0f, 1.0f};
+        return true;
+    case Proto::CFG_PRESS_KI:
+        def = {offsetof(Data, press_ki), false, 0.0f, 1.0f};
+        return true;
+    case Proto::CFG_PRESS_KD:
+        def = {offsetof(Data, press_kd), false, 0.0f, 10.0f};
+        return true;
+    default:
+        break;
+    }
+    if (id >= Proto::CFG_RTD_RREF_0 &&
+        id < Proto::CFG_RTD_RREF_0 + BoardConfig::TEMP_SENSOR_MAX_COUNT) {
+        const uint8_t ch = static_cast<uint8_t>(id - Proto::CFG_RTD_RREF_0);
+        def = {static_cast<uint8_t>(offsetof(Data, rtd_rref) + ch * sizeof(float)), false, 50.0f, 20000.0f};
+        return true;
+    }
+    return false;
+}
+
+float readParam(const ConfigStore::Data &d, const ParamDef &def)
+{
+    const uint8_t *p = reinterpret_cast<const uint8_t *>(&d) + def.offset;
+    if (def.integer) {
+        uint32_t v;
+        memcpy(&v, p, sizeof(v));
+        return static_cast<float>(v);
+    }
+    float v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+void writeParam(ConfigStore::Data &d, const ParamDef &def, float value)
+{
+    uint8_t *p = reinterpret_cast<uint8_t *>(&d) + def.offset;
+    if (def.integer) {
+        const uint32_t v = static_cast<uint32_t>(lroundf(value));
+        memcpy(p, &v, sizeof(v));
+    } else {
+        memcpy(p, &value, sizeof(value));
+    }
+}
+
+bool inRange(const ParamDef &def, float value)
+{
+    return isfinite(value) && value >= def.min_v && value <= def.max_v;
+}
+
+} // namespace
+
+ConfigStore::Data ConfigStore::defaults()
+{
+    Data d;
+    d.press_v0_mv           = BoardConfig::PRESS_V0_mV;
+    d.press_sens_mv_per_kpa = BoardConfig::PRESS_SENS_mV_PER_kPa;
+    d.safety_max_temp_c     = BoardConfig::SAFETY_MAX_TEMP_C;
+    d.telemetry_period_ms   = BoardConfig::TELEMETRY_PERIOD_MS;
+    d.diag_period_ms        = BoardConfig::DIAG_PERIOD_MS;
+    for (uint8_t i = 0; i < BoardConfig::TEMP_SENSOR_MAX_COUNT; ++i) {
+        d.rtd_rref[i] = BoardConfig::RTD_RREF[i];
+    }
+    d.safety_max_press_pa     = BoardConfig::SAFETY_MAX_PRESS_PA;
+    d.safety_max_rate_c_per_s = BoardConfig::SAFETY_MAX_RATE_C_PER_S;
+    d.temp_kp                 = BoardConfig::TEMP_PID_KP;
+    d.temp_ki                 = BoardConfig::TEMP_PID_KI;
+    d.temp_kd                 = BoardConfig::TEMP_PID_KD;
+    d.temp_d_tau_s            = BoardConfig::TEMP_PID_D_TAU_S;
+    d.cascade_kp              = BoardConfig::PRESS_CASCADE_KP;
+    d.cascade_ki              = BoardConfig::PRESS_CASCADE_KI;
+    d.press_kp                = BoardConfig::PRESS_PID_KP;
+    d.press_ki                = BoardConfig::PRESS_PID_KI;
+    d.press_kd                = BoardConfig::PRESS_PID_KD;
+    return d;
+}
+
+// 逐项检查范围，越界（例如新固件收紧了范围）的参数回到缺省值
+void ConfigStore::sanitize(Data &d)
+{
+    const Data def_data = defaults();
+    for (uint8_t id = 0; id < Proto::CFG_ID_LIMIT; ++id) {
+        ParamDef def;
+        if (!findParam(id, def)) continue;
+        if (!inRange(def, readParam(d, def))) writeParam(d, def, readParam(def_data, def));
+    }
+}
+
+uint32_t ConfigStore::begin()
+{
+    const uint32_t t0 = micros();
+
+    data_ = defaults();
+#if defined(ARDUINO_ARCH_MBED)
+    flash_ok_ = false;
+    if (flash_.init() == 0) {
+        const uint32_t region = BoardConfig::CONFIG_FLASH_SECTORS * BoardConfig::CONFIG_SECTOR_BYTES;
+        base_addr_ = flash_.get_flash_start() + flash_.get_flash_size() - region;
+        flash_ok_ = flash_.get_sector_size(base_addr_) == BoardConfig::CONFIG_SECTOR_BYTES &&
+                    kSlotBytes % flash_.get_page_size() == 0;
+    }
+
+    // 写入位置：紧接序号最大的记录头（不论 CRC 是否正确）
+    last_seq_ = 0;
+    next_slot_ = 0;
+    if (flash_ok_) {
+        for (uint16_t s = 0; s < kSlots; ++s) {
+            Header h;
+            flash_.read(&h, slotAddr(s), sizeof(h));
+            if (h.magic != kMagic || h.seq == 0xFFFFFFFFu) continue;
+            if (h.seq > last_seq_) {
+                last_seq_ = h.seq;
+                next_slot_ = static_cast<uint16_t>((s + 1) % kSlots);
+            }
+        }
+    }
+#endif
+    loaded_ = loadLatest();
+    dirty_ = false;
+    changed_ = true;
+    staged_ = false;
+    version_ = 1;
+
+    return micros() - t0;
+}
+
+bool ConfigStore::loadLatest()
+{
+#if defined(ARDUINO_ARCH_MBED)
+    if (!flash_ok_) return false;
+
+    // 取序号最大的有效记录；CRC 失败（写入中途掉电）则退到次新的一条
+    uint32_t below = 0xFFFFFFFFu;
+    for (;;) {
+        int16_t best = -1;
+        uint32_t best_seq = 0;
+        for (uint16_t s = 0; s < kSlots; ++s) {
+            Header h;
+            flash_.read(&h, slotAddr(s), sizeof(h));
+            if (h.magic != kMagic || h.seq == 0 || h.seq >= below) continue;
+            if (h.seq > best_seq) {
+                best_seq = h.seq;
+                best = static_cast<int16_t>(s);
+            }
+        }
+        if (best < 0) return false;
+
+        Header h;
+        Data d;
+        if (readRecord(static_cast<uint16_t>(best), h, d)) {
+            sanitize(d);
+            data_ = d;
+            seq_ = h.seq;
+            active_slot_ = best;
+            return true;
+        }
+        below = best_seq;
+    }
+#else
+    return false;
+#endif
+}
+
+#if defined(ARDUINO_ARCH_MBED)
+bool ConfigStore::readRecord(uint16_t slot, Header &h, Data &d)
+{
+    uint8_t img[kSlotBytes];
+    flash_.read(img, slotAddr(slot), sizeof(Header));
+    memcpy(&h, img, sizeof(h));
+
+    if (h.magic != kMagic) return false;
+    if ((h.version >> 8) != (kVersion >> 8)) return false;      // 主版本不同：布局不兼容
+    if (h.len == 0 || h.len > kSlotBytes - sizeof(Header)) return false;
+
+    flash_.read(img + sizeof(Header), slotAddr(slot) + sizeof(Header), h.len);
+    const size_t crc_from = offsetof(Header, version);
+    if (FrameCodec::crc16_modbus(img + crc_from, sizeof(Header) - crc_from + h.len) != h.crc) return false;
+
+    // 旧记录较短：其后追加的字段保持缺省值；较新固件写的更长记录只取认识的部分
+    d = defaults();
+    memcpy(&d, img + sizeof(Header), (h.len < sizeof(Data)) ? h.len : sizeof(Data));
+    return true;
+}
+
+bool ConfigStore::slotBlank(uint16_t slot)
+{
+    uint8_t img[kSlotBytes];
+    flash_.read(img, slotAddr(slot), sizeof(img));
+    const uint8_t erased = flash_.get_erase_value();
+    for (uint16_t i = 0; i < sizeof(img); ++i) {
+        if (img[i] != erased) return false;
+    }
+    return true;
+}
+#endif
+
+uint8_t ConfigStore::get(uint8_t id, float &value) const
+{
+    ParamDef def;
+    if (!findParam(id, def)) return Proto::CONFIG_ERR_ID;
+    value = readParam(data_, def);
+    return Proto::CONFIG_OK;
+}
+
+uint8_t ConfigStore::set(uint8_t id, float value)
+{
+    ParamDef def;
+    if (!findParam(id, def)) return Proto::CONFIG_ERR_ID;
+    if (!inRange(def, value)) return Proto::CONFIG_ERR_RANGE;
+
+    writeParam(data_, def, value);
+    dirty_ = true;
+    markChanged();
+    return Proto::CONFIG_OK;
+}
+
+bool ConfigStore::info(uint8_t id, uint8_t &type, float &min_v, float &max_v)
+{
+    ParamDef def;
+    if (!findParam(id, def)) return false;
+    type = def.integer ? Proto::DAQ_T_U32 : Proto::DAQ_T_F32;
+    min_v = def.min_v;
+    max_v = def.max_v;
+    return true;
+}
+
+uint8_t ConfigStore::validate(uint8_t id, float value)
+{
+    ParamDef def;
+    if (!findParam(id, def)) return Proto::CONFIG_ERR_ID;
+    return inRange(def, value) ? Proto::CONFIG_OK : Proto::CONFIG_ERR_RANGE;
+}
+
+uint8_t ConfigStore::stage(const uint8_t *ids, const float *values, uint8_t count, uint8_t *item_status)
+{
+    // 先整批校验，全部通过才写入
+    uint8_t result = Proto::CONFIG_OK;
+    for (uint8_t i = 0; i < count; ++i) {
+        ParamDef def;
+        if (!findParam(ids[i], def)) {
+            item_status[i] = Proto::CONFIG_ERR_ID;
+        } else if (!inRange(def, values[i])) {
+            item_status[i] = Proto::CONFIG_ERR_RANGE;
+        } else {
+            item_status[i] = Proto::CONFIG_OK;
+        }
+        if (result == Proto::CONFIG_OK) result = item_status[i];
+    }
+    if (result != Proto::CONFIG_OK) return result;
+
+    if (!staged_) {
+        stage_ = data_;
+        stage_base_ = version_;
+        staged_ = true;
+    }
+    for (uint8_t i = 0; i < count; ++i) {
+        ParamDef def;
+        findParam(ids[i], def);
+        writeParam(stage_, def, values[i]);
+    }
+    return Proto::CONFIG_OK;
+}
+
+uint8_t ConfigStore::getStaged(uint8_t id, float &value) const
+{
+    ParamDef def;
+    if (!findParam(id, def)) return Proto::CONFIG_ERR_ID;
+    value = readParam(staged_ ? stage_ : data_, def);
+    return Proto::CONFIG_OK;
+}
+
+uint8_t ConfigStore::applyStaged()
+{
+    if (!staged_) return Proto::CONFIG_ERR_STATE;
+    staged_ = false;
+    if (stage_base_ != version_) return Proto::CONFIG_ERR_VERSION;
+
+    data_ = stage_;
+    dirty_ = true;
+    markChanged();
+    return Proto::CONFIG_OK;
+}
+
+void ConfigStore::restoreDefaults()
+{
+    data_ = defaults();
+    dirty_ = true;
+    markChanged();
+}
+
+void ConfigStore::reload()
+{
+    if (!loadLatest()) data_ = defaults();
+    dirty_ = false;
+    markChanged();
+}
+
+void ConfigStore::markChanged()
+{
+    ++version_;
+    changed_ = true;
+}
+
+bool ConfigStore::commit()
+{
+#if defined(ARDUINO_ARCH_MBED)
+    if (!flash_ok_) return false;
+
+    uint8_t img[kSlotBytes];
+    const int16_t active_sector = (active_slot_ >= 0) ? static_cast<int16_t>(active_slot_ / kSlotsPerSector) : -1;
+
+    for (uint16_t n = 0; n < kSlots; ++n) {
+        const uint16_t slot = next_slot_;
+        next_slot_ = static_cast<uint16_t>((next_slot_ + 1) % kSlots);
+
+        if (slot % kSlotsPerSector == 0) {
+            // 进入新扇区：擦除（最新记录所在扇区除外，只可能在槽位异常时绕回）
+            if (slot / kSlotsPerSector == active_sector) continue;
+            if (flash_.erase(slotAddr(slot), BoardConfig::CONFIG_SECTOR_BYTES) != 0) return false;
+        } else if (!slotBlank(slot)) {
+            continue;   // 上次写入中断留下的残片：跳过
+        }
+
+        Header h;
+        h.magic = kMagic;
+        h.version = kVersion;
+        h.len = sizeof(Data);
+        h.reserved = 0xFFFF;
+        h.seq = ++last_seq_;
+        memset(img, 0xFF, sizeof(img));
+        memcpy(img, &h, sizeof(h));
+        memcpy(img + sizeof(Header), &data_, sizeof(Data));
+        const size_t crc_from = offsetof(Header, version);
+        h.crc = FrameCodec::crc16_modbus(img + crc_from, sizeof(Header) - crc_from + sizeof(Data));
+        memcpy(img, &h, sizeof(h));
+
+        if (flash_.program(img, slotAddr(slot), sizeof(img)) != 0) continue;
+
+        // 回读校验
+        Header rh;
+        Data rd;
+        if (!readRecord(slot, rh, rd) || rh.seq != h.seq || memcmp(&rd, &data_, sizeof(Data)) != 0) continue;
+
+        seq_ = h.seq;
+        active_slot_ = static_cast<int16_t>(slot);
+        dirty_ = false;
+        return true;
+    }
+    return false;
+#else
+    return false;
+#endif
+}
+
+bool ConfigStore::takeChanged()
+{
+    if (!changed_) return false;
+    changed_ = false;
+    return true;
+}
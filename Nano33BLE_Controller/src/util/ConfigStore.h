@@ -0,0 +1,142 @@
+// util/ConfigStore.h
+#pragma once
+
+#include <Arduino.h>
+
+#if defined(ARDUINO_ARCH_MBED)
+#include <mbed.h>
+#endif
+
+#include "../proto/Protocol.h"
+#include "BoardConfig.h"
+
+// ConfigStore：现场可调的标定/配置参数（RAM 副本 + 片内 Flash 持久化）
+// - 上电 begin()：扫描 Flash 配置区各槽位的记录头，取序号最大且 CRC 正确的一条装入 RAM；
+//   没有有效记录（首次烧录 / 布局不兼容）时使用 BoardConfig 缺省值。只读不写，
+//   128 个槽位的记录头扫描 + 一次 CRC 校验在 1 ms 以内
+// - set()：按参数表校验范围后只改 RAM，立即生效（主循环 takeChanged() 后下发到各模块）
+// - commit()：把 RAM 副本追加写入下一个槽位（日志式，依次轮转配置区各扇区 = 磨损均衡）；
+//   进入新扇区时先擦除该扇区（其中只剩最旧的记录）。擦除期间 CPU 停顿约 85 ms，
+//   调用方只应在 SAFE 模式下提交
+// - 记录带布局版本：旧版本记录（len 更短）照样装入，后续追加的字段保持缺省值
+// - 批量整定：stage() 把一组参数整批校验后写入暂存副本（任一项越界则整批不改），
+//   applyStaged() 一次性替换 RAM 副本——后台在两个控制节拍之间下发，同一组增益在同一拍生效；
+//   rollback() 丢弃暂存。version() 在每次 RAM 副本改变时 +1，供地面做乐观并发检查
+// 非 mbed 平台（主机仿真等）只有 RAM 副本，commit() 返回失败。
+
+class ConfigStore {
+public:
+    // 布局版本：只允许在末尾追加字段；删改字段时递增 kVersion 主版本（高字节）
+    static constexpr uint16_t kVersion = 0x0101;
+
+    struct Data {
+        float    press_v0_mv;
+        float    press_sens_mv_per_kpa;
+        float    safety_max_temp_c;
+        uint32_t telemetry_period_ms;
+        uint32_t diag_period_ms;
+        float    rtd_rref[BoardConfig::TEMP_SENSOR_MAX_COUNT];
+        // 0x0101 追加：安全阈值与控制增益
+        float    safety_max_press_pa;
+        float    safety_max_rate_c_per_s;
+        float    temp_kp;
+        float    temp_ki;
+        float    temp_kd;
+        float    temp_d_tau_s;
+        float    cascade_kp;
+        float    cascade_ki;
+        float    press_kp;
+        float    press_ki;
+        float    press_kd;
+    };
+
+    static Data defaults();
+
+    // 上电装载；返回耗时（us），供启动日志打印
+    uint32_t begin();
+
+    const Data &data() const { return data_; }
+
+    // 参数读写（Proto::CFG_*），返回 Proto::CONFIG_OK / CONFIG_ERR_*
+    uint8_t get(uint8_t id, float &value) const;
+    uint8_t set(uint8_t id, float value);
+
+    // 参数类型（Proto::DAQ_T_F32 / DAQ_T_U32）与取值范围；未知 id 返回 false
+    static bool info(uint8_t id, uint8_t &type, float &min_v, float &max_v);
+    // 只校验不写入：返回 set() 会给出的结果
+    static uint8_t validate(uint8_t id, float value);
+
+    // 批量暂存：整批校验通过才写入暂存副本，item_status 逐项给出结果；返回 CONFIG_OK 或首个错误
+    uint8_t stage(const uint8_t *ids, const float *values, uint8_t count, uint8_t *item_status);
+    // 暂存值（无暂存时为生效值）
+    uint8_t getStaged(uint8_t id, float &value) const;
+    // 暂存副本整体生效；无暂存返回 CONFIG_ERR_STATE，暂存后参数被其他途径改过返回 CONFIG_ERR_VERSION（暂存作废）
+    uint8_t applyStaged();
+    void rollback() { staged_ = false; }
+    bool staged() const { return staged_; }
+    uint32_t version() const { return version_; }
+
+    // 恢复缺省值 / 重新装载 Flash 中的最新记录（只改 RAM）
+    void restoreDefaults();
+    void reload();
+
+    // 写入 Flash；失败时 RAM 副本不变
+    bool commit();
+
+    bool dirty() const { return dirty_; }
+    uint32_t commitSeq() const { return seq_; }
+    bool loadedFromFlash() const { return loaded_; }
+
+    // RAM 副本改变（set/applyStaged/defaults/reload）后返回一次 true
+    bool takeChanged();
+
+private:
+    // CRC 覆盖 version 起至数据末尾（连续字节）
+    struct Header {
+        uint32_t magic;
+        uint16_t crc;       // CRC16/MODBUS
+        uint16_t version;
+        uint16_t len;       // Data 字节数
+        uint16_t reserved;
+        uint32_t seq;       // 提交序号，单调递增（0 保留为“无记录”）
+    };
+
+    static constexpr uint32_t kMagic = 0x31474643u;   // "CFG1"
+    static constexpr uint16_t kSlotBytes = BoardConfig::CONFIG_SLOT_BYTES;
+    static constexpr uint16_t kSlotsPerSector = BoardConfig::CONFIG_SECTOR_BYTES / kSlotBytes;
+    static constexpr uint16_t kSlots = BoardConfig::CONFIG_FLASH_SECTORS * kSlotsPerSector;
+
+    static_assert(sizeof(Header) + sizeof(Data) <= kSlotBytes, "config record does not fit in one slot");
+    static_assert(BoardConfig::CONFIG_SECTOR_BYTES % kSlotBytes == 0, "slots must tile a sector");
+    static_assert(BoardConfig::CONFIG_FLASH_SECTORS >= 2,
+                  "need a spare sector so the newest record survives an erase");
+
+    Data data_ = defaults();
+    bool dirty_ = false;
+    bool changed_ = false;
+    bool loaded_ = false;
+
+    Data     stage_;
+    bool     staged_ = false;
+    uint32_t stage_base_ = 0;   // 开始暂存时的 version_
+    uint32_t version_ = 1;
+
+    uint32_t seq_ = 0;          // Flash 中最新有效记录的序号
+    int16_t  active_slot_ = -1; // 该记录所在槽位
+    uint16_t next_slot_ = 0;    // 下一次提交的起始槽位
+
+#if defined(ARDUINO_ARCH_MBED)
+    mbed::FlashIAP flash_;
+    uint32_t base_addr_ = 0;
+    bool flash_ok_ = false;
+    uint32_t last_seq_ = 0;     // 已用过的最大序号（含校验失败的记录，序号不复用）
+
+    uint32_t slotAddr(uint16_t slot) const { return base_addr_ + static_cast<uint32_t>(slot) * kSlotBytes; }
+    bool readRecord(uint16_t slot, Header &h, Data &d);
+    bool slotBlank(uint16_t slot);
+#endif
+
+    static void sanitize(Data &d);
+    bool loadLatest();
+    void markChanged();
+};
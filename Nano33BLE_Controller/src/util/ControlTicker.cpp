@@ -0,0 +1,87 @@
+// util/ControlTicker.cpp
+#include "ControlTicker.h"
+
+void ControlTicker::begin(uint32_t period_us)
+{
+    period_us_ = period_us;
+    pending_ = 0;
+    overruns_ = 0;
+    ticks_ = 0;
+    last_start_us_ = 0;
+
+#if defined(ARDUINO_ARCH_MBED)
+    ticker_.attach(mbed::callback(this, &ControlTicker::onTimer),
+                   std::chrono::microseconds(period_us_));
+#else
+    next_due_us_ = micros() + period_us_;
+#endif
+}
+
+#if defined(ARDUINO_ARCH_MBED)
+void ControlTicker::onTimer()
+{
+    // 中断上下文：上一节拍尚未执行完/未被取走 -> 记一次超时，节拍合并（不追赶）
+    if (pending_ != 0) {
+        overruns_ = overruns_ + 1;
+        return;
+    }
+    pending_ = 1;
+}
+#endif
+
+bool ControlTicker::takeTick()
+{
+#if defined(ARDUINO_ARCH_MBED)
+    if (pending_ == 0) return false;
+    noInterrupts();
+    pending_ = 0;
+    interrupts();
+#else
+    const uint32_t now = micros();
+    if (static_cast<int32_t>(now - next_due_us_) < 0) return false;
+    next_due_us_ += period_us_;
+    if (static_cast<int32_t>(now - next_due_us_) >= 0) {
+        // 落后超过一个周期：合并节拍并记超时
+        const uint32_t behind = now - next_due_us_;
+        const uint32_t missed = behind / period_us_ + 1;
+        overruns_ = overruns_ + missed;
+        next_due_us_ += missed * period_us_;
+    }
+#endif
+
+    start_us_ = micros();
+    if (ticks_ != 0) {
+        const uint32_t dt = start_us_ - last_start_us_;
+        const uint32_t jitter = (dt > period_us_) ? (dt - period_us_) : (period_us_ - dt);
+        if (jitter > win_jitter_max_us_) win_jitter_max_us_ = jitter;
+        win_jitter_sum_us_ += jitter;
+        ++win_count_;
+    }
+    last_start_us_ = start_us_;
+    ++ticks_;
+    return true;
+}
+
+void ControlTicker::endTick()
+{
+    const uint32_t exec = micros() - start_us_;
+    last_exec_us_ = exec;
+    if (exec > win_exec_max_us_) win_exec_max_us_ = exec;
+}
+
+ControlTicker::Stats ControlTicker::takeStats()
+{
+    Stats s;
+    s.period_us = period_us_;
+    s.ticks = ticks_;
+    s.overruns = overruns_;
+    s.jitter_max_us = win_jitter_max_us_;
+    s.jitter_avg_us = win_count_ ? (win_jitter_sum_us_ / win_count_) : 0;
+    s.exec_max_us = win_exec_max_us_;
+
+    win_jitter_max_us_ = 0;
+    win_jitter_sum_us_ = 0;
+    win_count_ = 0;
+    win_exec_max_us_ = 0;
+    return s;
+}
@@ -0,0 +1,65 @@
+// util/ControlTicker.h
+#pragma once
+
+#include <Arduino.h>
+
+#if defined(ARDUINO_ARCH_MBED)
+#include <mbed.h>
+#endif
+
+// ControlTicker：固定周期控制节拍
+// - Nano 33 BLE (mbed)：由硬件定时器 (mbed::Ticker) 中断置位节拍，主循环取走后执行控制步；
+//   中断里只做计数/打时间戳，不做任何总线访问。
+// - 其他平台：退化为 micros() 轮询调度（保持相同接口）。
+// - 统计：节拍间隔抖动（相对标称周期）、控制步执行时间、超时（上一节拍未处理完又来新节拍）。
+
+class ControlTicker {
+public:
+    struct Stats {
+        uint32_t period_us     = 0;  // 标称周期
+        uint32_t ticks         = 0;  // 累计执行的节拍数
+        uint32_t overruns      = 0;  // 累计丢失/合并的节拍数
+        uint32_t jitter_max_us = 0;  // 窗口内 |实际间隔 - 标称周期| 最大值
+        uint32_t jitter_avg_us = 0;  // 窗口内平均抖动
+        uint32_t exec_max_us   = 0;  // 窗口内控制步最长执行时间
+    };
+
+    void begin(uint32_t period_us);
+
+    // 主循环调用：有待执行的节拍时返回 true，随后执行控制步并调用 endTick()
+    bool takeTick();
+    void endTick();
+
+    // 上一个控制步的执行时间（us）
+    uint32_t lastExecUs() const { return last_exec_us_; }
+
+    // 累计节拍数 / 累计超时（不清零）
+    uint32_t ticks() const { return ticks_; }
+    uint32_t overruns() const { return overruns_; }
+
+    // 读取统计；窗口量（抖动/执行时间）在读取后清零，累计量保留
+    Stats takeStats();
+
+private:
+    uint32_t period_us_ = 0;
+
+    volatile uint32_t pending_ = 0;       // 已到期但尚未执行的节拍数
+    volatile uint32_t overruns_ = 0;
+
+    uint32_t ticks_ = 0;
+    uint32_t last_start_us_ = 0;
+    uint32_t start_us_ = 0;
+
+    uint32_t win_jitter_max_us_ = 0;
+    uint32_t win_jitter_sum_us_ = 0;
+    uint32_t win_count_ = 0;
+    uint32_t win_exec_max_us_ = 0;
+    uint32_t last_exec_us_ = 0;
+
+#if defined(ARDUINO_ARCH_MBED)
+    mbed::Ticker ticker_;
+    void onTimer();
+#else
+    uint32_t next_due_us_ = 0;
+#endif
+};
@@ -0,0 +1,189 @@
+// util/DaqRegistry.cpp
+#include "DaqRegistry.h"
+
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+uint8_t DaqRegistry::typeSize(uint8_t type)
+{
+    switch (type) {
+    case Proto::DAQ_T_U8:
+    case Proto::DAQ_T_I8:  return 1;
+    case Proto::DAQ_T_U16:
+    case Proto::DAQ_T_I16: return 2;
+    case Proto::DAQ_T_U32:
+    case Proto::DAQ_T_I32:
+    case Proto::DAQ_T_F32: return 4;
+    default:               return 0;
+    }
+}
+
+void DaqRegistry::begin(const Var *vars, uint8_t count, uint32_t tick_period_us)
+{
+    vars_ = vars;
+    var_count_ = count;
+    tick_us_ = tick_period_us;
+    stop();
+}
+
+const DaqRegistry::Var *DaqRegistry::find(uint8_t id) const
+{
+    for (uint8_t i = 0; i < var_count_; ++i) {
+        if (vars_[i].id == id) return &vars_[i];
+    }
+    return nullptr;
+}
+
+uint8_t DaqRegistry::start(const uint8_t *ids, uint8_t count, uint16_t divider, uint8_t samples_per_frame)
+{
+    if (count == 0 || count > kMaxVars || divider == 0) return Proto::DAQ_ERR_SIZE;
+
+    const Var *sel[kMaxVars];
+    uint16_t row = 0;
+    for (uint8_t i = 0; i < count; ++i) {
+        sel[i] = find(ids[i]);
+        if (!sel[i] || typeSize(sel[i]->type) == 0) return Proto::DAQ_ERR_ID;
+        row = static_cast<uint16_t>(row + typeSize(sel[i]->type));
+    }
+
+    const uint8_t max_rows = static_cast<uint8_t>(kRowCap / row);
+    if (samples_per_frame == 0) samples_per_frame = max_rows;
+    if (samples_per_frame > max_rows) return Proto::DAQ_ERR_SIZE;
+
+    for (uint8_t i = 0; i < count; ++i) sel_[i] = sel[i];
+    sel_count_ = count;
+    row_bytes_ = static_cast<uint8_t>(row);
+    divider_ = divider;
+    spf_ = samples_per_frame;
+
+    ++list_id_;
+    active_ = true;
+    div_left_ = 0;
+    sample_no_ = 0;
+    build_rows_ = 0;
+    ready_len_ = 0;
+    return Proto::DAQ_OK;
+}
+
+void DaqRegistry::stop()
+{
+    active_ = false;
+    build_rows_ = 0;
+    ready_len_ = 0;
+}
+
+void DaqRegistry::pack(const Var &v, uint8_t *dst)
+{
+    const uint8_t n = typeSize(v.type);
+    if (v.addr) {
+        memcpy(dst, v.addr, n);
+        return;
+    }
+
+    const float x = v.read ? v.read() : NAN;
+    switch (v.type) {
+    case Proto::DAQ_T_F32:
+        memcpy(dst, &x, 4);
+        break;
+    case Proto::DAQ_T_U8:
+    case Proto::DAQ_T_U16:
+    case Proto::DAQ_T_U32: {
+        const uint32_t u = (isfinite(x) && x > 0.0f) ? static_cast<uint32_t>(lroundf(x)) : 0;
+        memcpy(dst, &u, n);   // 小端：取低位字节
+        break;
+    }
+    default: {
+        const int32_t s = isfinite(x) ? static_cast<int32_t>(lroundf(x)) : 0;
+        memcpy(dst, &s, n);
+        break;
+    }
+    }
+}
+
+void DaqRegistry::sample(uint32_t now_ms)
+{
+    if (!active_) return;
+    if (div_left_ > 0) {
+        --div_left_;
+        return;
+    }
+    div_left_ = static_cast<uint16_t>(divider_ - 1u);
+
+    if (build_rows_ == 0) {
+        Proto::PayloadDaqV1 h;
+        h.list_id = list_id_;
+        h.n_samples = 0;
+        h.first_sample = sample_no_;
+        h.t_ms = now_ms;
+        memcpy(build_, &h, sizeof(h));
+    }
+
+    uint8_t *row = build_ + sizeof(Proto::PayloadDaqV1) + build_rows_ * row_bytes_;
+    for (uint8_t i = 0; i < sel_count_; ++i) {
+        pack(*sel_[i], row);
+        row += typeSize(sel_[i]->type);
+    }
+    ++build_rows_;
+    ++sample_no_;
+
+    if (build_rows_ >= spf_) {
+        build_[offsetof(Proto::PayloadDaqV1, n_samples)] = build_rows_;
+        if (ready_len_) ++overruns_;
+        ready_len_ = static_cast<uint8_t>(sizeof(Proto::PayloadDaqV1) + build_rows_ * row_bytes_);
+        memcpy(ready_, build_, ready_len_);
+        build_rows_ = 0;
+    }
+}
+
+uint8_t DaqRegistry::takeFrame(uint8_t *payload, uint8_t cap)
+{
+    if (ready_len_ == 0 || ready_len_ > cap) return 0;
+    const uint8_t n = ready_len_;
+    memcpy(payload, ready_, n);
+    ready_len_ = 0;
+    ++frames_;
+    return n;
+}
+
+void DaqRegistry::fillStatus(Proto::PayloadDaqStatusV1 &s, uint8_t status) const
+{
+    memset(&s, 0, sizeof(s));
+    s.status = status;
+    s.list_id = list_id_;
+    s.active = active_ ? 1 : 0;
+    s.count = active_ ? sel_count_ : 0;
+    s.divider = divider_;
+    s.samples_per_frame = spf_;
+    s.row_bytes = row_bytes_;
+    s.sample_period_us = tick_us_ * divider_;
+    s.frames = frames_;
+    s.overruns = overruns_;
+    for (uint8_t i = 0; i < s.count; ++i) {
+        s.ids[i] = sel_[i]->id;
+        s.types[i] = sel_[i]->type;
+    }
+}
+
+uint8_t DaqRegistry::fillCatalog(uint8_t first, uint8_t *payload, uint8_t cap) const
+{
+    Proto::PayloadDaqCatalogV1 h;
+    h.total = var_count_;
+    h.first = first;
+    h.count = 0;
+
+    uint8_t len = sizeof(h);
+    for (uint8_t i = first; i < var_count_ && h.count < Proto::DAQ_CATALOG_ENTRIES; ++i) {
+        if (len + sizeof(Proto::DaqCatalogEntryV1) > cap) break;
+        Proto::DaqCatalogEntryV1 e;
+        memset(&e, 0, sizeof(e));
+        e.id = vars_[i].id;
+        e.type = vars_[i].type;
+        strncpy(e.name, vars_[i].name, sizeof(e.name) - 1);
+        memcpy(payload + len, &e, sizeof(e));
+        len = static_cast<uint8_t>(len + sizeof(e));
+        ++h.count;
+    }
+    memcpy(payload, &h, sizeof(h));
+    return len;
+}
@@ -0,0 +1,75 @@
+// util/DaqRegistry.h
+#pragma once
+
+#include <Arduino.h>
+
+#include "../proto/FrameCodec.h"
+#include "../proto/Protocol.h"
+
+// DaqRegistry：按 id 订阅的变量采集（调试/整定观测用，类似 XCP DAQ）
+// - 变量表在编译期登记（主程序中的静态常量数组）：id、类型、名称，以及变量地址或读函数
+//   （驱动内部量经访问器读取）；目录可由地面分块查询，新增观测量只需登记一行
+// - 地面下发订阅：变量 id 列表 + 分频（每 divider 个控制节拍采一行）+ 每帧行数；
+//   sample() 在控制节拍末尾调用，按订阅顺序把各变量紧凑写入一行，攒满一帧后交给后台发送
+// - 帧在后台取走之前又攒满下一帧时，旧帧被覆盖（计入 overruns）；地面按 first_sample 跳号识别丢帧
+// sample() 与其余接口都在主循环上下文调用（控制节拍不在中断中执行），无需加锁。
+
+class DaqRegistry {
+public:
+    struct Var {
+        uint8_t     id;
+        uint8_t     type;           // Proto::DAQ_T_*
+        const void *addr;           // 变量地址（与 read 二选一，类型须与 type 一致）
+        float     (*read)();        // 读函数：结果按 type 转换后打包
+        const char *name;           // 最长 13 字符
+    };
+
+    static constexpr uint8_t kMaxVars = Proto::DAQ_MAX_VARS;
+    static constexpr uint8_t kRowCap  = FrameCodec::MAX_PAYLOAD - sizeof(Proto::PayloadDaqV1);
+
+    static uint8_t typeSize(uint8_t type);
+
+    void begin(const Var *vars, uint8_t count, uint32_t tick_period_us);
+
+    // 开始/替换订阅，返回 Proto::DAQ_OK / DAQ_ERR_*（失败时原订阅不变）
+    uint8_t start(const uint8_t *ids, uint8_t count, uint16_t divider, uint8_t samples_per_frame);
+    void stop();
+
+    // 控制节拍末尾调用
+    void sample(uint32_t now_ms);
+
+    // 取走一帧已攒满的数据（负载含 PayloadDaqV1 头），无帧返回 0
+    uint8_t takeFrame(uint8_t *payload, uint8_t cap);
+
+    void fillStatus(Proto::PayloadDaqStatusV1 &s, uint8_t status) const;
+
+    // 目录分块（PayloadDaqCatalogV1 + 条目），返回负载字节数
+    uint8_t fillCatalog(uint8_t first, uint8_t *payload, uint8_t cap) const;
+
+private:
+    const Var *vars_ = nullptr;
+    uint8_t    var_count_ = 0;
+    uint32_t   tick_us_ = 0;
+
+    const Var *sel_[kMaxVars];
+    uint8_t    sel_count_ = 0;
+    uint8_t    row_bytes_ = 0;
+    uint16_t   divider_ = 1;
+    uint8_t    spf_ = 1;
+    bool       active_ = false;
+    uint8_t    list_id_ = 0;
+
+    uint16_t   div_left_ = 0;       // 距下一次采样的节拍数
+    uint16_t   sample_no_ = 0;      // 下一行的采样序号
+
+    uint8_t    build_[FrameCodec::MAX_PAYLOAD];
+    uint8_t    build_rows_ = 0;
+    uint8_t    ready_[FrameCodec::MAX_PAYLOAD];
+    uint8_t    ready_len_ = 0;
+
+    uint32_t   frames_ = 0;
+    uint32_t   overruns_ = 0;
+
+    const Var *find(uint8_t id) const;
+    static void pack(const Var &v, uint8_t *dst);
+};
@@ -0,0 +1,75 @@
+// util/DecimatingFilter.h
+#pragma once
+
+#include <Arduino.h>
+
+// 定点抽取滤波（每个 ADC 样本增量执行，整数运算）：
+// - 3 点中值：剔除 I2C/干扰造成的单点尖峰
+// - M 点滑动平均（一阶 CIC）：维护环形缓冲与累加和，每样本一次加减
+// 输出为 M 个样本的累加和（原始码值 × M），由调用方在控制节拍换算为物理量，
+// 即按控制节拍从高速样本流中抽取。
+
+template <uint8_t M>
+class Median3BoxcarFilter {
+public:
+    static_assert(M >= 1, "window must be >= 1");
+
+    void reset()
+    {
+        sum_ = 0;
+        idx_ = 0;
+        count_ = 0;
+        hist_n_ = 0;
+        pending_ = 0;
+        for (uint8_t i = 0; i < M; ++i) ring_[i] = 0;
+    }
+
+    void push(int16_t x)
+    {
+        // 中值窗口：h0 最旧，h2 最新；不足 3 点时直通
+        hist_[0] = hist_[1];
+        hist_[1] = hist_[2];
+        hist_[2] = x;
+        if (hist_n_ < 3) ++hist_n_;
+        const int16_t m = (hist_n_ < 3) ? x : median3(hist_[0], hist_[1], hist_[2]);
+
+        sum_ += static_cast<int32_t>(m) - ring_[idx_];
+        ring_[idx_] = m;
+        if (++idx_ >= M) idx_ = 0;
+        if (count_ < M) ++count_;
+        if (pending_ < 0xFFFF) ++pending_;
+    }
+
+    // 窗口已填满（输出为完整的 M 点平均）
+    bool ready() const { return count_ >= M; }
+
+    // M 点累加和（码值 × M）
+    int32_t sum() const { return sum_; }
+
+    static constexpr uint8_t window() { return M; }
+
+    // 自上次调用以来新增的样本数（用于 fresh 判定 / 诊断），并清零
+    uint16_t takePending()
+    {
+        const uint16_t n = pending_;
+        pending_ = 0;
+        return n;
+    }
+
+private:
+    int16_t  ring_[M] = {0};
+    int32_t  sum_ = 0;
+    uint8_t  idx_ = 0;
+    uint8_t  count_ = 0;
+
+    int16_t  hist_[3] = {0, 0, 0};
+    uint8_t  hist_n_ = 0;
+    uint16_t pending_ = 0;
+
+    static int16_t median3(int16_t a, int16_t b, int16_t c)
+    {
+        if (a > b) { const int16_t t = a; a = b; b = t; }
+        if (b > c) b = c;
+        return (a > b) ? a : b;
+    }
+};
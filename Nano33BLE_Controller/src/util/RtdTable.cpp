@@ -0,0 +1,55 @@
+// util/RtdTable.cpp
+#include "RtdTable.h"
+
+namespace {
+// 编译期生成；const 对象进入 flash
+constexpr RtdCvdTable kRtdCvdTable{};
+constexpr RtdLowTable kRtdLowTable{};
+} // namespace
+
+const RtdCvdTable &rtdCvdTable()
+{
+    return kRtdCvdTable;
+}
+
+const RtdLowTable &rtdLowTable()
+{
+    return kRtdLowTable;
+}
+
+void RtdConverter::configure(float r0_ohm, float rref_ohm)
+{
+    const RtdCvdTable &tab = rtdCvdTable();
+    ohm_per_code_ = rref_ohm / 32768.0f;
+    idx_per_code_ = ohm_per_code_ / r0_ohm * tab.inv_step;
+    idx_offset_   = tab.ratio_min * tab.inv_step;
+
+    const RtdLowTable &low = rtdLowTable();
+    low_idx_per_code_ = ohm_per_code_ / r0_ohm * low.inv_step;
+    low_idx_offset_   = low.ratio_min * low.inv_step;
+}
+
+bool RtdConverter::codeToTempC(uint16_t code, float &temp_c) const
+{
+    const float x = static_cast<float>(code) * idx_per_code_ - idx_offset_;
+    if (x < 0.0f) {
+        // -200 °C 以下：低温表
+        const float xl = static_cast<float>(code) * low_idx_per_code_ - low_idx_offset_;
+        if (!(xl >= 0.0f)) return false;
+        uint16_t i = static_cast<uint16_t>(xl);
+        if (i >= RtdLowTable::SIZE - 1) i = RtdLowTable::SIZE - 2;
+        const float frac = xl - static_cast<float>(i);
+        const float *t = rtdLowTable().temp_c;
+        temp_c = t[i] + frac * (t[i + 1] - t[i]);
+        return true;
+    }
+    if (!(x >= 0.0f) || x > static_cast<float>(RtdCvdTable::SIZE - 1)) return false;
+
+    uint16_t i = static_cast<uint16_t>(x);
+    if (i >= RtdCvdTable::SIZE - 1) i = RtdCvdTable::SIZE - 2;
+    const float frac = x - static_cast<float>(i);
+
+    const float *t = rtdCvdTable().temp_c;
+    temp_c = t[i] + frac * (t[i + 1] - t[i]);
+    return true;
+}
@@ -0,0 +1,203 @@
+// util/RtdTable.h
+#pragma once
+
+#include <Arduino.h>
+
+#include "BoardConfig.h"
+
+// 铂电阻换算：编译期生成的 R/R0 -> 温度 查找表 + 线性插值
+// - 表按电阻比 R/R0 均匀分格，PT100/PT1000、不同 RREF 共用一张表；
+//   各通道只需预先算好“15-bit RTD 码 -> 表下标”的比例与偏移
+// - 表值由 Callendar–Van Dusen（IEC 60751，系数 BoardConfig::PT100_A/B/C）在编译期用
+//   牛顿迭代精确反解得到，放在 flash（.rodata）；运行时无 sqrtf / 多项式
+// - 主表覆盖 -200..850 °C（CVD 的定义范围）；低温表覆盖 -259..-200 °C（液氢温区），见 RtdLowTable。
+//   两表在 -200 °C 处连续；低于 -259 °C 换算返回 false
+
+// 编译期数学函数（C++14 constexpr 不能调用 <math.h>）
+namespace RtdMath {
+
+constexpr double kLn2 = 0.69314718055994530942;
+
+// ln(x)，x > 0：按 2 的幂归约到 [1, 2)，再用 atanh 级数
+constexpr double ln(double x)
+{
+    int n = 0;
+    while (x >= 2.0) { x *= 0.5; ++n; }
+    while (x < 1.0)  { x *= 2.0; --n; }
+    const double y = (x - 1.0) / (x + 1.0);
+    const double y2 = y * y;
+    double term = y;
+    double sum = 0.0;
+    for (int k = 0; k < 24; ++k) {
+        sum += term / (2 * k + 1);
+        term *= y2;
+    }
+    return n * kLn2 + 2.0 * sum;
+}
+
+// exp(x)：按 ln2 归约后泰勒展开
+constexpr double exp(double x)
+{
+    const int n = static_cast<int>(x / kLn2) - (x < 0.0 ? 1 : 0);
+    const double r = x - n * kLn2;
+    double term = 1.0;
+    double sum = 1.0;
+    for (int k = 1; k < 24; ++k) {
+        term *= r / k;
+        sum += term;
+    }
+    double scale = 1.0;
+    for (int i = 0; i < n; ++i) scale *= 2.0;
+    for (int i = 0; i > n; --i) scale *= 0.5;
+    return sum * scale;
+}
+
+} // namespace RtdMath
+
+struct RtdCvdTable {
+    static constexpr uint16_t SIZE = 513;          // 512 段，插值误差 < 0.001 °C
+    static constexpr double   T_MIN_C = -200.0;
+    static constexpr double   T_MAX_C = 850.0;
+
+    float ratio_min;
+    float ratio_step;
+    float inv_step;
+    float temp_c[SIZE];
+
+    // CVD 正函数：R/R0 = 1 + A·T + B·T² (+ C·(T-100)·T³，T < 0)
+    static constexpr double ratioAt(double t)
+    {
+        const double a = BoardConfig::PT100_A;
+        const double b = BoardConfig::PT100_B;
+        const double c = BoardConfig::PT100_C;
+        return (t >= 0.0) ? 1.0 + a * t + b * t * t
+                          : 1.0 + a * t + b * t * t + c * (t - 100.0) * t * t * t;
+    }
+
+    // CVD 反解（牛顿迭代，编译期/主机端均可用）
+    static constexpr double tempAt(double ratio)
+    {
+        const double a = BoardConfig::PT100_A;
+        const double b = BoardConfig::PT100_B;
+        const double c = BoardConfig::PT100_C;
+        double t = (ratio - 1.0) / a;
+        for (int i = 0; i < 30; ++i) {
+            const double d = (t >= 0.0) ? a + 2.0 * b * t
+                                        : a + 2.0 * b * t + c * (4.0 * t * t * t - 300.0 * t * t);
+            t -= (ratioAt(t) - ratio) / d;
+        }
+        return t;
+    }
+
+    constexpr RtdCvdTable() : ratio_min(0.0f), ratio_step(0.0f), inv_step(0.0f), temp_c{}
+    {
+        const double r0 = ratioAt(T_MIN_C);
+        const double step = (ratioAt(T_MAX_C) - r0) / (SIZE - 1);
+        ratio_min = static_cast<float>(r0);
+        ratio_step = static_cast<float>(step);
+        inv_step = static_cast<float>(1.0 / step);
+        for (uint16_t i = 0; i < SIZE; ++i) {
+            temp_c[i] = static_cast<float>(tempAt(r0 + step * i));
+        }
+    }
+};
+
+// 低温段 -259..-200 °C：IEC 60751 的 CVD 在 -200 °C 以下没有定义。这里用 ITS-90 铂参考函数
+// W_r(T)（13.8033..273.16 K 段）按 Matthiessen 定则折算到工业铂电阻：R/R0 = k·W_r(T) + c，
+// 剩余电阻项 c 与 k 由 0 °C 和 -200 °C 两点与 CVD 对齐（-200 °C 处电阻连续，斜率差约 2%）。
+// 该曲线是同类传感器的典型值（20 K 约 2.26 Ω / PT100），单支传感器在此温区的偏差可达 1 K 量级，
+// 精确测量仍需按标定曲线修正
+struct RtdLowTable {
+    static constexpr uint16_t SIZE = 513;          // 512 段；-259 °C 附近斜率最平，插值误差约 0.03 °C
+    static constexpr double   T_MIN_C = -259.0;                 // 14.15 K，参考函数下限 13.8033 K 之上
+    static constexpr double   T_MAX_C = RtdCvdTable::T_MIN_C;
+    static constexpr double   K0 = 273.15;
+
+    float ratio_min;
+    float ratio_step;
+    float inv_step;
+    float temp_c[SIZE];
+
+    // ln W_r 关于 u = ln(T/K) 的多项式（ITS-90 系数 A0..A12）
+    static constexpr double lnWr(double u)
+    {
+        constexpr double A[13] = {-2.13534729, 3.18324720, -1.80143597, 0.71727204, 0.50344027,
+                                  -0.61899395, -0.05332322, 0.28021362, 0.10715224, -0.29302865,
+                                  0.04459872, 0.11868632, -0.05248134};
+        const double x = (u - RtdMath::ln(273.16) + 1.5) / 1.5;
+        double s = 0.0;
+        for (int i = 12; i >= 0; --i) s = s * x + A[i];
+        return s;
+    }
+
+    static constexpr double dLnWr(double u)
+    {
+        constexpr double A[13] = {-2.13534729, 3.18324720, -1.80143597, 0.71727204, 0.50344027,
+                                  -0.61899395, -0.05332322, 0.28021362, 0.10715224, -0.29302865,
+                                  0.04459872, 0.11868632, -0.05248134};
+        const double x = (u - RtdMath::ln(273.16) + 1.5) / 1.5;
+        double s = 0.0;
+        for (int i = 12; i >= 1; --i) s = s * x + i * A[i];
+        return s / 1.5;
+    }
+
+    static constexpr double wr(double t_c) { return RtdMath::exp(lnWr(RtdMath::ln(t_c + K0))); }
+
+    // 折算系数：k·W_r(0 °C) + c = 1，k·W_r(-200 °C) + c = CVD(-200 °C)
+    static constexpr double k()
+    {
+        return (1.0 - RtdCvdTable::ratioAt(T_MAX_C)) / (wr(0.0) - wr(T_MAX_C));
+    }
+    static constexpr double c() { return 1.0 - k() * wr(0.0); }
+
+    static constexpr double ratioAt(double t) { return k() * wr(t) + c(); }
+
+    // 反解：W_r = (ratio − c)/k，对 u = ln T 做牛顿迭代（lnWr 为 u 的多项式）
+    static constexpr double tempAt(double ratio)
+    {
+        const double target = RtdMath::ln((ratio - c()) / k());
+        double u = RtdMath::ln(0.5 * (T_MIN_C + T_MAX_C) + K0);
+        for (int i = 0; i < 30; ++i) {
+            u -= (lnWr(u) - target) / dLnWr(u);
+        }
+        return RtdMath::exp(u) - K0;
+    }
+
+    constexpr RtdLowTable() : ratio_min(0.0f), ratio_step(0.0f), inv_step(0.0f), temp_c{}
+    {
+        const double kk = k();
+        const double cc = c();
+        const double r0 = kk * wr(T_MIN_C) + cc;
+        const double step = (RtdCvdTable::ratioAt(T_MAX_C) - r0) / (SIZE - 1);
+        ratio_min = static_cast<float>(r0);
+        ratio_step = static_cast<float>(step);
+        inv_step = static_cast<float>(1.0 / step);
+        for (uint16_t i = 0; i < SIZE; ++i) {
+            temp_c[i] = static_cast<float>(tempAt(r0 + step * i));
+        }
+        temp_c[SIZE - 1] = static_cast<float>(T_MAX_C);
+    }
+};
+
+// 全局唯一的表实例（定义于 RtdTable.cpp）
+const RtdCvdTable &rtdCvdTable();
+const RtdLowTable &rtdLowTable();
+
+// 单通道换算：按该通道的 R0（PT100/PT1000）与 RREF 预计算比例
+class RtdConverter {
+public:
+    void configure(float r0_ohm, float rref_ohm);
+
+    // 15-bit RTD 码 -> 电阻（Ω）
+    float codeToOhm(uint16_t code) const { return static_cast<float>(code) * ohm_per_code_; }
+
+    // 15-bit RTD 码 -> 温度（°C）；超出 -259..850 °C 返回 false
+    bool codeToTempC(uint16_t code, float &temp_c) const;
+
+private:
+    float ohm_per_code_ = 0.0f;
+    float idx_per_code_ = 0.0f;   // 码值 -> 表下标
+    float idx_offset_   = 0.0f;
+    float low_idx_per_code_ = 0.0f;  // 码值 -> 低温表下标
+    float low_idx_offset_   = 0.0f;
+};
@@ -3,9 +3,150 @@
 
 #include "BoardConfig.h"
 
+static_assert(BoardConfig::SAFETY_VOTE_N >= 1 && BoardConfig::SAFETY_VOTE_N <= 8, "vote window must be 1..8");
+static_assert(BoardConfig::SAFETY_VOTE_K >= 1 && BoardConfig::SAFETY_VOTE_K <= BoardConfig::SAFETY_VOTE_N,
+              "vote threshold must be 1..N");
+
+static constexpr uint8_t kVoteMask = static_cast<uint8_t>((1u << BoardConfig::SAFETY_VOTE_N) - 1u);
+
+static uint8_t popcount8(uint8_t v)
+{
+    uint8_t n = 0;
+    for (; v; v &= static_cast<uint8_t>(v - 1)) ++n;
+    return n;
+}
+
+bool SafetyManager::VoteLatch::update(bool beyond_set, bool beyond_clear)
+{
+    set_hist = static_cast<uint8_t>(((set_hist << 1) | (beyond_set ? 1u : 0u)) & kVoteMask);
+    clr_hist = static_cast<uint8_t>(((clr_hist << 1) | (beyond_clear ? 1u : 0u)) & kVoteMask);
+
+    if (!on) {
+        if (popcount8(set_hist) >= BoardConfig::SAFETY_VOTE_K) {
+            on = true;
+            return true;
+        }
+    } else if (clr_hist == 0) {
+        on = false;
+    }
+    return false;
+}
+
 void SafetyManager::begin()
 {
-    // 可在此加载阈值/配置
+    for (uint8_t i = 0; i < kTempCount; ++i) temp_[i] = TempChannel{};
+    press_ = PressChannel{};
+    heater_on_ = false;
+    valve_on_ = false;
+    active_ = 0;
+    last_trip_mask_ = 0;
+    trips_ = 0;
+    react_last_us_ = 0;
+    react_max_us_ = 0;
+}
+
+// 读数与上一样本完全相同的持续时间超过 limit_ms 视为卡死；armed=false 时不判定
+bool SafetyManager::stuck(float v, float &last, uint32_t &since_us, uint32_t t_us,
+                          uint32_t limit_ms, bool armed)
+{
+    if (!armed || !isfinite(v) || v != last) {
+        last = v;
+        since_us = t_us;
+        return false;
+    }
+    return static_cast<uint32_t>(t_us - since_us) >= limit_ms * 1000UL;
+}
+
+void SafetyManager::onTempSample(uint8_t ch, float temp_c, bool valid, uint32_t t_us)
+{
+    if (ch >= kTempCount) return;
+    TempChannel &c = temp_[ch];
+
+    const bool finite = valid && isfinite(temp_c);
+    const bool is_stuck = stuck(temp_c, c.last_c, c.same_since_us, t_us, BoardConfig::SAFETY_TEMP_STUCK_MS,
+                                ch == BoardConfig::TEMP_CTRL_CHANNEL && heater_on_);
+    const bool bad = !finite || is_stuck;
+
+    uint8_t newly = 0;
+    if (c.fault.update(bad, bad)) newly |= TRIP_TEMP_FAULT;
+
+    if (finite) {
+        if (c.over.update(temp_c > max_temp_c_, temp_c > max_temp_c_ - BoardConfig::SAFETY_TEMP_HYST_C)) {
+            newly |= TRIP_OVERTEMP;
+        }
+
+        // 温升速率：相对 ≥ 一个窗口之前的基线计算，每样本一票；基线每窗口前移一次
+        if (!isfinite(c.ref_c)) {
+            c.ref_c = temp_c;
+            c.ref_us = t_us;
+        } else {
+            const uint32_t dt_us = t_us - c.ref_us;
+            if (dt_us >= BoardConfig::SAFETY_RATE_WINDOW_MS * 1000UL) {
+                const float rate = (temp_c - c.ref_c) / (static_cast<float>(dt_us) * 1e-6f);
+                if (c.rate.update(rate > max_rate_c_per_s_,
+                                  rate > max_rate_c_per_s_ - BoardConfig::SAFETY_RATE_HYST_C_PER_S)) {
+                    newly |= TRIP_TEMP_RATE;
+                }
+                if (dt_us >= 2UL * BoardConfig::SAFETY_RATE_WINDOW_MS * 1000UL) {
+                    c.ref_c = temp_c;
+                    c.ref_us = t_us;
+                }
+            }
+        }
+    } else {
+        // 无效样本不参与越限判定；速率基线作废，恢复后重新建立
+        c.ref_c = NAN;
+    }
+
+    refreshActive();
+    if (newly) trip(newly, t_us);
+}
+
+void SafetyManager::onPressureSample(float pressure_pa, int16_t raw_code, bool valid, uint32_t t_us)
+{
+    PressChannel &c = press_;
+
+    const bool finite = valid && isfinite(pressure_pa);
+    // 按原始码值判定：换算后的 Pa 在零点以下钳位为 0，通大气时恒定不变
+    const bool is_stuck = stuck(valid ? static_cast<float>(raw_code) : NAN, c.last_code, c.same_since_us, t_us,
+                                BoardConfig::SAFETY_PRESS_STUCK_MS, heater_on_ || valve_on_);
+    const bool bad = !finite || is_stuck;
+
+    uint8_t newly = 0;
+    if (c.fault.update(bad, bad)) newly |= TRIP_PRESS_FAULT;
+    if (finite) {
+        if (c.over.update(pressure_pa > max_press_pa_,
+                          pressure_pa > max_press_pa_ - BoardConfig::SAFETY_PRESS_HYST_PA)) {
+            newly |= TRIP_OVERPRESS;
+        }
+    }
+
+    refreshActive();
+    if (newly) trip(newly, t_us);
+}
+
+void SafetyManager::refreshActive()
+{
+    uint8_t m = 0;
+    for (uint8_t i = 0; i < kTempCount; ++i) {
+        if (temp_[i].over.on)  m |= TRIP_OVERTEMP;
+        if (temp_[i].rate.on)  m |= TRIP_TEMP_RATE;
+        if (temp_[i].fault.on) m |= TRIP_TEMP_FAULT;
+    }
+    if (press_.over.on)  m |= TRIP_OVERPRESS;
+    if (press_.fault.on) m |= TRIP_PRESS_FAULT;
+    active_ = m;
+}
+
+void SafetyManager::trip(uint8_t newly, uint32_t t_us)
+{
+    if (force_off_) force_off_(force_off_ctx_);
+
+    const uint32_t react = micros() - t_us;
+    react_last_us_ = react;
+    if (react > react_max_us_) react_max_us_ = react;
+    last_trip_mask_ = newly;
+    ++trips_;
 }
 
 void SafetyManager::checkAndClamp(ControlState &state,
@@ -13,6 +154,8 @@ void SafetyManager::checkAndClamp(ControlState &state,
                                   Proto::Outputs &out,
                                   uint32_t now_ms)
 {
+    (void)telem;
+
     // 1) 通讯超时 -> SAFE
     if (state.link_alive) {
         if (now_ms - state.last_link_heartbeat_ms > BoardConfig::LINK_TIMEOUT_MS) {
@@ -25,12 +168,9 @@ void SafetyManager::checkAndClamp(ControlState &state,
         state.mode = ControlMode::SAFE;
     }
 
-    // 2) 过温保护 -> SAFE
-    for (uint8_t i = 0; i < telem.temp_count; ++i) {
-        if (!isnan(telem.temp_c[i]) && telem.temp_c[i] > max_temp_c_) {
-            state.mode = ControlMode::SAFE;
-            break;
-        }
+    // 2) 联锁条件成立期间（过温/温升速率/超压/测量故障）-> SAFE
+    if (active_ != 0) {
+        state.mode = ControlMode::SAFE;
     }
 
     // 3) SAFE 模式输出强制归零
@@ -39,4 +179,19 @@ void SafetyManager::checkAndClamp(ControlState &state,
         out.valve_opening_pct = 0.0f;
         out.pump_target_temp_c = 0.0f;
     }
+
+    heater_on_ = out.heater_power_pct >= BoardConfig::SAFETY_STUCK_MIN_HEATER_PCT;
+    valve_on_ = out.valve_opening_pct >= BoardConfig::SAFETY_STUCK_MIN_VALVE_PCT;
+}
+
+SafetyManager::Stats SafetyManager::takeStats()
+{
+    Stats s;
+    s.active_mask = active_;
+    s.last_trip_mask = last_trip_mask_;
+    s.trips = trips_;
+    s.react_last_us = react_last_us_;
+    s.react_max_us = react_max_us_;
+    react_max_us_ = 0;
+    return s;
 }
@@ -5,17 +5,117 @@
 
 #include "../ctrl/ControlState.h"
 #include "../proto/Messages.h"
+#include "../proto/Protocol.h"
+#include "BoardConfig.h"
+
+// SafetyManager：
+// - 快速路径：传感器每取得一个新样本即调用 onTempSample()/onPressureSample()（后台轮询上下文），
+//   判定过温、温升速率、超压、测量故障（NaN/无效、读数卡死），新跳闸时立即调用关断回调，
+//   不等下一个控制节拍；从样本时间戳到关断完成的反应时间计入统计。
+// - 各条件按 K-of-N 表决置位，回到回滞阈值内的 N 个连续样本后才解除。
+// - 节拍路径 checkAndClamp()：链路超时判定；任一联锁条件成立期间强制 SAFE 并将输出归零。
 
 class SafetyManager {
 public:
+    // 联锁条件（位掩码，与诊断遥测一致）
+    static constexpr uint8_t TRIP_OVERTEMP    = Proto::SAFETY_TRIP_OVERTEMP;
+    static constexpr uint8_t TRIP_TEMP_RATE   = Proto::SAFETY_TRIP_TEMP_RATE;
+    static constexpr uint8_t TRIP_OVERPRESS   = Proto::SAFETY_TRIP_OVERPRESS;
+    static constexpr uint8_t TRIP_TEMP_FAULT  = Proto::SAFETY_TRIP_TEMP_FAULT;
+    static constexpr uint8_t TRIP_PRESS_FAULT = Proto::SAFETY_TRIP_PRESS_FAULT;
+
+    using ForceOffFn = void (*)(void *ctx);
+
+    struct Stats {
+        uint8_t  active_mask    = 0;  // 当前成立的联锁条件
+        uint8_t  last_trip_mask = 0;  // 最近一次跳闸新置位的条件
+        uint32_t trips          = 0;  // 累计跳闸次数
+        uint32_t react_last_us  = 0;  // 最近一次：样本时间戳 -> 输出关断完成
+        uint32_t react_max_us   = 0;  // 窗口内最大反应时间
+    };
+
     void begin();
 
+    // 关断回调：在快速路径上直接把执行器置零
+    void setForceOff(ForceOffFn fn, void *ctx)
+    {
+        force_off_ = fn;
+        force_off_ctx_ = ctx;
+    }
+
+    // 过温阈值（ConfigStore 现场配置；缺省 BoardConfig::SAFETY_MAX_TEMP_C）
+    void setMaxTempC(float max_temp_c) { max_temp_c_ = max_temp_c; }
+    float maxTempC() const { return max_temp_c_; }
+    // 超压 / 温升速率阈值（同上，缺省 SAFETY_MAX_PRESS_PA / SAFETY_MAX_RATE_C_PER_S）
+    void setMaxPressPa(float max_press_pa) { max_press_pa_ = max_press_pa; }
+    void setMaxRateCPerS(float max_rate) { max_rate_c_per_s_ = max_rate; }
+
+    // 快速路径；t_us 为样本取得时刻 micros()
+    void onTempSample(uint8_t ch, float temp_c, bool valid, uint32_t t_us);
+    // raw_code：ADS 原始码值（卡死判定用，未经零点钳位）
+    void onPressureSample(float pressure_pa, int16_t raw_code, bool valid, uint32_t t_us);
+
     // 根据安全条件调整模式/输出
     void checkAndClamp(ControlState &state,
                        const Proto::Telemetry &telem,
                        Proto::Outputs &out,
                        uint32_t now_ms);
 
+    uint8_t activeMask() const { return active_; }
+    uint32_t tripCount() const { return trips_; }
+
+    // 读取统计；窗口量（最大反应时间）读后清零
+    Stats takeStats();
+
 private:
-    float max_temp_c_ = 80.0f;  // 示例上限温度
+    // K-of-N 表决 + 回滞
+    struct VoteLatch {
+        uint8_t set_hist = 0;
+        uint8_t clr_hist = 0;
+        bool    on = false;
+
+        // beyond_set：越过跳闸阈值；beyond_clear：尚未回到解除阈值内。返回 true 表示本样本新置位
+        bool update(bool beyond_set, bool beyond_clear);
+    };
+
+    struct TempChannel {
+        VoteLatch over;
+        VoteLatch rate;
+        VoteLatch fault;
+        float    last_c = NAN;
+        uint32_t same_since_us = 0;
+        float    ref_c = NAN;          // 速率基线
+        uint32_t ref_us = 0;
+    };
+
+    struct PressChannel {
+        VoteLatch over;
+        VoteLatch fault;
+        float    last_code = NAN;
+        uint32_t same_since_us = 0;
+    };
+
+    static constexpr uint8_t kTempCount = BoardConfig::TEMP_SENSOR_COUNT;
+
+    float max_temp_c_ = BoardConfig::SAFETY_MAX_TEMP_C;
+    float max_press_pa_ = BoardConfig::SAFETY_MAX_PRESS_PA;
+    float max_rate_c_per_s_ = BoardConfig::SAFETY_MAX_RATE_C_PER_S;
+
+    TempChannel  temp_[kTempCount];
+    PressChannel press_;
+    bool heater_on_ = false;     // 上一节拍加热输出 ≥ SAFETY_STUCK_MIN_HEATER_PCT（卡死判定门控）
+    bool valve_on_ = false;      // 上一节拍阀门输出 ≥ SAFETY_STUCK_MIN_VALVE_PCT（测压卡死判定门控）
+
+    uint8_t  active_ = 0;
+    uint8_t  last_trip_mask_ = 0;
+    uint32_t trips_ = 0;
+    uint32_t react_last_us_ = 0;
+    uint32_t react_max_us_ = 0;
+
+    ForceOffFn force_off_ = nullptr;
+    void *force_off_ctx_ = nullptr;
+
+    static bool stuck(float v, float &last, uint32_t &since_us, uint32_t t_us, uint32_t limit_ms, bool armed);
+    void refreshActive();
+    void trip(uint8_t newly, uint32_t t_us);
 };
@@ -0,0 +1,106 @@
+// util/StageProfiler.cpp
+#include "StageProfiler.h"
+
+#if CTRL_PROFILE
+
+void StageProfiler::begin()
+{
+#if defined(NRF52840_XXAA)
+    // 打开跟踪单元并启动周期计数（调试器未连接时默认关闭）
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+    for (uint8_t i = 0; i < STAGE_COUNT; ++i) clear(hist_[i]);
+}
+
+uint8_t StageProfiler::cyclesPerUs()
+{
+#if defined(NRF52840_XXAA)
+    return static_cast<uint8_t>(SystemCoreClock / 1000000u);
+#else
+    return 1;
+#endif
+}
+
+void StageProfiler::clear(Hist &h)
+{
+    h.count = 0;
+    h.sum = 0;
+    h.min = 0xFFFFFFFFu;
+    h.max = 0;
+    for (uint8_t b = 0; b < BINS; ++b) h.bins[b] = 0;
+}
+
+// 1/4 倍频程：0..3 精确分箱；其余按最高位 + 其后 2 位，相对分辨率约 25 %
+uint8_t StageProfiler::binOf(uint32_t cyc)
+{
+    if (cyc < 4) return static_cast<uint8_t>(cyc);
+    const uint8_t msb = static_cast<uint8_t>(31 - __builtin_clz(cyc));
+    const uint32_t bin = (msb - 1u) * 4u + ((cyc >> (msb - 2u)) & 3u);
+    return (bin < BINS) ? static_cast<uint8_t>(bin) : static_cast<uint8_t>(BINS - 1);
+}
+
+uint32_t StageProfiler::binUpper(uint8_t bin)
+{
+    if (bin < 4) return bin;
+    const uint8_t msb = static_cast<uint8_t>(bin / 4 + 1);
+    const uint32_t sub = bin % 4u;
+    return ((5u + sub) << (msb - 2u)) - 1u;
+}
+
+void StageProfiler::record(uint8_t stage, uint32_t cyc)
+{
+    if (stage >= STAGE_COUNT) return;
+    Hist &h = hist_[stage];
+    ++h.count;
+    h.sum += cyc;
+    if (cyc < h.min) h.min = cyc;
+    if (cyc > h.max) h.max = cyc;
+    ++h.bins[binOf(cyc)];
+}
+
+void StageProfiler::takeStats(StageStats out[STAGE_COUNT])
+{
+    for (uint8_t i = 0; i < STAGE_COUNT; ++i) {
+        Hist &h = hist_[i];
+        StageStats &s = out[i];
+        s.count = h.count;
+        if (h.count == 0) {
+            s.min_cyc = s.mean_cyc = s.p99_cyc = s.max_cyc = 0;
+            continue;
+        }
+        s.min_cyc = h.min;
+        s.max_cyc = h.max;
+        s.mean_cyc = static_cast<uint32_t>(h.sum / h.count);
+
+        // 第一个累计数 >= ceil(0.99·count) 的分箱
+        const uint32_t target = h.count - (h.count / 100u);
+        uint32_t acc = 0;
+        uint8_t b = 0;
+        for (; b < BINS - 1; ++b) {
+            acc += h.bins[b];
+            if (acc >= target) break;
+        }
+        const uint32_t up = binUpper(b);
+        s.p99_cyc = (up < h.max) ? up : h.max;
+        if (s.p99_cyc < h.min) s.p99_cyc = h.min;
+
+        clear(h);
+    }
+}
+
+const char *StageProfiler::stageName(uint8_t stage)
+{
+    switch (stage) {
+    case SENSORS_POLL:    return "sensors_poll";
+    case LINK_POLL:       return "link_poll";
+    case SENSORS_READ:    return "sensors_read";
+    case MODE_COMPUTE:    return "mode_compute";
+    case SAFETY_CHECK:    return "safety_check";
+    case ACTUATORS_APPLY: return "actuators_apply";
+    default:              return "?";
+    }
+}
+
+#endif // CTRL_PROFILE
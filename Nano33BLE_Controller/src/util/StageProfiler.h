@@ -0,0 +1,96 @@
+// util/StageProfiler.h
+#pragma once
+
+#include <Arduino.h>
+
+#include "../proto/Protocol.h"
+
+#if defined(NRF52840_XXAA)
+#include <nrf.h>
+#endif
+
+// 控制循环分段耗时剖析（调试用）：
+// - nRF52840：Cortex-M4 DWT->CYCCNT 周期计数（64 MHz，分辨率 1 个周期，开销约十几个周期）
+// - 其他平台：退化为 micros()（cycles_per_us = 1）
+// - 每段一组固定直方图（1/4 倍频程分箱），统计窗口内 min/mean/max/p99；p99 取所在分箱上沿（偏保守）
+//
+// CTRL_PROFILE 为 0（默认）时 PROFILE_STAGE() 只展开为被测语句本身，
+// 剖析器对象、统计内存与上报代码全部不参与编译。可在此处改为 1，或由编译参数 -DCTRL_PROFILE=1 打开。
+#ifndef CTRL_PROFILE
+#define CTRL_PROFILE 0
+#endif
+
+#if CTRL_PROFILE
+#define PROFILE_STAGE(prof, stage, stmt)                                   \
+    do {                                                                   \
+        const uint32_t prof_t0_ = StageProfiler::cycles();                 \
+        stmt;                                                              \
+        (prof).record((stage), StageProfiler::cycles() - prof_t0_);        \
+    } while (0)
+#else
+#define PROFILE_STAGE(prof, stage, stmt) \
+    do {                                 \
+        stmt;                            \
+    } while (0)
+#endif
+
+class StageProfiler {
+public:
+    // 顺序与 PayloadProfileV1::stage[] 一致
+    enum Stage : uint8_t {
+        SENSORS_POLL = 0,   // 后台：ADS1115 样本轮询
+        LINK_POLL,          // 后台：串口收帧 + 发送队列
+        SENSORS_READ,       // 节拍：采集
+        MODE_COMPUTE,       // 节拍：控制计算
+        SAFETY_CHECK,       // 节拍：安全检查 + 钳制
+        ACTUATORS_APPLY,    // 节拍：执行输出
+        STAGE_COUNT
+    };
+
+    static_assert(STAGE_COUNT == Proto::PROFILE_STAGES, "stage list must match PayloadProfileV1");
+
+    struct StageStats {
+        uint32_t count;
+        uint32_t min_cyc;
+        uint32_t mean_cyc;
+        uint32_t p99_cyc;
+        uint32_t max_cyc;
+    };
+
+    static constexpr uint8_t BINS = 96;   // 覆盖到 2^25 周期（64 MHz 下约 0.5 s），更长的计入最后一箱
+
+    void begin();
+
+    static inline uint32_t cycles()
+    {
+#if defined(NRF52840_XXAA)
+        return DWT->CYCCNT;
+#else
+        return micros();
+#endif
+    }
+
+    static uint8_t cyclesPerUs();
+
+    void record(uint8_t stage, uint32_t cyc);
+
+    // 读取各段窗口统计并清零（out 至少 STAGE_COUNT 个）
+    void takeStats(StageStats out[STAGE_COUNT]);
+
+    static const char *stageName(uint8_t stage);
+
+private:
+    struct Hist {
+        uint32_t count;
+        uint64_t sum;
+        uint32_t min;
+        uint32_t max;
+        uint32_t bins[BINS];
+    };
+
+    Hist hist_[STAGE_COUNT];
+
+    static void clear(Hist &h);
+    static uint8_t binOf(uint32_t cyc);
+    static uint32_t binUpper(uint8_t bin);
+};
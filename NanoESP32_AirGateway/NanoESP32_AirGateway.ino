@@ -13,6 +13,8 @@
 #include "src/util/BoardConfig.h"
 #include "src/proto/FrameCodec.h"
 #include "src/proto/Protocol.h"
+#include "src/util/ClockSync.h"
+#include "src/util/Metrics.h"
 
 #include "src/lora/LoRaLink.h"
 
@@ -24,11 +26,22 @@ static uint32_t g_last_hb_ms = 0;
 // LoRa TX 采用“排队发送”以避免在 UART 解析过程中阻塞（LoRa.endPacket() 为阻塞调用）。
 // - 高优先级：ACK/关键上行（尽量不丢）
 // - 低优先级：遥测（允许覆盖/降采样）
+// - 最低优先级：诊断遥测 / 分段耗时（允许覆盖，更低频率，两者轮流占用同一时隙）
+// - DAQ 数据帧：只占用以上各类都没有到期时的空闲空口时间（允许覆盖，地面按采样序号识别丢帧）
 static uint8_t g_tx_hi_buf[256];
 static size_t  g_tx_hi_len = 0;
 static uint8_t g_tx_telem_buf[256];
 static size_t  g_tx_telem_len = 0;
 static uint32_t g_last_telem_lora_ms = 0;
+static uint8_t g_tx_diag_buf[128];
+static size_t  g_tx_diag_len = 0;
+static uint8_t g_tx_prof_buf[128];
+static size_t  g_tx_prof_len = 0;
+static bool    g_diag_turn_prof = false;
+static uint8_t g_tx_daq_buf[256];
+static size_t  g_tx_daq_len = 0;
+static uint32_t g_last_daq_lora_ms = 0;
+static uint32_t g_last_diag_lora_ms = 0;
 static uint32_t g_last_downlink_ms = 0;
 
 static bool g_lora_ok = false;
@@ -47,12 +60,58 @@ static uint32_t g_last_lora_rx_ms = 0;
 static char g_line_buf[128];
 static size_t g_line_len = 0;
 
+// 时间同步：
+// - 本机 ↔ 控制器（UART）：本机发起，估计“控制器时钟 − 本机时钟”，估计值随下一次请求交给控制器，
+//   由其填入遥测
+// - 地面 ↔ 本机（LoRa）：地面发起，本机只应答（收到时刻在 pollReceive 返回后立即记录，
+//   发出时刻在 sendEx 前记录）；应答在高优先级之后、遥测之前发送
+static ClockSync g_sync_ctrl;
+static uint32_t g_last_sync_ms = 0;
+static uint8_t  g_sync_id = 0;
+static Proto::PayloadTimeSyncV1 g_sync_reply;
+static uint8_t  g_sync_reply_seq = 0;
+static bool     g_sync_reply_pending = false;
+static uint32_t g_sync_lora_replies = 0;
+
+// 命令时延追踪：记录最近转发给控制器的下行帧（LoRa 收到 / 写入 UART 时刻）；控制器上报
+// MSG_CMD_TRACE 时按 msg_type + seq 查表补填本机时刻与时钟偏差，再经独立槽位上行（不占用高优先级槽，
+// 避免覆盖同一命令的 ACK）
+struct DownlinkStamp {
+    uint8_t  msg_type;
+    uint8_t  seq;
+    bool     valid;
+    uint32_t lora_rx_ms;
+    uint32_t uart_tx_ms;
+};
+static DownlinkStamp g_dl_stamps[4];
+static uint8_t g_dl_stamp_next = 0;
+static uint8_t g_tx_trace_buf[64];
+static size_t  g_tx_trace_len = 0;
+
+// 运行指标（util/Metrics.h）：地面 `metrics air` 经 LoRa 拉取，本机就地应答；
+// `metrics ctrl` 的请求转发给控制器。应答（本机/控制器）经独立槽位上行，不覆盖 ACK
+static uint8_t g_tx_metrics_buf[256];
+static size_t  g_tx_metrics_len = 0;
+
+static Metrics::Counter   g_m_lora_tx_ok("lora_tx_ok");
+static Metrics::Counter   g_m_lora_tx_busy("lora_tx_busy");
+static Metrics::Counter   g_m_lora_tx_fail("lora_tx_fail");
+static Metrics::Histogram g_m_lora_tx_ms("lora_tx_ms");
+static Metrics::Counter   g_m_lora_rx("lora_rx_pkts");
+static Metrics::Counter   g_m_dl_frames("dl_frames");
+static Metrics::Gauge     g_m_lora_rssi("lora_rssi", []() -> int32_t { return g_last_lora_rssi; });
+static Metrics::Counter   g_m_uart_dl_drop("uart_dl_drops");
+static Metrics::Counter   g_m_telem_ovw("telem_ovw");
+static Metrics::Gauge     g_m_sync_rtt("sync_rtt_ms", []() -> int32_t { return g_sync_ctrl.rttMs(); });
+static Metrics::Gauge     g_m_sync_drift("sync_drift", []() -> int32_t { return g_sync_ctrl.driftPpm(); });
+static Metrics::Histogram g_m_loop_us("loop_us");
+static uint32_t g_loop_last_us = 0;
+
 static Proto::PayloadManualCmdV1 g_man = {0, 0.0f, 0.0f, 0.0f};
 static Proto::PayloadSetpointsV1 g_sp  = {0.0f, 0.0f, 0.0f, 0.0f, 0};
 
 static uint32_t g_uart_busy_since_ms = 0;
 static uint32_t g_uart_last_warn_ms  = 0;
-static uint32_t g_uart_drop_downlink = 0;
 
 static bool uart1WriteDropIfBusy(const uint8_t* data, size_t len, const char* tag)
 {
@@ -60,7 +119,7 @@ static bool uart1WriteDropIfBusy(const uint8_t* data, size_t len, const char* ta
 
     const int avail = Serial1.availableForWrite();
     if (avail < (int)len) {
-        ++g_uart_drop_downlink;
+        g_m_uart_dl_drop.inc();
         const uint32_t now = millis();
 
         if (g_uart_busy_since_ms == 0) g_uart_busy_since_ms = now;
@@ -71,7 +130,7 @@ static bool uart1WriteDropIfBusy(const uint8_t* data, size_t len, const char* ta
             Serial.print("[UART] TX busy, drop downlink. tag=");
             Serial.print(tag);
             Serial.print(" drop=");
-            Serial.print(g_uart_drop_downlink);
+            Serial.print(g_m_uart_dl_drop.value());
             Serial.print(" avail=");
             Serial.print(avail);
             Serial.print(" need=");
@@ -105,16 +164,56 @@ static void sendHeartbeat(uint32_t now_ms)
     }
 }
 
+static void sendTimeSync(uint32_t now_ms)
+{
+    if (now_ms - g_last_sync_ms < BoardConfig::TIME_SYNC_UART_PERIOD_MS) return;
+    g_last_sync_ms = now_ms;
+
+    Proto::PayloadTimeSyncV1 p;
+    memset(&p, 0, sizeof(p));
+    p.id = ++g_sync_id;
+    if (g_sync_ctrl.valid(now_ms, BoardConfig::TIME_SYNC_VALID_MS)) {
+        p.synced    = 1;
+        p.drift_ppm = g_sync_ctrl.driftPpm();
+        p.offset_ms = g_sync_ctrl.offsetAt(now_ms);
+        p.rtt_ms    = g_sync_ctrl.rttMs();
+    }
+    p.t1_ms = millis();
+    uartSend(Proto::MSG_TIME_SYNC, &p, sizeof(p));
+}
+
+static void fillCmdTrace(const FrameCodec::FrameView &f)
+{
+    Proto::PayloadCmdTraceV1 t;
+    memcpy(&t, f.payload, sizeof(t));
+    for (const DownlinkStamp &s : g_dl_stamps) {
+        if (s.valid && s.msg_type == t.msg_type && s.seq == f.seq) {
+            t.air_lora_rx_ms = s.lora_rx_ms;
+            t.air_uart_tx_ms = s.uart_tx_ms;
+            t.flags |= Proto::TRACE_FLAG_AIR;
+            break;
+        }
+    }
+    const uint32_t now = millis();
+    if (g_sync_ctrl.valid(now, BoardConfig::TIME_SYNC_VALID_MS)) {
+        t.ctrl_air_offset_ms = g_sync_ctrl.offsetAt(now);
+        t.flags |= Proto::TRACE_FLAG_CTRL_SYNCED;
+    }
+    g_tx_trace_len = FrameCodec::encode(Proto::MSG_CMD_TRACE, f.seq,
+                                        reinterpret_cast<const uint8_t*>(&t), sizeof(t),
+                                        g_tx_trace_buf, sizeof(g_tx_trace_buf));
+}
+
 static void printHelp()
 {
     Serial.println("Commands:");
     Serial.println("  help");
     Serial.println("  status");
-    Serial.println("  mode safe|manual|auto");
+    Serial.println("  mode safe|manual|auto|autotune");
     Serial.println("  set heater <0-100>");
     Serial.println("  set valve <0-100>");
-    Serial.println("  set T <degC>            (setpoint, reserved for future auto)");
-    Serial.println("  set P <Pa>              (setpoint, reserved for future auto)");
+    Serial.println("  set T <degC>            (setpoint, AUTO temp loop)");
+    Serial.println("  set P <Pa>              (setpoint, AUTO pressure loop)");
     Serial.println("  set valve_sp <0-100>    (setpoint)");
     Serial.println("  lora stat");
     Serial.println("  lora raw on|off        (print any LoRa packet, disable downlink forwarding)");
@@ -148,6 +247,23 @@ static void printStatus()
         Serial.println(g_last_lora_snr);
     }
 
+    Serial.print("Sync ctrl: ");
+    const uint32_t now = millis();
+    if (g_sync_ctrl.valid(now, BoardConfig::TIME_SYNC_VALID_MS)) {
+        Serial.print("offset_ms=");
+        Serial.print(g_sync_ctrl.offsetAt(now));
+        Serial.print(" rtt_ms=");
+        Serial.print(g_sync_ctrl.rttMs());
+        Serial.print(" drift_ppm=");
+        Serial.print(g_sync_ctrl.driftPpm());
+    } else {
+        Serial.print("(not synced)");
+    }
+    Serial.print(" samples=");
+    Serial.print(g_sync_ctrl.samples());
+    Serial.print(" lora_replies=");
+    Serial.println(g_sync_lora_replies);
+
     Serial.print("Log: ");
     Serial.print(g_verbose ? "on" : "off");
     Serial.print("  TELEM: ");
@@ -322,6 +438,7 @@ Serial.println("Usage: debug on|off  OR  debug telem on|off  OR  debug lora on|o
         if (strcmp(arg, "safe") == 0)   p.mode = Proto::MODE_SAFE;
         else if (strcmp(arg, "manual") == 0) p.mode = Proto::MODE_MANUAL;
         else if (strcmp(arg, "auto") == 0)   p.mode = Proto::MODE_AUTO;
+        else if (strcmp(arg, "autotune") == 0) p.mode = Proto::MODE_AUTOTUNE;
         else {
             Serial.println("ERR: unknown mode");
             return;
@@ -390,6 +507,27 @@ Serial.println("Usage: debug on|off  OR  debug telem on|off  OR  debug lora on|o
     Serial.println("ERR: unknown command (try: help)");
 }
 
+// V2/V3 遥测共用的 8 路打印（V3 追加的程序状态不在此输出）
+template <typename Telem>
+static void printTelem8(const Telem &t)
+{
+    Serial.print("[TELEM] t=");
+    Serial.print(t.timestamp_ms);
+    const uint8_t nT = (t.temp_count > 8) ? 8 : t.temp_count;
+    for (uint8_t i = 0; i < nT; ++i) {
+        Serial.print(" T");
+        Serial.print(i);
+        Serial.print("=");
+        Serial.print(t.temp_c[i]);
+    }
+    Serial.print(" P(Pa)=");
+    Serial.print(t.pressure_pa);
+    Serial.print(" heater=%=");
+    Serial.print(t.heater_power_pct);
+    Serial.print(" valve=%=");
+    Serial.println(t.valve_opening_pct);
+}
+
 static void handleUartRx()
 {
     int budget = 256;  // 每轮最多处理 256 字节，留时间给 LoRa/其他任务
@@ -397,19 +535,55 @@ static void handleUartRx()
         uint8_t b = static_cast<uint8_t>(Serial1.read());
         FrameCodec::FrameView f;
         if (g_parser.feed(b, f)) {
+            // 0) 时间同步应答：本机发起的交换，就地完成，不转发
+            if (f.msg_type == Proto::MSG_TIME_SYNC_REPLY) {
+                const uint32_t t4 = millis();
+                Proto::PayloadTimeSyncV1 r;
+                if (f.payload_len == sizeof(r)) {
+                    memcpy(&r, f.payload, sizeof(r));
+                    if (r.id == g_sync_id) g_sync_ctrl.addSample(r.t1_ms, r.t2_ms, r.t3_ms, t4);
+                }
+                continue;
+            }
+            if (f.msg_type == Proto::MSG_CMD_TRACE) {
+                if (f.payload_len == sizeof(Proto::PayloadCmdTraceV1)) fillCmdTrace(f);
+                continue;
+            }
+
             // 1) UART->LoRa：将 Nano33BLE 的帧重新编码后排队，避免在 UART 接收路径上阻塞。
             //    - ACK：高优先级
-            //    - TELEM：低优先级（覆盖旧数据，按周期发）
-            //    - 其他：高优先级（例如未来的错误/事件上报）
+            //    - TELEM（V1/V2/V3）：低优先级（覆盖旧数据，按周期发）
+            //    - DIAG：最低优先级（覆盖旧数据，更低频率）
+            //    - DAQ：空闲时发送（覆盖旧数据）
+            //    - 运行指标：独立槽位（覆盖旧数据，地面超时重取）
+            //    - 其他：高优先级（ACK、自整定结果、高速捕获状态/分块等应答）
             {
                 uint8_t pkt[256];
                 const size_t n = FrameCodec::encode(f.msg_type, f.seq,
                                                     f.payload, f.payload_len,
                                                     pkt, sizeof(pkt));
                 if (n) {
-                    if (f.msg_type == Proto::MSG_TELEM_V1) {
+                    if (f.msg_type == Proto::MSG_TELEM_V1 || f.msg_type == Proto::MSG_TELEM_V2 ||
+                        f.msg_type == Proto::MSG_TELEM_V3) {
+                        if (g_tx_telem_len > 0) g_m_telem_ovw.inc();
                         memcpy(g_tx_telem_buf, pkt, n);
                         g_tx_telem_len = n;
+                    } else if (f.msg_type == Proto::MSG_TELEM_DIAG_V1) {
+                        if (n <= sizeof(g_tx_diag_buf)) {
+                            memcpy(g_tx_diag_buf, pkt, n);
+                            g_tx_diag_len = n;
+                        }
+                    } else if (f.msg_type == Proto::MSG_PROFILE_V1) {
+                        if (n <= sizeof(g_tx_prof_buf)) {
+                            memcpy(g_tx_prof_buf, pkt, n);
+                            g_tx_prof_len = n;
+                        }
+                    } else if (f.msg_type == Proto::MSG_DAQ_V1) {
+                        memcpy(g_tx_daq_buf, pkt, n);
+                        g_tx_daq_len = n;
+                    } else if (f.msg_type == Proto::MSG_METRICS_V1) {
+                        memcpy(g_tx_metrics_buf, pkt, n);
+                        g_tx_metrics_len = n;
                     } else {
                         // 若连续产生多个高优先级帧，保留最新一帧即可（ACK 典型为对控制命令的响应）。
                         memcpy(g_tx_hi_buf, pkt, n);
@@ -447,6 +621,17 @@ static void handleUartRx()
                     Serial.print(" valve=%=");
                     Serial.println(t.valve_opening_pct);
                 }
+            } else if (f.msg_type == Proto::MSG_TELEM_V2 && f.payload_len == sizeof(Proto::PayloadTelemetryV2)) {
+                Proto::PayloadTelemetryV2 t;
+                memcpy(&t, f.payload, sizeof(t));
+                if (g_verbose_telem) printTelem8(t);
+            } else if (f.msg_type == Proto::MSG_TELEM_V3 && f.payload_len == sizeof(Proto::PayloadTelemetryV3)) {
+                Proto::PayloadTelemetryV3 t;
+                memcpy(&t, f.payload, sizeof(t));
+                if (g_verbose_telem) printTelem8(t);
+            } else if (f.msg_type == Proto::MSG_TELEM_DIAG_V1 || f.msg_type == Proto::MSG_PROFILE_V1 ||
+                       f.msg_type == Proto::MSG_DAQ_V1 || f.msg_type == Proto::MSG_METRICS_V1) {
+                // 诊断遥测 / 分段耗时 / DAQ / 运行指标仅转发，不在 USB 上打印（避免刷屏）
             } else {
                 Serial.print("[RX] msg=0x");
                 Serial.print(f.msg_type, HEX);
@@ -457,6 +642,22 @@ static void handleUartRx()
     }
 }
 
+// LoRa 发送：统计结果与阻塞时长（endPacket 期间主循环停顿）
+static LoRaLink::TxResult loraTx(const uint8_t *buf, size_t len)
+{
+    const uint32_t t0 = millis();
+    const LoRaLink::TxResult txr = LoRaLink::sendEx(buf, len);
+    if (txr == LoRaLink::TxResult::OK) {
+        g_m_lora_tx_ok.inc();
+        g_m_lora_tx_ms.record(millis() - t0);
+    } else if (txr == LoRaLink::TxResult::BUSY) {
+        g_m_lora_tx_busy.inc();
+    } else {
+        g_m_lora_tx_fail.inc();
+    }
+    return txr;
+}
+
 static void serviceLoRaTx(uint32_t now_ms)
 {
     if (!g_lora_ok) return;
@@ -475,7 +676,7 @@ static void serviceLoRaTx(uint32_t now_ms)
             return;
         }
         logLoRaTx("HI", g_tx_hi_buf, g_tx_hi_len);
-        const LoRaLink::TxResult txr = LoRaLink::sendEx(g_tx_hi_buf, g_tx_hi_len);
+        const LoRaLink::TxResult txr = loraTx(g_tx_hi_buf, g_tx_hi_len);
         if (txr == LoRaLink::TxResult::OK) {
             g_tx_hi_len = 0;
         } else if (g_debug_lora_tx) {
@@ -485,6 +686,52 @@ static void serviceLoRaTx(uint32_t now_ms)
         return;
     }
 
+    // 1.5) 地面发起的时间同步应答：t3 在发送前记录
+    if (g_sync_reply_pending) {
+        g_sync_reply.t3_ms = millis();
+        uint8_t pkt[64];
+        const size_t n = FrameCodec::encode(Proto::MSG_TIME_SYNC_REPLY, g_sync_reply_seq,
+                                            reinterpret_cast<const uint8_t*>(&g_sync_reply),
+                                            sizeof(g_sync_reply), pkt, sizeof(pkt));
+        logLoRaTx("SYNC", pkt, n);
+        const LoRaLink::TxResult txr = n ? loraTx(pkt, n) : LoRaLink::TxResult::FAIL;
+        // 失败不重试：t2 已过期，地面下一轮重新发起
+        g_sync_reply_pending = false;
+        if (txr == LoRaLink::TxResult::OK) {
+            ++g_sync_lora_replies;
+        } else if (g_debug_lora_tx) {
+            Serial.print("[LORA][TX] SYNC send ");
+            Serial.println(txr == LoRaLink::TxResult::BUSY ? "BUSY" : "FAIL");
+        }
+        return;
+    }
+
+    // 1.6) 命令时延追踪记录（不覆盖 ACK，单独排在高优先级之后）
+    if (g_tx_trace_len > 0) {
+        logLoRaTx("TRACE", g_tx_trace_buf, g_tx_trace_len);
+        const LoRaLink::TxResult txr = loraTx(g_tx_trace_buf, g_tx_trace_len);
+        if (txr == LoRaLink::TxResult::OK) {
+            g_tx_trace_len = 0;
+        } else if (g_debug_lora_tx) {
+            Serial.print("[LORA][TX] TRACE send ");
+            Serial.println(txr == LoRaLink::TxResult::BUSY ? "BUSY" : "FAIL");
+        }
+        return;
+    }
+
+    // 1.7) 运行指标应答（地面按需拉取，独立槽位）
+    if (g_tx_metrics_len > 0) {
+        logLoRaTx("METRICS", g_tx_metrics_buf, g_tx_metrics_len);
+        const LoRaLink::TxResult txr = loraTx(g_tx_metrics_buf, g_tx_metrics_len);
+        if (txr == LoRaLink::TxResult::OK) {
+            g_tx_metrics_len = 0;
+        } else if (g_debug_lora_tx) {
+            Serial.print("[LORA][TX] METRICS send ");
+            Serial.println(txr == LoRaLink::TxResult::BUSY ? "BUSY" : "FAIL");
+        }
+        return;
+    }
+
     // 2) 低优先级遥测：降采样
     if (!suppress_telem && g_tx_telem_len > 0) {
         if (now_ms - g_last_telem_lora_ms >= BoardConfig::LORA_TELEM_PERIOD_MS) {
@@ -498,7 +745,7 @@ static void serviceLoRaTx(uint32_t now_ms)
                 g_tx_telem_len = 0;
                 return;
             }
-            const LoRaLink::TxResult txr = LoRaLink::sendEx(g_tx_telem_buf, g_tx_telem_len);
+            const LoRaLink::TxResult txr = loraTx(g_tx_telem_buf, g_tx_telem_len);
             if (txr == LoRaLink::TxResult::OK) {
                 g_last_telem_lora_ms = now_ms;
                 // 遥测允许被覆盖：仅在发送成功后清空；失败时保留，下一轮继续尝试或被新遥测覆盖。
@@ -507,6 +754,40 @@ static void serviceLoRaTx(uint32_t now_ms)
                 Serial.print("[LORA][TX] TELEM send ");
                 Serial.println(txr == LoRaLink::TxResult::BUSY ? "BUSY" : "FAIL");
             }
+            return;
+        }
+    }
+
+    // 3) 诊断遥测 / 分段耗时：更低频率；本轮已尝试发送常规遥测时不再发送；两者都待发时轮流
+    if (!suppress_telem && (g_tx_diag_len > 0 || g_tx_prof_len > 0)) {
+        if (now_ms - g_last_diag_lora_ms >= BoardConfig::LORA_DIAG_PERIOD_MS) {
+            const bool prof = (g_tx_prof_len > 0) && (g_tx_diag_len == 0 || g_diag_turn_prof);
+            const uint8_t *buf = prof ? g_tx_prof_buf : g_tx_diag_buf;
+            size_t &len = prof ? g_tx_prof_len : g_tx_diag_len;
+            logLoRaTx(prof ? "PROF" : "DIAG", buf, len);
+            const LoRaLink::TxResult txr = loraTx(buf, len);
+            if (txr == LoRaLink::TxResult::OK) {
+                g_last_diag_lora_ms = now_ms;
+                len = 0;
+                g_diag_turn_prof = !prof;
+            } else if (g_debug_lora_tx) {
+                Serial.print(prof ? "[LORA][TX] PROF send " : "[LORA][TX] DIAG send ");
+                Serial.println(txr == LoRaLink::TxResult::BUSY ? "BUSY" : "FAIL");
+            }
+            return;
+        }
+    }
+
+    // 4) DAQ：其余各类都未到期时发送，帧间留出下行间隙
+    if (!suppress_telem && g_tx_daq_len > 0 && now_ms - g_last_daq_lora_ms >= BoardConfig::LORA_DAQ_MIN_GAP_MS) {
+        logLoRaTx("DAQ", g_tx_daq_buf, g_tx_daq_len);
+        const LoRaLink::TxResult txr = loraTx(g_tx_daq_buf, g_tx_daq_len);
+        if (txr == LoRaLink::TxResult::OK) {
+            g_last_daq_lora_ms = now_ms;
+            g_tx_daq_len = 0;
+        } else if (g_debug_lora_tx) {
+            Serial.print("[LORA][TX] DAQ send ");
+            Serial.println(txr == LoRaLink::TxResult::BUSY ? "BUSY" : "FAIL");
         }
     }
 }
@@ -521,6 +802,31 @@ static bool isAllowedDownlink(uint8_t msg_type, uint8_t payload_len)
         return (payload_len == sizeof(Proto::PayloadManualCmdV1));
     case Proto::MSG_SETPOINTS_V1:
         return (payload_len == sizeof(Proto::PayloadSetpointsV1));
+    case Proto::MSG_CAPTURE_CMD:
+        return (payload_len == sizeof(Proto::PayloadCaptureCmd));
+    case Proto::MSG_PROGRAM_V1:
+        // 变长：头 + 整数个程序段（段数上限由控制器校验）
+        return (payload_len >= sizeof(Proto::PayloadProgramV1)) &&
+               ((payload_len - sizeof(Proto::PayloadProgramV1)) % sizeof(Proto::ProgramSegmentV1) == 0);
+    case Proto::MSG_PROGRAM_CTRL:
+        return (payload_len == sizeof(Proto::PayloadProgramCtrl));
+    case Proto::MSG_CONFIG_CMD:
+        return (payload_len == sizeof(Proto::PayloadConfigCmd));
+    case Proto::MSG_DAQ_CMD:
+        // 变长：头 + 至多 DAQ_MAX_VARS 个变量 id
+        return (payload_len >= sizeof(Proto::PayloadDaqCmdV1)) &&
+               (payload_len - sizeof(Proto::PayloadDaqCmdV1) <= Proto::DAQ_MAX_VARS);
+    case Proto::MSG_PARAM_BATCH:
+        // 变长：头 + 至多 PARAM_BATCH_MAX 项（id 或 id+value）
+        return (payload_len >= sizeof(Proto::PayloadParamBatchV1)) &&
+               (payload_len - sizeof(Proto::PayloadParamBatchV1) <=
+                Proto::PARAM_BATCH_MAX * sizeof(Proto::ParamSetItemV1));
+    case Proto::MSG_TIME_SYNC:
+        // 本机应答，不转发给控制器
+        return (payload_len == sizeof(Proto::PayloadTimeSyncV1));
+    case Proto::MSG_METRICS_CMD:
+        // node = AIR 本机应答，node = CTRL 转发
+        return (payload_len == sizeof(Proto::PayloadMetricsCmdV1));
     case Proto::MSG_HEARTBEAT:
         return (payload_len == 0);
     default:
@@ -561,11 +867,29 @@ static void logLoRaTx(const char* tag, const uint8_t* buf, size_t len)
     }
 }
 
+// 本机运行指标：快照/目录分块编码后放入指标槽位
+static void handleMetricsCmd(const Proto::PayloadMetricsCmdV1 &req, uint8_t seq)
+{
+    uint8_t payload[FrameCodec::MAX_PAYLOAD];
+    uint8_t len = 0;
+    if (req.op == Proto::METRICS_OP_SNAPSHOT) {
+        len = Metrics::encodeSnapshot(req.node, req.first, payload, sizeof(payload));
+    } else if (req.op == Proto::METRICS_OP_CATALOG) {
+        len = Metrics::encodeCatalog(req.node, req.first, payload, sizeof(payload));
+    }
+    if (len == 0) return;
+    const size_t n = FrameCodec::encode(Proto::MSG_METRICS_V1, seq, payload, len,
+                                        g_tx_metrics_buf, sizeof(g_tx_metrics_buf));
+    if (n) g_tx_metrics_len = n;
+}
+
 static void handleLoRaRx()
 {
     uint8_t buf[256];
     LoRaLink::RxPacket rx;
     if (!LoRaLink::pollReceive(buf, sizeof(buf), rx)) return;
+    const uint32_t rx_ms = millis();
+    g_m_lora_rx.inc();
 
     // 无论是否能解析出合法帧，都至少打印一条“收到 LoRa 包”的摘要，避免误以为完全没收到。
     if (g_verbose) {
@@ -604,11 +928,42 @@ static void handleLoRaRx()
             if (!isAllowedDownlink(f.msg_type, f.payload_len)) {
                 continue;
             }
+            if (f.msg_type == Proto::MSG_TIME_SYNC) {
+                Proto::PayloadTimeSyncV1 req;
+                memcpy(&req, f.payload, sizeof(req));
+                memset(&g_sync_reply, 0, sizeof(g_sync_reply));
+                g_sync_reply.id    = req.id;
+                g_sync_reply.t1_ms = req.t1_ms;
+                g_sync_reply.t2_ms = rx_ms;
+                g_sync_reply_seq = f.seq;
+                g_sync_reply_pending = true;
+                ++forwarded;
+                continue;
+            }
+            if (f.msg_type == Proto::MSG_METRICS_CMD) {
+                Proto::PayloadMetricsCmdV1 req;
+                memcpy(&req, f.payload, sizeof(req));
+                if (req.node == Proto::METRICS_NODE_AIR) {
+                    handleMetricsCmd(req, f.seq);
+                    ++forwarded;
+                    continue;
+                }
+                if (req.node != Proto::METRICS_NODE_CTRL) continue;
+            }
             // 重新编码为标准帧（避免将 LoRa 包中的前导噪声一并转发）
             uint8_t pkt[256];
             const size_t n = FrameCodec::encode(f.msg_type, f.seq, f.payload, f.payload_len, pkt, sizeof(pkt));
             if (n) {
-                uart1WriteDropIfBusy(pkt, n, "LORA->BLE");
+                if (uart1WriteDropIfBusy(pkt, n, "LORA->BLE")) {
+                    DownlinkStamp &s = g_dl_stamps[g_dl_stamp_next];
+                    g_dl_stamp_next = (uint8_t)((g_dl_stamp_next + 1) % (sizeof(g_dl_stamps) / sizeof(g_dl_stamps[0])));
+                    s.msg_type = f.msg_type;
+                    s.seq = f.seq;
+                    s.valid = true;
+                    s.lora_rx_ms = rx_ms;
+                    s.uart_tx_ms = millis();
+                    g_m_dl_frames.inc();
+                }
                 ++forwarded;
             }
         }
@@ -679,8 +1034,13 @@ void loop()
 {
     const uint32_t now_ms = millis();
 
-    // 1) 周期心跳
+    const uint32_t now_us = micros();
+    if (g_loop_last_us != 0) g_m_loop_us.record(now_us - g_loop_last_us);
+    g_loop_last_us = now_us;
+
+    // 1) 周期心跳 / 时间同步
     sendHeartbeat(now_ms);
+    sendTimeSync(now_ms);
 
     // 2) UART 接收遥测/ACK（不在此路径上做 LoRa 发送）
     handleUartRx();
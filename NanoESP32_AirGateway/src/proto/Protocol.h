@@ -7,23 +7,70 @@ namespace Proto {
 
 // 与《程序总体架构.pdf》保持一致的 MsgType 基本分配：
 // - 0x01: Telemetry
+// - 0x02: Telemetry diagnostics（低频运行状态）
+// - 0x03: Telemetry V2（最多 8 路温度；旧固件在温度通道 > 4 时代替 0x01）
+// - 0x04: Profile（控制循环分段耗时，可选，仅 CTRL_PROFILE 固件发送）
+// - 0x05: DAQ data（按订阅列表打包的变量采样，上行，变长）
+// - 0x06: Telemetry V3（8 路温度 + 设定值程序状态 + 时钟偏差；新固件只发此类型，V1/V2 布局冻结）
 // - 0x10: ModeSwitch
 // - 0x11: Setpoints
 // - 0x12: ManualCmd
+// - 0x13: Capture command（高速捕获：查询/触发/重新布防/分块读取，下行）
+// - 0x14: Setpoint program（设定值程序上传，下行，需 ACK）
+// - 0x15: Program control（程序启动/停止/暂停/继续，下行，需 ACK）
+// - 0x16: Config command（配置参数读/写/提交/恢复缺省/重新装载，下行）
+// - 0x17: DAQ command（DAQ 订阅/启停/目录查询，下行，变长）
+// - 0x18: Param batch（批量参数读/暂存/提交/回滚，下行，变长）
+// - 0x19: Time sync（时间同步请求，逐跳使用）
+// - 0x1A: Metrics command（运行指标快照/目录请求，下行）
 // - 0x20: ACK
 // - 0x23: Heartbeat
+// - 0x30: Autotune result（自整定结果，上行）
+// - 0x31: Capture info（捕获状态，上行）
+// - 0x32: Capture chunk（捕获记录分块，上行）
+// - 0x33: Config value（配置命令应答，上行）
+// - 0x34: DAQ status（DAQ 订阅状态/命令应答，上行）
+// - 0x35: DAQ catalog（DAQ 变量目录分块，上行，变长）
+// - 0x36: Param reply（批量参数应答，上行，变长）
+// - 0x37: Time sync reply（时间同步应答）
+// - 0x38: Command trace（命令时延追踪记录，上行）
+// - 0x39: Metrics（运行指标快照/目录分块，上行，变长）
 
 static constexpr uint8_t MSG_TELEM_V1      = 0x01;
+static constexpr uint8_t MSG_TELEM_DIAG_V1 = 0x02;
+static constexpr uint8_t MSG_TELEM_V2      = 0x03;
+static constexpr uint8_t MSG_PROFILE_V1    = 0x04;
+static constexpr uint8_t MSG_DAQ_V1        = 0x05;
+static constexpr uint8_t MSG_TELEM_V3      = 0x06;
 static constexpr uint8_t MSG_MODE_SWITCH   = 0x10;
 static constexpr uint8_t MSG_SETPOINTS_V1  = 0x11;
 static constexpr uint8_t MSG_MANUAL_CMD_V1 = 0x12;
+static constexpr uint8_t MSG_CAPTURE_CMD   = 0x13;
+static constexpr uint8_t MSG_PROGRAM_V1    = 0x14;
+static constexpr uint8_t MSG_PROGRAM_CTRL  = 0x15;
+static constexpr uint8_t MSG_CONFIG_CMD    = 0x16;
+static constexpr uint8_t MSG_DAQ_CMD       = 0x17;
+static constexpr uint8_t MSG_PARAM_BATCH   = 0x18;
+static constexpr uint8_t MSG_TIME_SYNC     = 0x19;
+static constexpr uint8_t MSG_METRICS_CMD   = 0x1A;
 static constexpr uint8_t MSG_ACK           = 0x20;
 static constexpr uint8_t MSG_HEARTBEAT     = 0x23;
+static constexpr uint8_t MSG_AUTOTUNE_RESULT = 0x30;
+static constexpr uint8_t MSG_CAPTURE_INFO  = 0x31;
+static constexpr uint8_t MSG_CAPTURE_CHUNK = 0x32;
+static constexpr uint8_t MSG_CONFIG_VALUE  = 0x33;
+static constexpr uint8_t MSG_DAQ_STATUS    = 0x34;
+static constexpr uint8_t MSG_DAQ_CATALOG   = 0x35;
+static constexpr uint8_t MSG_PARAM_REPLY   = 0x36;
+static constexpr uint8_t MSG_TIME_SYNC_REPLY = 0x37;
+static constexpr uint8_t MSG_CMD_TRACE     = 0x38;
+static constexpr uint8_t MSG_METRICS_V1    = 0x39;
 
 // 控制模式值（payload 中使用）
 static constexpr uint8_t MODE_SAFE   = 0;
 static constexpr uint8_t MODE_MANUAL = 1;
 static constexpr uint8_t MODE_AUTO   = 2;
+static constexpr uint8_t MODE_AUTOTUNE = 3;
 
 // ACK status
 static constexpr uint8_t ACK_OK  = 0;
@@ -48,7 +95,7 @@ struct PayloadManualCmdV1 {
     float pump_target_temp_c;
 };
 
-// Setpoints: 当前阶段仅保留字段（自动控制未实现，但保留协议/文件）
+// Setpoints: AUTO 模式使用；enable_mask 对应位为 1 时该闭环生效
 struct PayloadSetpointsV1 {
     float target_temp_c;
     float target_pressure_pa;
@@ -67,8 +114,461 @@ struct PayloadTelemetryV1 {
     float    valve_opening_pct;
 };
 
+// Telemetry V2：字段同 V1，温度扩展到 8 路（temp_count 之后的通道填 0）
+struct PayloadTelemetryV2 {
+    uint32_t timestamp_ms;
+    uint8_t  temp_count;   // <=8
+    float    temp_c[8];
+    float    pressure_pa;
+    float    heater_power_pct;
+    float    valve_opening_pct;
+};
+
+// Telemetry V3：V2 字段之后追加设定值程序状态与时钟偏差（V1/V2 布局保持不变，供旧固件解析）
+struct PayloadTelemetryV3 {
+    uint32_t timestamp_ms;
+    uint8_t  temp_count;   // <=8
+    float    temp_c[8];
+    float    pressure_pa;
+    float    heater_power_pct;
+    float    valve_opening_pct;
+    // 设定值程序：状态 PROGRAM_*、当前段（0 起）、段内已执行时间，以及本拍生效的设定值
+    uint8_t  prog_state;
+    uint8_t  prog_segment;
+    uint32_t prog_seg_elapsed_ms;
+    float    sp_temp_c;
+    float    sp_pressure_pa;
+    // 时间同步：空中端估计的“控制器时钟 − 空中端时钟”（ms），clock_synced = 0 时无效
+    int32_t  clock_offset_ms;
+    uint8_t  clock_synced;
+};
+
+// 诊断遥测：控制节拍时序等运行状态（低频发送，时间量单位 us，超出 uint16 时饱和）
+struct PayloadTelemDiagV1 {
+    uint32_t timestamp_ms;
+    uint32_t ctrl_period_us;
+    uint32_t ctrl_ticks;
+    uint32_t ctrl_overruns;
+    uint16_t ctrl_jitter_max_us;
+    uint16_t ctrl_jitter_avg_us;
+    uint16_t ctrl_exec_max_us;
+    // 阀门 TPC：指令开度与窗口内完整周期的实测占空比（单位 0.01 %）
+    uint16_t valve_cmd_cpct;
+    uint16_t valve_duty_cpct;
+    // 快速安全联锁：当前成立条件 / 最近跳闸原因（SAFETY_TRIP_*）、累计跳闸次数、样本→关断反应时间
+    uint8_t  safety_active;
+    uint8_t  safety_last_trip;
+    uint16_t safety_trips;
+    uint16_t safety_react_last_us;
+    uint16_t safety_react_max_us;
+    // 控制板串口发送队列：当前/窗口内最大待发字节、高优先级丢帧数、遥测/诊断被覆盖帧数（累计）
+    uint16_t uart_txq_bytes;
+    uint16_t uart_txq_max;
+    uint16_t uart_tx_drops;
+    uint16_t uart_telem_overwrites;
+    uint16_t uart_diag_overwrites;
+};
+
+// 自整定结果：status 见 TUNE_*；增益对应温度环 PID（单位同 BoardConfig::TEMP_PID_*）
+struct PayloadAutotuneResultV1 {
+    uint8_t status;
+    uint8_t cycles;
+    float   amplitude_c;
+    float   ku;
+    float   tu_s;
+    float   kp;
+    float   ki;
+    float   kd;
+};
+
+// 高速捕获命令：op 见 CAPTURE_OP_*；index 仅 READ 使用（记录序号，0 = 最早）
+struct PayloadCaptureCmd {
+    uint8_t  op;
+    uint16_t index;
+};
+
+// 捕获状态：state 见 CAPTURE_*，reason 见 CAPTURE_REASON_*；
+// count 为可读记录数（READY 时有效），其中前 pre_count 条在触发之前
+struct PayloadCaptureInfoV1 {
+    uint8_t  state;
+    uint8_t  reason;
+    uint16_t capture_id;
+    uint16_t count;
+    uint16_t pre_count;
+    uint16_t period_us;
+    uint8_t  record_size;
+    uint32_t trigger_ms;
+};
+
+// 捕获记录（每控制节拍一条，定点）：
+// t_ms 为 millis() 低 16 位；温度 0.01 °C，8 路与遥测 temp_c[8] 对应（未接/无效为 INT16_MIN）；
+// 压力 10 Pa（0xFFFF = 无效）；输出为实际生效值 0.01 %；mode 为 MODE_*；safety 为 SAFETY_TRIP_* 位掩码
+struct CaptureRecordV1 {
+    uint16_t t_ms;
+    int16_t  temp_cc[8];
+    uint16_t pressure_dapa;
+    uint16_t heater_cpct;
+    uint16_t valve_cpct;
+    uint8_t  mode;
+    uint8_t  safety;
+};
+
+// 捕获分块：count 条记录紧随其后（变长，最多 CAPTURE_CHUNK_RECORDS 条）
+struct PayloadCaptureChunkV1 {
+    uint16_t capture_id;
+    uint16_t index;
+    uint8_t  count;
+};
+
+// 控制循环分段耗时（单位 CPU 周期，除以 cycles_per_us 得 us）；count 为窗口内样本数（饱和）
+struct ProfileStageV1 {
+    uint16_t count;
+    uint32_t min_cyc;
+    uint32_t mean_cyc;
+    uint32_t p99_cyc;
+    uint32_t max_cyc;
+};
+
+// stage[] 顺序：sensors_poll, link_poll, sensors_read, mode_compute, safety_check, actuators_apply
+struct PayloadProfileV1 {
+    uint32_t timestamp_ms;
+    uint8_t  cycles_per_us;
+    uint8_t  stage_count;
+    ProfileStageV1 stage[6];
+};
+
+// 设定值程序段：type 见 PROGRAM_SEG_*；enable_mask 为本段驱动的通道（SP_ENABLE_TEMP / SP_ENABLE_PRESSURE），
+// 未驱动的通道保持不变。RAMP：自段起点设定值线性过渡到目标；STEP：立即跳到目标并保持；HOLD：保持段起点设定值
+struct ProgramSegmentV1 {
+    uint8_t  type;
+    uint8_t  enable_mask;
+    float    temp_c;
+    float    pressure_pa;
+    uint32_t duration_ms;
+};
+
+// 程序上传：count 段紧随其后（变长，最多 PROGRAM_MAX_SEGMENTS 段）；上传会停止正在执行的程序
+struct PayloadProgramV1 {
+    uint8_t count;
+};
+
+// 程序控制：op 见 PROGRAM_OP_*
+struct PayloadProgramCtrl {
+    uint8_t op;
+};
+
+// 配置参数读写：op 见 CONFIG_OP_*，id 见 CFG_*；value 仅 SET 使用（整数参数同样以 float 传输）
+struct PayloadConfigCmd {
+    uint8_t op;
+    uint8_t id;
+    float   value;
+};
+
+// 配置命令应答（取代 ACK，seq 与命令相同）：status 见 CONFIG_*；value 为参数当前 RAM 值（COMMIT/DEFAULTS/RELOAD 时回显 id 对应值），
+// dirty = RAM 与 Flash 中最新记录不一致，commit_seq 为 Flash 中最新记录的提交序号（0 = 尚无记录）
+struct PayloadConfigValueV1 {
+    uint8_t  op;
+    uint8_t  id;
+    uint8_t  status;
+    uint8_t  dirty;
+    float    value;
+    uint32_t commit_seq;
+};
+
+// DAQ 命令：op 见 DAQ_OP_*。START：count 个变量 id 紧随其后（变长，最多 DAQ_MAX_VARS 个），
+// 每 divider 个控制节拍采样一行，每帧 samples_per_frame 行（0 = 一帧能容纳的最多行数）；
+// CATALOG：从第 index 项起返回变量目录
+struct PayloadDaqCmdV1 {
+    uint8_t  op;
+    uint8_t  index;
+    uint16_t divider;
+    uint8_t  samples_per_frame;
+    uint8_t  count;
+};
+
+// DAQ 状态（START/STOP/STATUS 的应答，seq 与命令相同，取代 ACK）：status 见 DAQ_OK / DAQ_ERR_*；
+// ids/types 为当前订阅（前 count 项），types 见 DAQ_T_*；frames/overruns 为累计已发帧数 / 未及发出被覆盖的帧数
+struct PayloadDaqStatusV1 {
+    uint8_t  status;
+    uint8_t  list_id;
+    uint8_t  active;
+    uint8_t  count;
+    uint16_t divider;
+    uint8_t  samples_per_frame;
+    uint8_t  row_bytes;
+    uint32_t sample_period_us;
+    uint32_t frames;
+    uint32_t overruns;
+    uint8_t  ids[16];
+    uint8_t  types[16];
+};
+
+// 变量目录项：name 以 NUL 结尾（最长 13 字符）
+struct DaqCatalogEntryV1 {
+    uint8_t id;
+    uint8_t type;
+    char    name[14];
+};
+
+// 变量目录分块：count 项紧随其后（变长，最多 DAQ_CATALOG_ENTRIES 项），total 为目录总项数
+struct PayloadDaqCatalogV1 {
+    uint8_t total;
+    uint8_t first;
+    uint8_t count;
+};
+
+// DAQ 数据帧：n_samples 行紧随其后，每行按订阅顺序紧凑排列各变量（小端，宽度见 DAQ_T_*）；
+// first_sample 为首行的采样序号（逐行递增，跳号即丢帧），t_ms 为首行采样时刻，行间隔 = sample_period_us
+struct PayloadDaqV1 {
+    uint8_t  list_id;
+    uint8_t  n_samples;
+    uint16_t first_sample;
+    uint32_t t_ms;
+};
+
+// 批量参数操作：op 见 PARAM_OP_*，count 项紧随其后（变长，最多 PARAM_BATCH_MAX 项）
+// - GET / INFO：各项为 1 字节参数 id；count = 0 表示从 id = first 起的全部参数（一帧放不下时分页）
+// - STAGE / SET_COMMIT：各项为 ParamSetItemV1
+// - COMMIT / ROLLBACK：无项
+// expect_version 非 0 时须与控制器当前参数版本一致（乐观并发：期间有人改过参数则拒绝）
+struct PayloadParamBatchV1 {
+    uint8_t  op;
+    uint8_t  count;
+    uint8_t  first;
+    uint8_t  reserved;
+    uint32_t expect_version;
+};
+
+struct ParamSetItemV1 {
+    uint8_t id;
+    float   value;
+};
+
+// 批量参数应答（取代 ACK，seq 与命令相同）：status 见 CONFIG_*（整批结果），count 项紧随其后；
+// version 为生效参数的版本号（每次改动生效 +1），staged = 有待提交的暂存修改
+// - GET / STAGE / SET_COMMIT / COMMIT：各项为 ParamValueItemV1（STAGE 回显暂存值，其余为生效值）
+// - INFO：各项为 ParamInfoItemV1
+struct PayloadParamReplyV1 {
+    uint8_t  op;
+    uint8_t  status;
+    uint8_t  count;
+    uint8_t  staged;
+    uint32_t version;
+};
+
+// type 见 DAQ_T_*（F32 或 U32）；status 为该项结果（CONFIG_*）
+struct ParamValueItemV1 {
+    uint8_t id;
+    uint8_t type;
+    uint8_t status;
+    float   value;
+};
+
+struct ParamInfoItemV1 {
+    uint8_t id;
+    uint8_t type;
+    float   min_v;
+    float   max_v;
+};
+
+// 两步时间同步（类 NTP），逐跳进行：地面 ↔ 空中端（LoRa）、空中端 ↔ 控制器（UART）。
+// 请求与应答同一结构、同样长度（两个方向空口时长对称）；时间均为各自的 millis()。
+// - 请求：t1 = 请求方发出时刻；offset_ms / rtt_ms / drift_ppm / synced 为请求方当前对
+//   “应答方时钟 − 请求方时钟”的估计，供应答方上报（控制器据此填遥测）
+// - 应答：回显 id 与 t1，t2 = 应答方收到时刻，t3 = 应答方发出时刻；估计字段为 0
+// 请求方以本地收到时刻 t4 计算：往返 = (t4 − t1) − (t3 − t2)，偏差 = ((t2 − t1) + (t3 − t4)) / 2
+struct PayloadTimeSyncV1 {
+    uint8_t  id;
+    uint8_t  synced;
+    int16_t  drift_ppm;
+    uint32_t t1_ms;
+    uint32_t t2_ms;
+    uint32_t t3_ms;
+    int32_t  offset_ms;
+    uint16_t rtt_ms;
+    uint16_t reserved;
+};
+
+// 命令时延追踪（上行）：控制器在执行器输出生效后发出（对象为被接受的模式/手动/设定值命令，
+// 以 seq 与该命令对应）；空中端转发时补填本机时刻与时钟偏差，地面据此换算各跳时延
+struct PayloadCmdTraceV1 {
+    uint8_t  msg_type;           // 被追踪的命令
+    uint8_t  flags;              // TRACE_FLAG_*
+    uint16_t reserved;
+    uint32_t ctrl_parse_ms;      // 控制器：命令帧解析完成（控制器时钟）
+    uint32_t ctrl_apply_ms;      // 控制器：Actuators::apply 完成（控制器时钟）
+    uint32_t air_lora_rx_ms;     // 空中端：LoRa 收到（空中端时钟，空中端填）
+    uint32_t air_uart_tx_ms;     // 空中端：写入 UART（空中端时钟，空中端填）
+    int32_t  ctrl_air_offset_ms; // 控制器时钟 − 空中端时钟（空中端填）
+};
+
+// 运行指标（util/Metrics.h）：地面按节点分块拉取。node = METRICS_NODE_AIR 由空中端应答，
+// METRICS_NODE_CTRL 转发给控制器；应答 MSG_METRICS_V1 = 头 + count 个条目（不回 ACK）
+struct PayloadMetricsCmdV1 {
+    uint8_t node;   // METRICS_NODE_*
+    uint8_t op;     // METRICS_OP_*
+    uint8_t first;  // 起始条目序号
+    uint8_t reserved;
+};
+
+struct PayloadMetricsV1 {
+    uint8_t  node;
+    uint8_t  op;
+    uint8_t  first;
+    uint8_t  count;      // 本帧条目数
+    uint8_t  total;      // 该节点登记的指标总数
+    uint8_t  reserved;
+    uint32_t schema;     // 名称/类型散列：变化时地面需重新读取目录
+    uint32_t uptime_ms;
+};
+
+// SNAPSHOT 条目：MetricValueV1 + 值（COUNTER: uint32，GAUGE: int32，
+// HISTOGRAM: MetricHistV1 + n 个 uint32 桶计数，对应桶 lo..lo+n-1）
+struct MetricValueV1 {
+    uint8_t index;
+    uint8_t kind;   // METRIC_*
+};
+
+struct MetricHistV1 {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint8_t  lo;
+    uint8_t  n;
+};
+
+// CATALOG 条目
+struct MetricInfoV1 {
+    uint8_t index;
+    uint8_t kind;
+    char    name[14];
+};
+
 #pragma pack(pop)
 
+// 自整定结果状态
+static constexpr uint8_t TUNE_DONE           = 0;
+static constexpr uint8_t TUNE_ABORT_LIMIT    = 1;
+static constexpr uint8_t TUNE_ABORT_SENSOR   = 2;
+static constexpr uint8_t TUNE_ABORT_TIMEOUT  = 3;
+static constexpr uint8_t TUNE_ABORT_EXTERNAL = 4;
+static constexpr uint8_t TUNE_REJECTED       = 5;   // 增益超出参数表范围：未采用，原增益不变，转 SAFE
+
+// 安全联锁条件（PayloadTelemDiagV1::safety_active / safety_last_trip）
+static constexpr uint8_t SAFETY_TRIP_OVERTEMP    = 1u << 0;
+static constexpr uint8_t SAFETY_TRIP_TEMP_RATE   = 1u << 1;
+static constexpr uint8_t SAFETY_TRIP_OVERPRESS   = 1u << 2;
+static constexpr uint8_t SAFETY_TRIP_TEMP_FAULT  = 1u << 3;
+static constexpr uint8_t SAFETY_TRIP_PRESS_FAULT = 1u << 4;
+
+// 高速捕获
+static constexpr uint8_t CAPTURE_OP_INFO    = 0;
+static constexpr uint8_t CAPTURE_OP_TRIGGER = 1;
+static constexpr uint8_t CAPTURE_OP_ARM     = 2;
+static constexpr uint8_t CAPTURE_OP_READ    = 3;
+
+static constexpr uint8_t CAPTURE_ARMED   = 0;
+static constexpr uint8_t CAPTURE_POST    = 1;
+static constexpr uint8_t CAPTURE_READY   = 2;
+
+static constexpr uint8_t CAPTURE_REASON_NONE     = 0;
+static constexpr uint8_t CAPTURE_REASON_SAFETY   = 1;
+static constexpr uint8_t CAPTURE_REASON_OPERATOR = 2;
+
+static constexpr uint8_t CAPTURE_CHUNK_RECORDS = 6;   // 26 B/条，每块负载 161 B
+
+// 分段耗时剖析
+static constexpr uint8_t PROFILE_STAGES = 6;
+
+// 设定值程序
+static constexpr uint8_t PROGRAM_MAX_SEGMENTS = 12;
+
+static constexpr uint8_t PROGRAM_SEG_RAMP = 0;
+static constexpr uint8_t PROGRAM_SEG_HOLD = 1;
+static constexpr uint8_t PROGRAM_SEG_STEP = 2;
+
+static constexpr uint8_t PROGRAM_OP_START  = 0;
+static constexpr uint8_t PROGRAM_OP_STOP   = 1;
+static constexpr uint8_t PROGRAM_OP_PAUSE  = 2;
+static constexpr uint8_t PROGRAM_OP_RESUME = 3;
+
+// EMPTY：未上传；READY：已上传未执行；DONE/ABORTED 后可重新 START
+static constexpr uint8_t PROGRAM_EMPTY   = 0;
+static constexpr uint8_t PROGRAM_READY   = 1;
+static constexpr uint8_t PROGRAM_RUNNING = 2;
+static constexpr uint8_t PROGRAM_PAUSED  = 3;
+static constexpr uint8_t PROGRAM_DONE    = 4;
+static constexpr uint8_t PROGRAM_ABORTED = 5;
+
+// 配置参数（ConfigStore）
+static constexpr uint8_t CONFIG_OP_GET      = 0;
+static constexpr uint8_t CONFIG_OP_SET      = 1;
+static constexpr uint8_t CONFIG_OP_COMMIT   = 2;
+static constexpr uint8_t CONFIG_OP_DEFAULTS = 3;
+static constexpr uint8_t CONFIG_OP_RELOAD   = 4;
+
+static constexpr uint8_t CONFIG_OK         = 0;
+static constexpr uint8_t CONFIG_ERR_ID     = 1;
+static constexpr uint8_t CONFIG_ERR_RANGE  = 2;
+static constexpr uint8_t CONFIG_ERR_STATE  = 3;
+static constexpr uint8_t CONFIG_ERR_FLASH  = 4;
+static constexpr uint8_t CONFIG_ERR_OP     = 5;
+static constexpr uint8_t CONFIG_ERR_VERSION = 6;
+
+// 参数编号；PT100 参考电阻按通道 CFG_RTD_RREF_0 + ch
+static constexpr uint8_t CFG_PRESS_V0_MV         = 0;
+static constexpr uint8_t CFG_PRESS_SENS_MV_KPA   = 1;
+static constexpr uint8_t CFG_SAFETY_MAX_TEMP_C   = 2;
+static constexpr uint8_t CFG_TELEMETRY_PERIOD_MS = 3;
+static constexpr uint8_t CFG_DIAG_PERIOD_MS      = 4;
+static constexpr uint8_t CFG_SAFETY_MAX_PRESS_PA = 5;
+static constexpr uint8_t CFG_SAFETY_MAX_RATE_C_S = 6;
+static constexpr uint8_t CFG_RTD_RREF_0          = 8;
+static constexpr uint8_t CFG_RTD_RREF_COUNT      = 8;
+static constexpr uint8_t CFG_TEMP_KP             = 16;
+static constexpr uint8_t CFG_TEMP_KI             = 17;
+static constexpr uint8_t CFG_TEMP_KD             = 18;
+static constexpr uint8_t CFG_TEMP_D_TAU_S        = 19;
+static constexpr uint8_t CFG_CASCADE_KP          = 20;
+static constexpr uint8_t CFG_CASCADE_KI          = 21;
+static constexpr uint8_t CFG_PRESS_KP            = 22;
+static constexpr uint8_t CFG_PRESS_KI            = 23;
+static constexpr uint8_t CFG_PRESS_KD            = 24;
+static constexpr uint8_t CFG_ID_LIMIT            = 32;   // 参数编号上限（不含）
+
+// 批量参数操作（MSG_PARAM_BATCH）
+static constexpr uint8_t PARAM_OP_GET        = 0;
+static constexpr uint8_t PARAM_OP_STAGE      = 1;
+static constexpr uint8_t PARAM_OP_COMMIT     = 2;
+static constexpr uint8_t PARAM_OP_ROLLBACK   = 3;
+static constexpr uint8_t PARAM_OP_SET_COMMIT = 4;
+static constexpr uint8_t PARAM_OP_INFO       = 5;
+
+static constexpr uint8_t PARAM_BATCH_MAX = 24;
+
+// 变量采集（DAQ）
+static constexpr uint8_t DAQ_MAX_VARS        = 16;
+static constexpr uint8_t DAQ_CATALOG_ENTRIES = 12;
+
+static constexpr uint8_t DAQ_OP_STOP    = 0;
+static constexpr uint8_t DAQ_OP_START   = 1;
+static constexpr uint8_t DAQ_OP_STATUS  = 2;
+static constexpr uint8_t DAQ_OP_CATALOG = 3;
+
+static constexpr uint8_t DAQ_OK       = 0;
+static constexpr uint8_t DAQ_ERR_ID   = 1;
+static constexpr uint8_t DAQ_ERR_SIZE = 2;
+static constexpr uint8_t DAQ_ERR_OP   = 3;
+
+static constexpr uint8_t DAQ_T_U8  = 0;
+static constexpr uint8_t DAQ_T_I8  = 1;
+static constexpr uint8_t DAQ_T_U16 = 2;
+static constexpr uint8_t DAQ_T_I16 = 3;
+static constexpr uint8_t DAQ_T_U32 = 4;
+static constexpr uint8_t DAQ_T_I32 = 5;
+static constexpr uint8_t DAQ_T_F32 = 6;
+
 static constexpr uint8_t MAN_FLAG_HEATER = 1u << 0;
 static constexpr uint8_t MAN_FLAG_VALVE  = 1u << 1;
 static constexpr uint8_t MAN_FLAG_PUMP   = 1u << 2;
@@ -78,4 +578,21 @@ static constexpr uint8_t SP_ENABLE_PRESSURE = 1u << 1;
 static constexpr uint8_t SP_ENABLE_VALVE    = 1u << 2;
 static constexpr uint8_t SP_ENABLE_PUMP     = 1u << 3;
 
+static constexpr uint8_t TRACE_FLAG_AIR         = 1u << 0; // 空中端时刻有效
+static constexpr uint8_t TRACE_FLAG_CTRL_SYNCED = 1u << 1; // ctrl_air_offset_ms 有效
+
+// 运行指标
+static constexpr uint8_t METRICS_NODE_GROUND = 0;
+static constexpr uint8_t METRICS_NODE_AIR    = 1;
+static constexpr uint8_t METRICS_NODE_CTRL   = 2;
+
+static constexpr uint8_t METRICS_OP_SNAPSHOT = 0;
+static constexpr uint8_t METRICS_OP_CATALOG  = 1;
+
+static constexpr uint8_t METRIC_COUNTER   = 0;
+static constexpr uint8_t METRIC_GAUGE     = 1;
+static constexpr uint8_t METRIC_HISTOGRAM = 2;
+
+static constexpr uint8_t METRICS_HIST_BUCKETS = 24;  // 桶 0 为 0，桶 i 为 [2^(i-1), 2^i)
+
 } // namespace Proto
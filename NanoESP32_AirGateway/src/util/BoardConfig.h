@@ -26,6 +26,18 @@ static constexpr uint32_t HEARTBEAT_PERIOD_MS = 500;
 // 建议从 500~1000ms 起步，稳定后再逐步加快。
 static constexpr uint32_t LORA_TELEM_PERIOD_MS = 500;
 
+// 诊断遥测（控制节拍抖动等）转发周期：仅用于性能评估，低于常规遥测优先级。
+static constexpr uint32_t LORA_DIAG_PERIOD_MS = 2000;
+
+// DAQ 数据帧最小发送间隔：只用空闲空口，但两帧之间至少留出该间隔给地面下行（半双工）。
+// 需要更高观测率时在控制器端加大每帧行数（samples_per_frame），而不是缩短此间隔。
+static constexpr uint32_t LORA_DAQ_MIN_GAP_MS = 250;
+
+// 时间同步（空中端 ↔ 控制器，UART）：周期发起一次交换；超过 TIME_SYNC_VALID_MS 无有效样本
+// 则视为未同步（控制器 V3 遥测中的 clock_synced 随之清零）
+static constexpr uint32_t TIME_SYNC_UART_PERIOD_MS = 1000;
+static constexpr uint32_t TIME_SYNC_VALID_MS       = 5000;
+
 // =======================
 // LoRa (SX1278 / RA-01)
 // =======================
@@ -0,0 +1,126 @@
+// util/ClockSync.h
+#pragma once
+
+#include <Arduino.h>
+
+// ClockSync：两步时间同步（类 NTP）的单跳时钟偏差估计，估计量为“对端时钟 − 本机时钟”（ms）。
+// - 每次交换得到 t1（本机发）、t2（对端收）、t3（对端发）、t4（本机收），
+//   往返 = (t4 − t1) − (t3 − t2)，偏差 = ((t2 − t1) + (t3 − t4)) / 2，误差不超过 往返/2
+// - 最近 WINDOW 个样本中取往返最小者（排队/阻塞只会拉长往返，最小往返的样本最可信）
+// - 漂移：当前最佳样本相对锚点样本的斜率（间隔越长，单样本误差的影响越小），用于外推；
+//   间隔超过 DRIFT_MAX_SPAN_MS 后锚点前移（跟随晶振温漂）
+// - 连续 OUTLIER_RESET 个样本偏离预测超过 OUTLIER_MS（对端重启）时丢弃历史重新收敛
+// 时间均为 millis()，按 uint32 回绕运算。Air/Ground 两端使用同一份实现。
+
+class ClockSync {
+public:
+    static constexpr uint8_t  WINDOW            = 8;
+    static constexpr uint32_t MAX_RTT_MS        = 2000;
+    static constexpr int32_t  OUTLIER_MS        = 50;
+    static constexpr uint8_t  OUTLIER_RESET     = 3;
+    static constexpr uint32_t DRIFT_MIN_SPAN_MS = 120000;
+    static constexpr uint32_t DRIFT_MAX_SPAN_MS = 1800000;
+    static constexpr float    DRIFT_MAX_PPM     = 1000.0f;
+
+    // 加入一次交换的四个时刻；返回 false 表示样本被拒绝（往返异常或离群）
+    bool addSample(uint32_t t1, uint32_t t2, uint32_t t3, uint32_t t4)
+    {
+        const int32_t rtt = (int32_t)(t4 - t1) - (int32_t)(t3 - t2);
+        if (rtt < 0 || (uint32_t)rtt > MAX_RTT_MS) return false;
+        const int32_t off = (int32_t)(((int64_t)(int32_t)(t2 - t1) + (int64_t)(int32_t)(t3 - t4)) / 2);
+
+        if (count_ > 0) {
+            const int32_t err = off - offsetAt(t4);
+            if (err > OUTLIER_MS + rtt / 2 || err < -(OUTLIER_MS + rtt / 2)) {
+                if (++outliers_ < OUTLIER_RESET) return false;
+                reset();
+            }
+        }
+        outliers_ = 0;
+
+        Sample &s = win_[head_];
+        s.local_ms = t4;
+        s.offset_ms = off;
+        s.rtt_ms = (uint16_t)rtt;
+        head_ = (uint8_t)((head_ + 1) % WINDOW);
+        if (count_ < WINDOW) ++count_;
+        last_ms_ = t4;
+        ++total_;
+
+        pickBest();
+        updateDrift();
+        return true;
+    }
+
+    // 最近 max_age_ms 内有过有效样本
+    bool valid(uint32_t now_ms, uint32_t max_age_ms) const
+    {
+        return count_ > 0 && (now_ms - last_ms_) < max_age_ms;
+    }
+
+    // 本机时刻 local_ms 对应的偏差（按漂移外推）
+    int32_t offsetAt(uint32_t local_ms) const
+    {
+        if (count_ == 0) return 0;
+        const float dt = (float)(int32_t)(local_ms - best_.local_ms);
+        return best_.offset_ms + (int32_t)lroundf(drift_ppm_ * 1e-6f * dt);
+    }
+
+    uint16_t rttMs() const { return count_ ? best_.rtt_ms : 0; }
+    int16_t  driftPpm() const { return (int16_t)lroundf(drift_ppm_); }
+    uint32_t samples() const { return total_; }
+    uint32_t lastSampleMs() const { return last_ms_; }
+
+    void reset()
+    {
+        count_ = 0;
+        head_ = 0;
+        outliers_ = 0;
+        drift_ppm_ = 0.0f;
+        anchor_valid_ = false;
+    }
+
+private:
+    struct Sample {
+        uint32_t local_ms;
+        int32_t  offset_ms;
+        uint16_t rtt_ms;
+    };
+
+    Sample   win_[WINDOW]{};
+    Sample   best_{0, 0, 0};
+    Sample   anchor_{0, 0, 0};
+    uint8_t  head_{0};
+    uint8_t  count_{0};
+    uint8_t  outliers_{0};
+    bool     anchor_valid_{false};
+    float    drift_ppm_{0.0f};
+    uint32_t last_ms_{0};
+    uint32_t total_{0};
+
+    void pickBest()
+    {
+        uint8_t bi = 0;
+        for (uint8_t i = 0; i < count_; ++i) {
+            if (win_[i].rtt_ms < win_[bi].rtt_ms) bi = i;
+        }
+        best_ = win_[bi];
+    }
+
+    void updateDrift()
+    {
+        if (!anchor_valid_) {
+            anchor_ = best_;
+            anchor_valid_ = true;
+            return;
+        }
+        const int32_t span = (int32_t)(best_.local_ms - anchor_.local_ms);
+        if (span < (int32_t)DRIFT_MIN_SPAN_MS) return;
+
+        float ppm = (float)(best_.offset_ms - anchor_.offset_ms) * 1e6f / (float)span;
+        if (ppm > DRIFT_MAX_PPM) ppm = DRIFT_MAX_PPM;
+        if (ppm < -DRIFT_MAX_PPM) ppm = -DRIFT_MAX_PPM;
+        drift_ppm_ = ppm;
+        if (span >= (int32_t)DRIFT_MAX_SPAN_MS) anchor_ = best_;
+    }
+};
@@ -0,0 +1,263 @@
+// util/Metrics.h
+#pragma once
+
+#include <Arduino.h>
+#include <string.h>
+
+#include "../proto/Protocol.h"
+
+// Metrics：运行指标登记表（计数器 / 量值 / 对数分桶直方图），三块板使用同一份实现。
+// - 指标为静态对象，构造时按定义顺序挂入登记表（不分配堆内存）；名称为编译期字符串，最长 13 字符
+// - Counter 单调累加（自上电起，不清零，地面按两次快照之差计算速率）；Gauge 为最近值；
+//   二者都可改为构造时给出读函数，快照时读取已有的统计量（不重复记账）
+// - Histogram 按 2 的幂分桶：桶 0 为 0，桶 i 为 [2^(i-1), 2^i)，末桶含所有更大值；同时记录 count/min/max/sum
+// - 快照编码：PayloadMetricsV1 头 + 从 first 起放得下的条目（直方图只带非零桶区间）；
+//   目录编码：PayloadMetricsV1 头 + MetricInfoV1 条目。头中 schema 为全部名称/类型的散列，
+//   地面据此判断缓存的目录是否仍然有效
+// 所有接口只在主循环上下文调用（不在中断中更新），无需加锁。
+
+namespace Metrics {
+
+static constexpr uint8_t kNameMax = sizeof(Proto::MetricInfoV1::name) - 1;
+static constexpr uint8_t kBuckets = Proto::METRICS_HIST_BUCKETS;
+
+class Metric;
+
+struct Registry {
+    Metric  *head;
+    Metric  *tail;
+    uint8_t  count;
+};
+
+inline Registry &registry()
+{
+    static Registry r{nullptr, nullptr, 0};
+    return r;
+}
+
+class Metric {
+public:
+    const char *name() const { return name_; }
+    uint8_t kind() const { return kind_; }
+    const Metric *next() const { return next_; }
+
+    Metric(const Metric &) = delete;
+    Metric &operator=(const Metric &) = delete;
+
+protected:
+    Metric(const char *name, uint8_t kind) : name_(name), kind_(kind)
+    {
+        Registry &r = registry();
+        if (r.count == 0xFF) return;  // 条目序号为 uint8
+        if (r.tail) r.tail->next_ = this;
+        else r.head = this;
+        r.tail = this;
+        ++r.count;
+    }
+
+private:
+    const char *name_;
+    uint8_t     kind_;
+    Metric     *next_{nullptr};
+};
+
+class Counter : public Metric {
+public:
+    explicit Counter(const char *name, uint32_t (*sample)() = nullptr)
+        : Metric(name, Proto::METRIC_COUNTER), sample_(sample) {}
+
+    void inc(uint32_t n = 1) { value_ += n; }
+    uint32_t value() const { return sample_ ? sample_() : value_; }
+
+private:
+    uint32_t (*sample_)();
+    uint32_t value_{0};
+};
+
+class Gauge : public Metric {
+public:
+    explicit Gauge(const char *name, int32_t (*sample)() = nullptr)
+        : Metric(name, Proto::METRIC_GAUGE), sample_(sample) {}
+
+    void set(int32_t v) { value_ = v; }
+    int32_t value() const { return sample_ ? sample_() : value_; }
+
+private:
+    int32_t (*sample_)();
+    int32_t value_{0};
+};
+
+class Histogram : public Metric {
+public:
+    explicit Histogram(const char *name) : Metric(name, Proto::METRIC_HISTOGRAM) {}
+
+    static uint8_t bucketOf(uint32_t v)
+    {
+        const uint8_t b = v ? static_cast<uint8_t>(32 - __builtin_clz(v)) : 0;
+        return (b < kBuckets) ? b : static_cast<uint8_t>(kBuckets - 1);
+    }
+
+    void record(uint32_t v)
+    {
+        if (count_ == 0 || v < min_) min_ = v;
+        if (v > max_) max_ = v;
+        sum_ += v;
+        ++count_;
+        ++bucket_[bucketOf(v)];
+    }
+
+    void reset()
+    {
+        count_ = 0;
+        min_ = 0;
+        max_ = 0;
+        sum_ = 0;
+        memset(bucket_, 0, sizeof(bucket_));
+    }
+
+    uint32_t count() const { return count_; }
+    uint32_t minValue() const { return min_; }
+    uint32_t maxValue() const { return max_; }
+    uint64_t sum() const { return sum_; }
+    uint32_t bucket(uint8_t i) const { return (i < kBuckets) ? bucket_[i] : 0; }
+
+    // 非零桶区间 [lo, lo + n)；全空时 n = 0
+    void span(uint8_t &lo, uint8_t &n) const
+    {
+        lo = 0;
+        n = 0;
+        uint8_t hi = 0;
+        bool any = false;
+        for (uint8_t i = 0; i < kBuckets; ++i) {
+            if (bucket_[i] == 0) continue;
+            if (!any) lo = i;
+            hi = i;
+            any = true;
+        }
+        if (any) n = static_cast<uint8_t>(hi - lo + 1);
+    }
+
+private:
+    uint32_t count_{0};
+    uint32_t min_{0};
+    uint32_t max_{0};
+    uint64_t sum_{0};
+    uint32_t bucket_[kBuckets] = {0};
+};
+
+inline uint8_t count() { return registry().count; }
+
+// 名称 + 类型的 FNV-1a 散列（指标增删改名后变化）
+inline uint32_t schema()
+{
+    uint32_t h = 2166136261u;
+    for (const Metric *m = registry().head; m; m = m->next()) {
+        h = (h ^ m->kind()) * 16777619u;
+        for (const char *p = m->name(); *p; ++p) h = (h ^ static_cast<uint8_t>(*p)) * 16777619u;
+        h = (h ^ 0u) * 16777619u;
+    }
+    return h;
+}
+
+inline const Metric *at(uint8_t index)
+{
+    const Metric *m = registry().head;
+    while (m && index--) m = m->next();
+    return m;
+}
+
+// 单个条目的快照编码长度（直方图按非零桶区间）
+inline uint8_t entrySize(const Metric &m)
+{
+    if (m.kind() == Proto::METRIC_HISTOGRAM) {
+        uint8_t lo, n;
+        static_cast<const Histogram &>(m).span(lo, n);
+        return static_cast<uint8_t>(sizeof(Proto::MetricValueV1) + sizeof(Proto::MetricHistV1) + n * sizeof(uint32_t));
+    }
+    return static_cast<uint8_t>(sizeof(Proto::MetricValueV1) + sizeof(uint32_t));
+}
+
+inline void fillHeader(Proto::PayloadMetricsV1 &h, uint8_t node, uint8_t op, uint8_t first)
+{
+    memset(&h, 0, sizeof(h));
+    h.node = node;
+    h.op = op;
+    h.first = first;
+    h.total = count();
+    h.schema = schema();
+    h.uptime_ms = millis();
+}
+
+// 快照分块：从 first 起放得下的条目，返回负载字节数
+inline uint8_t encodeSnapshot(uint8_t node, uint8_t first, uint8_t *payload, uint8_t cap)
+{
+    Proto::PayloadMetricsV1 h;
+    if (cap < sizeof(h)) return 0;
+    fillHeader(h, node, Proto::METRICS_OP_SNAPSHOT, first);
+
+    uint8_t off = sizeof(h);
+    uint8_t index = first;
+    for (const Metric *m = at(first); m; m = m->next(), ++index) {
+        const uint8_t need = entrySize(*m);
+        if (off + need > cap) break;
+
+        Proto::MetricValueV1 e{index, m->kind()};
+        memcpy(payload + off, &e, sizeof(e));
+        off += sizeof(e);
+
+        if (m->kind() == Proto::METRIC_COUNTER) {
+            const uint32_t v = static_cast<const Counter *>(m)->value();
+            memcpy(payload + off, &v, sizeof(v));
+            off += sizeof(v);
+        } else if (m->kind() == Proto::METRIC_GAUGE) {
+            const int32_t v = static_cast<const Gauge *>(m)->value();
+            memcpy(payload + off, &v, sizeof(v));
+            off += sizeof(v);
+        } else {
+            const Histogram &hg = *static_cast<const Histogram *>(m);
+            Proto::MetricHistV1 hv;
+            hv.count = hg.count();
+            hv.min = hg.minValue();
+            hv.max = hg.maxValue();
+            hv.sum = hg.sum();
+            hg.span(hv.lo, hv.n);
+            memcpy(payload + off, &hv, sizeof(hv));
+            off += sizeof(hv);
+            for (uint8_t i = 0; i < hv.n; ++i) {
+                const uint32_t c = hg.bucket(static_cast<uint8_t>(hv.lo + i));
+                memcpy(payload + off, &c, sizeof(c));
+                off += sizeof(c);
+            }
+        }
+        ++h.count;
+    }
+
+    memcpy(payload, &h, sizeof(h));
+    return off;
+}
+
+// 目录分块：从 first 起放得下的名称/类型，返回负载字节数
+inline uint8_t encodeCatalog(uint8_t node, uint8_t first, uint8_t *payload, uint8_t cap)
+{
+    Proto::PayloadMetricsV1 h;
+    if (cap < sizeof(h)) return 0;
+    fillHeader(h, node, Proto::METRICS_OP_CATALOG, first);
+
+    uint8_t off = sizeof(h);
+    uint8_t index = first;
+    for (const Metric *m = at(first); m && off + sizeof(Proto::MetricInfoV1) <= cap; m = m->next(), ++index) {
+        Proto::MetricInfoV1 e;
+        memset(&e, 0, sizeof(e));
+        e.index = index;
+        e.kind = m->kind();
+        strncpy(e.name, m->name(), kNameMax);
+        memcpy(payload + off, &e, sizeof(e));
+        off += sizeof(e);
+        ++h.count;
+    }
+
+    memcpy(payload, &h, sizeof(h));
+    return off;
+}
+
+} // namespace Metrics
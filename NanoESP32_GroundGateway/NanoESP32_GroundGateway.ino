@@ -14,11 +14,13 @@
 #include "src/lora/LoRaLink.h"
 #include "src/proto/FrameCodec.h"
 #include "src/proto/Protocol.h"
+#include "src/util/ClockSync.h"
+#include "src/util/Metrics.h"
 
 static uint8_t g_tx_seq = 0;
 static FrameCodec::Parser g_rx_parser;
 
-static char g_line_buf[128];
+static char g_line_buf[256];   // param set 一行可带多组 name value
 static size_t g_line_len = 0;
 
 static Proto::PayloadManualCmdV1 g_man = {0, 0.0f, 0.0f, 0.0f};
@@ -26,6 +28,19 @@ static Proto::PayloadSetpointsV1 g_sp  = {0.0f, 0.0f, 0.0f, 0.0f, 0};
 
 static bool g_lora_raw = false; // 原始嗅探：打印任何包内容（ASCII/HEX），不做协议解码
 
+// 运行指标（util/Metrics.h）：与空中端、控制器同一份登记表实现；`metrics ground` 与远端快照
+// 走同一条编码/解码输出路径。定义顺序即条目序号
+static Metrics::Counter   g_m_cmd_sent("cmd_sent");
+static Metrics::Counter   g_m_cmd_retry("cmd_retry");
+static Metrics::Counter   g_m_cmd_fail("cmd_fail");
+static Metrics::Counter   g_m_cmd_acked("cmd_acked");
+static Metrics::Histogram g_m_cmd_ack_ms("cmd_ack_ms");
+static Metrics::Counter   g_m_lora_rx("lora_rx_pkts");
+static Metrics::Counter   g_m_lora_rx_bad("lora_rx_bad");
+static Metrics::Gauge     g_m_lora_rssi("lora_rssi");
+static Metrics::Counter   g_m_lora_wdog("lora_wdog");
+static Metrics::Counter   g_m_lora_reinit("lora_reinit", []() -> uint32_t { return LoRaLink::diag().reinit_total; });
+
 // LoRa RX 健康监测：避免出现“运行数小时后不再接收，reset 又恢复”的僵死态
 static uint32_t g_last_lora_pkt_ms = 0;
 static uint32_t g_last_lora_reinit_ms = 0;
@@ -42,6 +57,7 @@ static void serviceLoRaWatchdog(uint32_t now_ms)
     // 频率限制：避免反复重置导致更不稳定。
     if (now_ms - g_last_lora_reinit_ms < 3000) return;
     g_last_lora_reinit_ms = now_ms;
+    g_m_lora_wdog.inc();
 
     Serial.println("[LORA] watchdog: no RX > 5s, reinit radio");
     const bool ok = LoRaLink::begin();
@@ -68,15 +84,192 @@ struct PendingCmd {
     bool sent_once = false;
     uint32_t busy_since_ms = 0;
     uint32_t last_busy_warn_ms = 0;
+
+    // 命令时延追踪：USB 收到命令行 / 最近一次 LoRa 发送完成（ACK 后保留，供追踪记录匹配）
+    uint32_t usb_rx_ms = 0;
+    uint32_t tx_done_ms = 0;
 };
 
 static PendingCmd g_pending;
 
+// 高速捕获下载：收到 READY 状态（或 capture get）后逐块请求，每块应答后请求下一块
+struct CaptureDownload {
+    bool active = false;
+    uint16_t capture_id = 0;
+    uint16_t count = 0;
+    uint16_t next = 0;
+    uint32_t last_req_ms = 0;
+    uint8_t retry = 0;
+};
+
+static CaptureDownload g_cap;
+
+// 运行指标：各节点的目录（名称/类型）按 schema 缓存，快照头中 schema 与缓存不符时先重读目录；
+// 远端节点（空中端/控制器）按节点依次拉取，每块应答后请求下一块
+static constexpr uint8_t METRICS_NODE_COUNT = 3;
+static constexpr uint8_t METRICS_CACHE_MAX  = 64;
+static const char *const kMetricsNodeNames[METRICS_NODE_COUNT] = {"ground", "air", "ctrl"};
+
+struct MetricsCatalog {
+    bool     valid = false;
+    uint32_t schema = 0;
+    uint8_t  total = 0;
+    uint8_t  kind[METRICS_CACHE_MAX] = {0};
+    char     name[METRICS_CACHE_MAX][sizeof(Proto::MetricInfoV1::name)] = {};
+};
+
+static MetricsCatalog g_metrics_cat[METRICS_NODE_COUNT];
+
+struct MetricsPull {
+    bool active = false;
+    uint8_t nodes = 0;   // 尚未拉取的节点（bit = METRICS_NODE_*）
+    uint8_t node = 0;
+    uint8_t op = 0;
+    uint8_t next = 0;
+    uint32_t last_req_ms = 0;
+    uint8_t retry = 0;
+};
+
+static MetricsPull g_mpull;
+
+// 设定值程序：本地逐段编辑，prog upload 一次性可靠下发，由控制器按控制节拍执行
+static Proto::ProgramSegmentV1 g_prog[Proto::PROGRAM_MAX_SEGMENTS];
+static uint8_t g_prog_count = 0;
+static uint8_t g_prog_last_state = Proto::PROGRAM_EMPTY;
+
+// 时间同步：本机周期向空中端发起交换，估计“空中端时钟 − 本机时钟”；控制器遥测带有空中端对
+// “控制器时钟 − 空中端时钟”的估计，两段相加即可把遥测时间戳换算到本机时钟，得到端到端延迟
+static ClockSync g_sync_air;
+static uint32_t g_last_sync_ms = 0;
+static uint8_t  g_sync_id = 0;
+static Metrics::Histogram g_lat("e2e_ms");
+
+// 命令时延追踪：各跳时延直方图（Metrics::Histogram，同步误差造成的负值按 0 计入）
+enum TraceHop : uint8_t { HOP_USB, HOP_LORA, HOP_AIR, HOP_UART, HOP_CTRL, HOP_TOTAL, HOP_COUNT };
+static const char *const kTraceHopNames[HOP_COUNT] = {"usb", "lora", "air", "uart", "ctrl", "total"};
+
+static Metrics::Histogram g_hop_usb("hop_usb_ms");
+static Metrics::Histogram g_hop_lora("hop_lora_ms");
+static Metrics::Histogram g_hop_air("hop_air_ms");
+static Metrics::Histogram g_hop_uart("hop_uart_ms");
+static Metrics::Histogram g_hop_ctrl("hop_ctrl_ms");
+static Metrics::Histogram g_hop_total("hop_total_ms");
+static Metrics::Histogram *const g_trace_hist[HOP_COUNT] = {
+    &g_hop_usb, &g_hop_lora, &g_hop_air, &g_hop_uart, &g_hop_ctrl, &g_hop_total};
+static uint32_t g_line_rx_ms = 0;   // 当前命令行在 USB 上收齐的时刻
+
 static bool expectsAck(uint8_t msg_type)
 {
     return (msg_type == Proto::MSG_MODE_SWITCH) ||
            (msg_type == Proto::MSG_MANUAL_CMD_V1) ||
-           (msg_type == Proto::MSG_SETPOINTS_V1);
+           (msg_type == Proto::MSG_SETPOINTS_V1) ||
+           (msg_type == Proto::MSG_PROGRAM_V1) ||
+           (msg_type == Proto::MSG_PROGRAM_CTRL) ||
+           (msg_type == Proto::MSG_CONFIG_CMD) ||
+           (msg_type == Proto::MSG_DAQ_CMD) ||
+           (msg_type == Proto::MSG_PARAM_BATCH);
+}
+
+// DAQ：变量目录缓存（daq list 时填充，按 id 索引）与当前订阅布局（MSG_DAQ_STATUS 时更新）
+struct DaqVarInfo {
+    char    name[14];
+    uint8_t type;
+    bool    known;
+};
+
+static DaqVarInfo g_daq_vars[256];
+
+struct DaqLayout {
+    bool     valid = false;
+    uint8_t  list_id = 0;
+    uint8_t  count = 0;
+    uint8_t  ids[Proto::DAQ_MAX_VARS];
+    uint8_t  types[Proto::DAQ_MAX_VARS];
+    uint32_t period_us = 0;
+    uint16_t next_sample = 0;
+};
+
+static DaqLayout g_daq;
+
+static bool parseDaqVar(const char *s, uint8_t &id)
+{
+    if (!s) return false;
+    for (uint16_t i = 0; i < 256; ++i) {
+        if (g_daq_vars[i].known && strcmp(g_daq_vars[i].name, s) == 0) {
+            id = static_cast<uint8_t>(i);
+            return true;
+        }
+    }
+    char *endp = nullptr;
+    const unsigned long v = strtoul(s, &endp, 10);
+    if (endp == s || *endp != 0 || v > 255) return false;
+    id = static_cast<uint8_t>(v);
+    return true;
+}
+
+// 配置参数名（与控制器 Proto::CFG_* 对应）；PT100 参考电阻为 rref0..rref7
+struct ConfigName {
+    const char *name;
+    uint8_t id;
+};
+
+static const ConfigName kConfigNames[] = {
+    {"press_v0_mv", Proto::CFG_PRESS_V0_MV},
+    {"press_sens", Proto::CFG_PRESS_SENS_MV_KPA},
+    {"max_temp_c", Proto::CFG_SAFETY_MAX_TEMP_C},
+    {"telem_ms", Proto::CFG_TELEMETRY_PERIOD_MS},
+    {"diag_ms", Proto::CFG_DIAG_PERIOD_MS},
+    {"max_press_pa", Proto::CFG_SAFETY_MAX_PRESS_PA},
+    {"max_rate", Proto::CFG_SAFETY_MAX_RATE_C_S},
+    {"temp_kp", Proto::CFG_TEMP_KP},
+    {"temp_ki", Proto::CFG_TEMP_KI},
+    {"temp_kd", Proto::CFG_TEMP_KD},
+    {"temp_dtau", Proto::CFG_TEMP_D_TAU_S},
+    {"casc_kp", Proto::CFG_CASCADE_KP},
+    {"casc_ki", Proto::CFG_CASCADE_KI},
+    {"press_kp", Proto::CFG_PRESS_KP},
+    {"press_ki", Proto::CFG_PRESS_KI},
+    {"press_kd", Proto::CFG_PRESS_KD},
+};
+
+// 最近一次批量应答中的参数版本（0 = 尚未读取，下发时不做版本检查）
+static uint32_t g_param_version = 0;
+
+static bool parseConfigId(const char *s, uint8_t &id)
+{
+    if (!s) return false;
+    for (const ConfigName &n : kConfigNames) {
+        if (strcmp(s, n.name) == 0) {
+            id = n.id;
+            return true;
+        }
+    }
+    if (strncmp(s, "rref", 4) == 0 && s[4] >= '0' && s[4] < '0' + Proto::CFG_RTD_RREF_COUNT && s[5] == 0) {
+        id = static_cast<uint8_t>(Proto::CFG_RTD_RREF_0 + (s[4] - '0'));
+        return true;
+    }
+    char *endp = nullptr;
+    const unsigned long v = strtoul(s, &endp, 10);
+    if (endp == s || *endp != 0 || v > 255) return false;
+    id = static_cast<uint8_t>(v);
+    return true;
+}
+
+static void printConfigName(uint8_t id)
+{
+    for (const ConfigName &n : kConfigNames) {
+        if (n.id == id) {
+            Serial.print(n.name);
+            return;
+        }
+    }
+    if (id >= Proto::CFG_RTD_RREF_0 && id < Proto::CFG_RTD_RREF_0 + Proto::CFG_RTD_RREF_COUNT) {
+        Serial.print("rref");
+        Serial.print(id - Proto::CFG_RTD_RREF_0);
+        return;
+    }
+    Serial.print("p");
+    Serial.print(id);
 }
 
 // static bool sendRawFrame(const uint8_t *buf, size_t len)
@@ -111,6 +304,8 @@ static bool startReliableSend(uint8_t msg_type, const void *payload, uint8_t pay
     g_pending.busy_since_ms = 0;
     g_pending.last_busy_warn_ms = 0;
     g_pending.last_send_ms = 0;
+    g_pending.usb_rx_ms = g_line_rx_ms;
+    g_pending.tx_done_ms = 0;
 
     // 立即尝试一次发送
     const uint32_t now = millis();
@@ -118,6 +313,8 @@ static bool startReliableSend(uint8_t msg_type, const void *payload, uint8_t pay
     if (r == LoRaLink::TxResult::OK || r == LoRaLink::TxResult::FAIL) {
         g_pending.sent_once = true;
         g_pending.last_send_ms = now;
+        g_pending.tx_done_ms = millis();
+        g_m_cmd_sent.inc();
         return (r == LoRaLink::TxResult::OK);
     }
     // BUSY：不算 retry、不启动 ACK 计时，交给 loop 里持续尝试
@@ -135,6 +332,8 @@ static void serviceReliableSend(uint32_t now_ms)
         if (r == LoRaLink::TxResult::OK || r == LoRaLink::TxResult::FAIL) {
             g_pending.sent_once = true;
             g_pending.last_send_ms = now_ms;
+            g_pending.tx_done_ms = millis();
+            g_m_cmd_sent.inc();
         } else { // BUSY
             if (g_pending.busy_since_ms == 0) g_pending.busy_since_ms = now_ms;
             if ((now_ms - g_pending.busy_since_ms) > 3000 && (now_ms - g_pending.last_busy_warn_ms) > 1000) {
@@ -154,6 +353,7 @@ static void serviceReliableSend(uint32_t now_ms)
         Serial.print(" seq=");
         Serial.println(g_pending.seq);
         g_pending.active = false;
+        g_m_cmd_fail.inc();
         return;
     }
 
@@ -171,7 +371,9 @@ static void serviceReliableSend(uint32_t now_ms)
     // OK/FAIL：这次算一次真正的“重发尝试”
     g_pending.retry++;
     g_pending.last_send_ms = now_ms;
+    g_pending.tx_done_ms = millis();
     g_pending.busy_since_ms = 0;
+    g_m_cmd_retry.inc();
 
     Serial.print("[CMD] RETRY #");
     Serial.print(g_pending.retry);
@@ -181,17 +383,46 @@ static void serviceReliableSend(uint32_t now_ms)
     Serial.println(g_pending.seq);
 }
 
+// 可靠下行完成（ACK 或作为应答的数据帧）：统计最近一次发出到收到应答的时长
+static void completePending(uint32_t rx_ms)
+{
+    g_pending.active = false;
+    g_m_cmd_acked.inc();
+    g_m_cmd_ack_ms.record(rx_ms - g_pending.last_send_ms);
+}
 
 static void printHelp()
 {
     Serial.println("Commands:");
     Serial.println("  help");
-    Serial.println("  mode safe|manual|auto");
+    Serial.println("  mode safe|manual|auto|autotune");
     Serial.println("  set heater <0-100>");
     Serial.println("  set valve <0-100>");
-    Serial.println("  set T <degC>            (setpoint, reserved for future auto)");
-    Serial.println("  set P <Pa>              (setpoint, reserved for future auto)");
+    Serial.println("  set T <degC>            (setpoint, AUTO temp loop)");
+    Serial.println("  set P <Pa>              (setpoint, AUTO pressure loop)");
     Serial.println("  set valve_sp <0-100>    (setpoint)");
+    Serial.println("  prog ramp|step <s> [T <degC>] [P <Pa>]  (append segment)");
+    Serial.println("  prog hold <s>           (append segment)");
+    Serial.println("  prog clear|show|upload");
+    Serial.println("  prog start|stop|pause|resume");
+    Serial.println("  cfg get <name|id>       (names: press_v0_mv press_sens max_temp_c telem_ms diag_ms rref0..7)");
+    Serial.println("  cfg set <name|id> <value>  (RAM only, applied immediately)");
+    Serial.println("  cfg commit|defaults|reload  (commit = write flash, SAFE mode only)");
+    Serial.println("  param get [name...]     (batch read; no names = all)");
+    Serial.println("  param info [first]      (type and range of each parameter)");
+    Serial.println("  param stage <name> <value> [<name> <value>...]  (validate + stage, not applied)");
+    Serial.println("  param commit|rollback   (apply staged set atomically / discard)");
+    Serial.println("  param set <name> <value> [<name> <value>...]    (stage + commit in one frame)");
+    Serial.println("    extra names: max_press_pa max_rate temp_kp temp_ki temp_kd temp_dtau");
+    Serial.println("                 casc_kp casc_ki press_kp press_ki press_kd");
+    Serial.println("  daq list [first]        (variable catalog)");
+    Serial.println("  daq start <div> <rows> <var...>  (var = name or id; rows 0 = fill frame)");
+    Serial.println("  daq stop|status");
+    Serial.println("  sync [reset]            (clock sync state + latency stats; reset clears stats)");
+    Serial.println("  trace [reset]           (command->actuation latency histograms per hop)");
+    Serial.println("  metrics [ground|air|ctrl|all]  (counters/gauges/histograms of each board)");
+    Serial.println("  capture info|trigger|arm");
+    Serial.println("  capture get [index]     (download frozen capture, from index)");
     Serial.println("  lora stat");
     Serial.println("  lora raw on|off        (print any LoRa packet, disable frame decode print)");
     Serial.println("  lora tx <text>         (send raw text over LoRa)");
@@ -217,6 +448,397 @@ static bool loraSendFrameUnreliable(uint8_t msg_type, const void *payload, uint8
     return LoRaLink::send(buf, n);
 }
 
+static void serviceTimeSync(uint32_t now_ms)
+{
+    // 不与待确认命令争抢空口；丢失不重发，下一周期重新发起
+    if (g_pending.active) return;
+    if (now_ms - g_last_sync_ms < BoardConfig::TIME_SYNC_LORA_PERIOD_MS) return;
+    g_last_sync_ms = now_ms;
+
+    Proto::PayloadTimeSyncV1 p;
+    memset(&p, 0, sizeof(p));
+    p.id = ++g_sync_id;
+    if (g_sync_air.valid(now_ms, BoardConfig::TIME_SYNC_VALID_MS)) {
+        p.synced    = 1;
+        p.drift_ppm = g_sync_air.driftPpm();
+        p.offset_ms = g_sync_air.offsetAt(now_ms);
+        p.rtt_ms    = g_sync_air.rttMs();
+    }
+    p.t1_ms = millis();
+    loraSendFrameUnreliable(Proto::MSG_TIME_SYNC, &p, sizeof(p));
+}
+
+static void printSyncStatus()
+{
+    const uint32_t now = millis();
+    Serial.print("[SYNC] air_synced=");
+    const bool ok = g_sync_air.valid(now, BoardConfig::TIME_SYNC_VALID_MS);
+    Serial.print(ok ? 1 : 0);
+    Serial.print(" air_offset_ms=");
+    Serial.print(ok ? g_sync_air.offsetAt(now) : 0);
+    Serial.print(" rtt_ms=");
+    Serial.print(g_sync_air.rttMs());
+    Serial.print(" drift_ppm=");
+    Serial.print(g_sync_air.driftPpm());
+    Serial.print(" samples=");
+    Serial.print(g_sync_air.samples());
+    Serial.print(" lat_n=");
+    Serial.print(g_lat.count());
+    if (g_lat.count() > 0) {
+        Serial.print(" lat_min=");
+        Serial.print(g_lat.minValue());
+        Serial.print(" lat_avg=");
+        Serial.print((float)g_lat.sum() / (float)g_lat.count(), 1);
+        Serial.print(" lat_max=");
+        Serial.print(g_lat.maxValue());
+    }
+    Serial.println();
+}
+
+// 直方图字段：n= [min= avg= max= b=<lo>:c,c,...]，b 只列出首个到末个非零桶（桶 i 为 [2^(i-1), 2^i)）
+static void printHistFields(const Proto::MetricHistV1 &h, const uint32_t *bucket)
+{
+    Serial.print(" n=");
+    Serial.print(h.count);
+    if (h.count == 0) return;
+    Serial.print(" min=");
+    Serial.print(h.min);
+    Serial.print(" avg=");
+    Serial.print((float)h.sum / (float)h.count, 1);
+    Serial.print(" max=");
+    Serial.print(h.max);
+    Serial.print(" b=");
+    Serial.print(h.lo);
+    Serial.print(':');
+    for (uint8_t i = 0; i < h.n; ++i) {
+        if (i) Serial.print(',');
+        Serial.print(bucket[i]);
+    }
+}
+
+static void printHistFields(const Metrics::Histogram &hg)
+{
+    Proto::MetricHistV1 h;
+    h.count = hg.count();
+    h.min = hg.minValue();
+    h.max = hg.maxValue();
+    h.sum = hg.sum();
+    hg.span(h.lo, h.n);
+    uint32_t bucket[Metrics::kBuckets];
+    for (uint8_t i = 0; i < h.n; ++i) bucket[i] = hg.bucket(static_cast<uint8_t>(h.lo + i));
+    printHistFields(h, bucket);
+}
+
+static void printTraceHist()
+{
+    for (uint8_t i = 0; i < HOP_COUNT; ++i) {
+        Serial.print("[TRACEH] hop=");
+        Serial.print(kTraceHopNames[i]);
+        printHistFields(*g_trace_hist[i]);
+        Serial.println();
+    }
+}
+
+// 收到控制器的追踪记录：全部换算到本机时钟，按跳输出；首发即成功（未重发）且两跳均已同步时计入直方图
+static void handleCmdTrace(uint8_t seq, const Proto::PayloadCmdTraceV1 &t, uint32_t rx_ms)
+{
+    if (seq != g_pending.seq || t.msg_type != g_pending.msg_type || g_pending.tx_done_ms == 0) return;
+
+    const bool air = (t.flags & Proto::TRACE_FLAG_AIR) != 0;
+    const bool synced = air && (t.flags & Proto::TRACE_FLAG_CTRL_SYNCED) &&
+                        g_sync_air.valid(rx_ms, BoardConfig::TIME_SYNC_VALID_MS);
+    const int32_t ag = synced ? g_sync_air.offsetAt(rx_ms) : 0;
+    const int32_t ca = t.ctrl_air_offset_ms;
+
+    // 本机时钟下的各时刻
+    const uint32_t usb   = g_pending.usb_rx_ms;
+    const uint32_t tx    = g_pending.tx_done_ms;
+    const uint32_t a_rx  = t.air_lora_rx_ms - (uint32_t)ag;
+    const uint32_t a_tx  = t.air_uart_tx_ms - (uint32_t)ag;
+    const uint32_t parse = t.ctrl_parse_ms - (uint32_t)ca - (uint32_t)ag;
+    const uint32_t apply = t.ctrl_apply_ms - (uint32_t)ca - (uint32_t)ag;
+
+    int32_t hop[HOP_COUNT];
+    hop[HOP_USB]   = (int32_t)(tx - usb);
+    hop[HOP_LORA]  = (int32_t)(a_rx - tx);
+    hop[HOP_AIR]   = (int32_t)(t.air_uart_tx_ms - t.air_lora_rx_ms);
+    hop[HOP_UART]  = (int32_t)(parse - a_tx);
+    hop[HOP_CTRL]  = (int32_t)(t.ctrl_apply_ms - t.ctrl_parse_ms);
+    hop[HOP_TOTAL] = (int32_t)(apply - usb);
+
+    // 单板内的跳不依赖同步；跨板的跳在未同步时输出 na
+    const bool have[HOP_COUNT] = {usb != 0, synced, air, synced, true, synced && usb != 0};
+
+    Serial.print("[TRACE] msg=0x");
+    Serial.print(t.msg_type, HEX);
+    Serial.print(" seq=");
+    Serial.print(seq);
+    Serial.print(" retry=");
+    Serial.print(g_pending.retry);
+    for (uint8_t i = 0; i < HOP_COUNT; ++i) {
+        Serial.print(' ');
+        Serial.print(kTraceHopNames[i]);
+        Serial.print("_ms=");
+        if (have[i]) Serial.print(hop[i]);
+        else Serial.print("na");
+    }
+    Serial.println();
+
+    if (g_pending.retry == 0) {
+        for (uint8_t i = 0; i < HOP_COUNT; ++i) {
+            if (have[i]) g_trace_hist[i]->record(hop[i] > 0 ? (uint32_t)hop[i] : 0);
+        }
+    }
+    g_pending.tx_done_ms = 0;  // 每条命令只统计一次
+}
+
+static bool sendCaptureCmd(uint8_t op, uint16_t index)
+{
+    Proto::PayloadCaptureCmd p{};
+    p.op = op;
+    p.index = index;
+    return loraSendFrameUnreliable(Proto::MSG_CAPTURE_CMD, &p, sizeof(p));
+}
+
+static void requestCaptureChunk(uint32_t now_ms)
+{
+    sendCaptureCmd(Proto::CAPTURE_OP_READ, g_cap.next);
+    g_cap.last_req_ms = now_ms;
+}
+
+static void serviceCaptureDownload(uint32_t now_ms)
+{
+    if (!g_cap.active) return;
+    if (now_ms - g_cap.last_req_ms < BoardConfig::CAPTURE_CHUNK_TIMEOUT_MS) return;
+
+    if (g_cap.retry >= BoardConfig::CAPTURE_MAX_RETRY) {
+        Serial.print("[CAPINFO] download FAIL id=");
+        Serial.print(g_cap.capture_id);
+        Serial.print(" at=");
+        Serial.println(g_cap.next);
+        g_cap.active = false;
+        return;
+    }
+    g_cap.retry++;
+    requestCaptureChunk(now_ms);
+}
+
+static bool sendMetricsCmd(uint8_t node, uint8_t op, uint8_t first)
+{
+    Proto::PayloadMetricsCmdV1 p{};
+    p.node = node;
+    p.op = op;
+    p.first = first;
+    return loraSendFrameUnreliable(Proto::MSG_METRICS_CMD, &p, sizeof(p));
+}
+
+static void requestMetricsChunk(uint32_t now_ms)
+{
+    sendMetricsCmd(g_mpull.node, g_mpull.op, g_mpull.next);
+    g_mpull.last_req_ms = now_ms;
+}
+
+// 开始拉取下一个节点（目录未缓存时先读目录）；没有待拉取节点时结束
+static void startNextMetricsNode(uint32_t now_ms)
+{
+    g_mpull.active = false;
+    for (uint8_t n = 0; n < METRICS_NODE_COUNT; ++n) {
+        if (!(g_mpull.nodes & (1u << n))) continue;
+        g_mpull.nodes = static_cast<uint8_t>(g_mpull.nodes & ~(1u << n));
+        g_mpull.active = true;
+        g_mpull.node = n;
+        g_mpull.op = g_metrics_cat[n].valid ? Proto::METRICS_OP_SNAPSHOT : Proto::METRICS_OP_CATALOG;
+        g_mpull.next = 0;
+        g_mpull.retry = 0;
+        requestMetricsChunk(now_ms);
+        return;
+    }
+}
+
+// 目录块写入缓存；收齐（或对端已无更多条目）后缓存生效
+static void storeMetricsCatalog(const uint8_t *payload, uint8_t len)
+{
+    Proto::PayloadMetricsV1 h;
+    memcpy(&h, payload, sizeof(h));
+    MetricsCatalog &c = g_metrics_cat[h.node];
+    if (h.first == 0) {
+        c.valid = false;
+        c.schema = h.schema;
+        c.total = h.total;
+    }
+
+    uint8_t off = sizeof(h);
+    for (uint8_t i = 0; i < h.count && off + sizeof(Proto::MetricInfoV1) <= len; ++i) {
+        Proto::MetricInfoV1 e;
+        memcpy(&e, payload + off, sizeof(e));
+        off += sizeof(e);
+        if (e.index >= METRICS_CACHE_MAX) continue;
+        c.kind[e.index] = e.kind;
+        memcpy(c.name[e.index], e.name, sizeof(e.name));
+        c.name[e.index][sizeof(e.name) - 1] = 0;
+    }
+    if (h.count == 0 || h.first + h.count >= h.total) c.valid = true;
+}
+
+// 快照块：[METRICS] 头（首块）+ 每个条目一行 [METRIC]；名称取自目录缓存
+static void printMetricsChunk(const uint8_t *payload, uint8_t len)
+{
+    Proto::PayloadMetricsV1 h;
+    memcpy(&h, payload, sizeof(h));
+    const MetricsCatalog &c = g_metrics_cat[h.node];
+    const char *node = kMetricsNodeNames[h.node];
+
+    if (h.first == 0) {
+        Serial.print("[METRICS] node=");
+        Serial.print(node);
+        Serial.print(" uptime_ms=");
+        Serial.print(h.uptime_ms);
+        Serial.print(" schema=0x");
+        Serial.print(h.schema, HEX);
+        Serial.print(" n=");
+        Serial.println(h.total);
+    }
+
+    uint8_t off = sizeof(h);
+    for (uint8_t i = 0; i < h.count; ++i) {
+        Proto::MetricValueV1 e;
+        if (off + sizeof(e) > len) return;
+        memcpy(&e, payload + off, sizeof(e));
+        off += sizeof(e);
+
+        Serial.print("[METRIC] node=");
+        Serial.print(node);
+        Serial.print(" name=");
+        if (e.index < METRICS_CACHE_MAX && c.name[e.index][0]) {
+            Serial.print(c.name[e.index]);
+        } else {
+            Serial.print('#');
+            Serial.print(e.index);
+        }
+
+        if (e.kind == Proto::METRIC_COUNTER || e.kind == Proto::METRIC_GAUGE) {
+            if (off + sizeof(uint32_t) > len) {
+                Serial.println();
+                return;
+            }
+            if (e.kind == Proto::METRIC_COUNTER) {
+                uint32_t v;
+                memcpy(&v, payload + off, sizeof(v));
+                Serial.print(" counter=");
+                Serial.print(v);
+            } else {
+                int32_t v;
+                memcpy(&v, payload + off, sizeof(v));
+                Serial.print(" gauge=");
+                Serial.print(v);
+            }
+            off += sizeof(uint32_t);
+        } else if (e.kind == Proto::METRIC_HISTOGRAM) {
+            Proto::MetricHistV1 hv;
+            if (off + sizeof(hv) > len) {
+                Serial.println();
+                return;
+            }
+            memcpy(&hv, payload + off, sizeof(hv));
+            off += sizeof(hv);
+            if (hv.n > Metrics::kBuckets || off + hv.n * sizeof(uint32_t) > len) {
+                Serial.println();
+                return;
+            }
+            uint32_t bucket[Metrics::kBuckets];
+            memcpy(bucket, payload + off, hv.n * sizeof(uint32_t));
+            off += hv.n * sizeof(uint32_t);
+            printHistFields(hv, bucket);
+        } else {
+            // 未知类型：长度不明，本块其余条目无法解析
+            Serial.println(" kind=?");
+            return;
+        }
+        Serial.println();
+    }
+}
+
+// 本机指标：与远端相同的编码 -> 解码路径（输出格式一致）
+static void printLocalMetrics()
+{
+    uint8_t payload[FrameCodec::MAX_PAYLOAD];
+    const uint8_t node = Proto::METRICS_NODE_GROUND;
+
+    const MetricsCatalog &c = g_metrics_cat[node];
+    if (!c.valid || c.schema != Metrics::schema()) {
+        for (uint8_t first = 0; first < Metrics::count();) {
+            const uint8_t len = Metrics::encodeCatalog(node, first, payload, sizeof(payload));
+            if (len == 0) break;
+            storeMetricsCatalog(payload, len);
+            const uint8_t n = reinterpret_cast<const Proto::PayloadMetricsV1 *>(payload)->count;
+            if (n == 0) break;
+            first = static_cast<uint8_t>(first + n);
+        }
+    }
+
+    for (uint8_t first = 0;;) {
+        const uint8_t len = Metrics::encodeSnapshot(node, first, payload, sizeof(payload));
+        if (len == 0) break;
+        printMetricsChunk(payload, len);
+        const uint8_t n = reinterpret_cast<const Proto::PayloadMetricsV1 *>(payload)->count;
+        if (n == 0) break;
+        first = static_cast<uint8_t>(first + n);
+        if (first >= Metrics::count()) break;
+    }
+}
+
+// 远端应答：只接受当前请求的块（重发造成的重复块直接丢弃）
+static void handleMetricsReply(const uint8_t *payload, uint8_t len, uint32_t now_ms)
+{
+    Proto::PayloadMetricsV1 h;
+    memcpy(&h, payload, sizeof(h));
+    if (!g_mpull.active || h.node != g_mpull.node || h.op != g_mpull.op || h.first != g_mpull.next) return;
+    g_mpull.retry = 0;
+
+    MetricsCatalog &c = g_metrics_cat[h.node];
+    if (h.op == Proto::METRICS_OP_CATALOG) {
+        storeMetricsCatalog(payload, len);
+        g_mpull.next = static_cast<uint8_t>(g_mpull.next + h.count);
+        if (c.valid) {
+            g_mpull.op = Proto::METRICS_OP_SNAPSHOT;
+            g_mpull.next = 0;
+        }
+        requestMetricsChunk(now_ms);
+        return;
+    }
+
+    if (!c.valid || c.schema != h.schema) {
+        // 对端指标表已变化（固件更新）：重读目录后从头读取快照
+        c.valid = false;
+        g_mpull.op = Proto::METRICS_OP_CATALOG;
+        g_mpull.next = 0;
+        requestMetricsChunk(now_ms);
+        return;
+    }
+
+    printMetricsChunk(payload, len);
+    g_mpull.next = static_cast<uint8_t>(g_mpull.next + h.count);
+    if (h.count == 0 || g_mpull.next >= h.total) startNextMetricsNode(now_ms);
+    else requestMetricsChunk(now_ms);
+}
+
+static void serviceMetricsPull(uint32_t now_ms)
+{
+    if (!g_mpull.active) return;
+    if (now_ms - g_mpull.last_req_ms < BoardConfig::METRICS_TIMEOUT_MS) return;
+
+    if (g_mpull.retry >= BoardConfig::METRICS_MAX_RETRY) {
+        Serial.print("[METRICS] FAIL node=");
+        Serial.print(kMetricsNodeNames[g_mpull.node]);
+        Serial.print(" at=");
+        Serial.println(g_mpull.next);
+        startNextMetricsNode(now_ms);
+        return;
+    }
+    g_mpull.retry++;
+    requestMetricsChunk(now_ms);
+}
+
 static void handleLine(char *line)
 {
     while (*line == ' ' || *line == '\t' || *line == '\r' || *line == '\n') ++line;
@@ -307,6 +929,353 @@ static void handleLine(char *line)
         return;
     }
 
+    if (strcmp(cmd, "prog") == 0) {
+        char *sub = strtok(nullptr, " \t\r\n");
+        if (!sub) {
+            Serial.println("Usage: prog ramp|step|hold|clear|show|upload|start|stop|pause|resume");
+            return;
+        }
+
+        uint8_t seg_type = 0xFF;
+        if (strcmp(sub, "ramp") == 0) seg_type = Proto::PROGRAM_SEG_RAMP;
+        else if (strcmp(sub, "hold") == 0) seg_type = Proto::PROGRAM_SEG_HOLD;
+        else if (strcmp(sub, "step") == 0) seg_type = Proto::PROGRAM_SEG_STEP;
+
+        if (seg_type != 0xFF) {
+            float dur_s = 0.0f;
+            if (!parseFloat(strtok(nullptr, " \t\r\n"), dur_s) || dur_s < 0.0f) {
+                Serial.println("ERR: prog <type> <seconds> [T <degC>] [P <Pa>]");
+                return;
+            }
+            if (g_prog_count >= Proto::PROGRAM_MAX_SEGMENTS) {
+                Serial.println("ERR: program full");
+                return;
+            }
+            Proto::ProgramSegmentV1 s{};
+            s.type = seg_type;
+            s.duration_ms = static_cast<uint32_t>(dur_s * 1000.0f + 0.5f);
+            char *key = nullptr;
+            while ((key = strtok(nullptr, " \t\r\n")) != nullptr) {
+                float v = 0.0f;
+                if (!parseFloat(strtok(nullptr, " \t\r\n"), v)) {
+                    Serial.println("ERR: value parse");
+                    return;
+                }
+                if (strcmp(key, "T") == 0) {
+                    s.temp_c = v;
+                    s.enable_mask |= Proto::SP_ENABLE_TEMP;
+                } else if (strcmp(key, "P") == 0) {
+                    s.pressure_pa = v;
+                    s.enable_mask |= Proto::SP_ENABLE_PRESSURE;
+                } else {
+                    Serial.println("ERR: unknown key (T|P)");
+                    return;
+                }
+            }
+            if (seg_type != Proto::PROGRAM_SEG_HOLD && s.enable_mask == 0) {
+                Serial.println("ERR: ramp/step needs T and/or P");
+                return;
+            }
+            g_prog[g_prog_count++] = s;
+            Serial.print("OK: segment ");
+            Serial.print(g_prog_count - 1);
+            Serial.println(" added");
+            return;
+        }
+
+        if (strcmp(sub, "clear") == 0) {
+            g_prog_count = 0;
+            Serial.println("OK: program cleared (local)");
+            return;
+        }
+        if (strcmp(sub, "show") == 0) {
+            static const char *const kTypes[] = {"ramp", "hold", "step"};
+            for (uint8_t i = 0; i < g_prog_count; ++i) {
+                const Proto::ProgramSegmentV1 &s = g_prog[i];
+                Serial.print("  #");
+                Serial.print(i);
+                Serial.print(' ');
+                Serial.print(kTypes[s.type]);
+                Serial.print(" t(s)=");
+                Serial.print(s.duration_ms * 0.001f, 1);
+                if (s.enable_mask & Proto::SP_ENABLE_TEMP) {
+                    Serial.print(" T=");
+                    Serial.print(s.temp_c);
+                }
+                if (s.enable_mask & Proto::SP_ENABLE_PRESSURE) {
+                    Serial.print(" P=");
+                    Serial.print(s.pressure_pa);
+                }
+                Serial.println();
+            }
+            Serial.print("segments=");
+            Serial.println(g_prog_count);
+            return;
+        }
+        if (strcmp(sub, "upload") == 0) {
+            if (g_prog_count == 0) {
+                Serial.println("ERR: program empty");
+                return;
+            }
+            uint8_t payload[sizeof(Proto::PayloadProgramV1) +
+                            Proto::PROGRAM_MAX_SEGMENTS * sizeof(Proto::ProgramSegmentV1)];
+            Proto::PayloadProgramV1 h{};
+            h.count = g_prog_count;
+            memcpy(payload, &h, sizeof(h));
+            memcpy(payload + sizeof(h), g_prog, g_prog_count * sizeof(Proto::ProgramSegmentV1));
+            const uint8_t len = static_cast<uint8_t>(sizeof(h) + g_prog_count * sizeof(Proto::ProgramSegmentV1));
+            if (startReliableSend(Proto::MSG_PROGRAM_V1, payload, len)) {
+                Serial.println("OK: program sent (LoRa, wait ACK)");
+            } else {
+                Serial.println("ERR: LoRa send failed");
+            }
+            return;
+        }
+
+        Proto::PayloadProgramCtrl c{};
+        if (strcmp(sub, "start") == 0) c.op = Proto::PROGRAM_OP_START;
+        else if (strcmp(sub, "stop") == 0) c.op = Proto::PROGRAM_OP_STOP;
+        else if (strcmp(sub, "pause") == 0) c.op = Proto::PROGRAM_OP_PAUSE;
+        else if (strcmp(sub, "resume") == 0) c.op = Proto::PROGRAM_OP_RESUME;
+        else {
+            Serial.println("ERR: unknown prog command");
+            return;
+        }
+        if (startReliableSend(Proto::MSG_PROGRAM_CTRL, &c, sizeof(c))) {
+            Serial.println("OK: program cmd sent (LoRa, wait ACK)");
+        } else {
+            Serial.println("ERR: LoRa send failed");
+        }
+        return;
+    }
+
+    if (strcmp(cmd, "cfg") == 0) {
+        char *sub = strtok(nullptr, " \t\r\n");
+        Proto::PayloadConfigCmd c{};
+        if (sub && (strcmp(sub, "get") == 0 || strcmp(sub, "set") == 0)) {
+            c.op = (strcmp(sub, "get") == 0) ? Proto::CONFIG_OP_GET : Proto::CONFIG_OP_SET;
+            if (!parseConfigId(strtok(nullptr, " \t\r\n"), c.id)) {
+                Serial.println("ERR: cfg get|set <name|id> [value]");
+                return;
+            }
+            if (c.op == Proto::CONFIG_OP_SET && !parseFloat(strtok(nullptr, " \t\r\n"), c.value)) {
+                Serial.println("ERR: cfg set <name|id> <value>");
+                return;
+            }
+        } else if (sub && strcmp(sub, "commit") == 0) {
+            c.op = Proto::CONFIG_OP_COMMIT;
+        } else if (sub && strcmp(sub, "defaults") == 0) {
+            c.op = Proto::CONFIG_OP_DEFAULTS;
+        } else if (sub && strcmp(sub, "reload") == 0) {
+            c.op = Proto::CONFIG_OP_RELOAD;
+        } else {
+            Serial.println("Usage: cfg get|set|commit|defaults|reload");
+            return;
+        }
+        if (startReliableSend(Proto::MSG_CONFIG_CMD, &c, sizeof(c))) {
+            Serial.println("OK: cfg cmd sent (LoRa, wait reply)");
+        } else {
+            Serial.println("ERR: LoRa send failed");
+        }
+        return;
+    }
+
+    if (strcmp(cmd, "param") == 0) {
+        char *sub = strtok(nullptr, " \t\r\n");
+        uint8_t payload[sizeof(Proto::PayloadParamBatchV1) + Proto::PARAM_BATCH_MAX * sizeof(Proto::ParamSetItemV1)];
+        Proto::PayloadParamBatchV1 c{};
+        size_t len = sizeof(c);
+        if (sub && (strcmp(sub, "get") == 0 || strcmp(sub, "info") == 0)) {
+            c.op = (strcmp(sub, "get") == 0) ? Proto::PARAM_OP_GET : Proto::PARAM_OP_INFO;
+            char *v = nullptr;
+            while ((v = strtok(nullptr, " \t\r\n")) != nullptr) {
+                // info 的可选参数为起始编号（分页）
+                if (c.op == Proto::PARAM_OP_INFO) {
+                    c.first = static_cast<uint8_t>(strtoul(v, nullptr, 10));
+                    break;
+                }
+                if (c.count >= Proto::PARAM_BATCH_MAX) {
+                    Serial.println("ERR: too many parameters");
+                    return;
+                }
+                uint8_t id = 0;
+                if (!parseConfigId(v, id)) {
+                    Serial.print("ERR: unknown parameter ");
+                    Serial.println(v);
+                    return;
+                }
+                payload[len++] = id;
+                ++c.count;
+            }
+        } else if (sub && (strcmp(sub, "stage") == 0 || strcmp(sub, "set") == 0)) {
+            c.op = (strcmp(sub, "stage") == 0) ? Proto::PARAM_OP_STAGE : Proto::PARAM_OP_SET_COMMIT;
+            c.expect_version = g_param_version;
+            char *name = nullptr;
+            while ((name = strtok(nullptr, " \t\r\n")) != nullptr) {
+                Proto::ParamSetItemV1 it;
+                if (!parseConfigId(name, it.id) || !parseFloat(strtok(nullptr, " \t\r\n"), it.value)) {
+                    Serial.println("ERR: param stage|set <name> <value> [<name> <value>...]");
+                    return;
+                }
+                if (c.count >= Proto::PARAM_BATCH_MAX) {
+                    Serial.println("ERR: too many parameters");
+                    return;
+                }
+                memcpy(payload + len, &it, sizeof(it));
+                len += sizeof(it);
+                ++c.count;
+            }
+            if (c.count == 0) {
+                Serial.println("ERR: param stage|set <name> <value> [<name> <value>...]");
+                return;
+            }
+        } else if (sub && strcmp(sub, "commit") == 0) {
+            c.op = Proto::PARAM_OP_COMMIT;
+            c.expect_version = g_param_version;
+        } else if (sub && strcmp(sub, "rollback") == 0) {
+            c.op = Proto::PARAM_OP_ROLLBACK;
+        } else {
+            Serial.println("Usage: param get|info|stage|commit|rollback|set");
+            return;
+        }
+        memcpy(payload, &c, sizeof(c));
+        if (startReliableSend(Proto::MSG_PARAM_BATCH, payload, static_cast<uint8_t>(len))) {
+            Serial.println("OK: param cmd sent (LoRa, wait reply)");
+        } else {
+            Serial.println("ERR: LoRa send failed");
+        }
+        return;
+    }
+
+    if (strcmp(cmd, "daq") == 0) {
+        char *sub = strtok(nullptr, " \t\r\n");
+        uint8_t payload[sizeof(Proto::PayloadDaqCmdV1) + Proto::DAQ_MAX_VARS];
+        Proto::PayloadDaqCmdV1 c{};
+        if (sub && strcmp(sub, "list") == 0) {
+            char *arg = strtok(nullptr, " \t\r\n");
+            c.op = Proto::DAQ_OP_CATALOG;
+            c.index = arg ? static_cast<uint8_t>(strtoul(arg, nullptr, 10)) : 0;
+            // 应答即目录分块；丢失时重新查询
+            if (loraSendFrameUnreliable(Proto::MSG_DAQ_CMD, &c, sizeof(c))) {
+                Serial.println("OK: daq list requested");
+            } else {
+                Serial.println("ERR: LoRa send failed");
+            }
+            return;
+        }
+        if (sub && strcmp(sub, "start") == 0) {
+            char *div = strtok(nullptr, " \t\r\n");
+            char *rows = strtok(nullptr, " \t\r\n");
+            if (!div || !rows) {
+                Serial.println("ERR: daq start <div> <rows> <var...>");
+                return;
+            }
+            c.op = Proto::DAQ_OP_START;
+            c.divider = static_cast<uint16_t>(strtoul(div, nullptr, 10));
+            c.samples_per_frame = static_cast<uint8_t>(strtoul(rows, nullptr, 10));
+            char *v = nullptr;
+            while ((v = strtok(nullptr, " \t\r\n")) != nullptr) {
+                if (c.count >= Proto::DAQ_MAX_VARS) {
+                    Serial.println("ERR: too many variables");
+                    return;
+                }
+                uint8_t id = 0;
+                if (!parseDaqVar(v, id)) {
+                    Serial.print("ERR: unknown daq variable ");
+                    Serial.println(v);
+                    return;
+                }
+                payload[sizeof(c) + c.count++] = id;
+            }
+            if (c.count == 0 || c.divider == 0) {
+                Serial.println("ERR: daq start <div> <rows> <var...>");
+                return;
+            }
+        } else if (sub && strcmp(sub, "stop") == 0) {
+            c.op = Proto::DAQ_OP_STOP;
+        } else if (sub && strcmp(sub, "status") == 0) {
+            c.op = Proto::DAQ_OP_STATUS;
+        } else {
+            Serial.println("Usage: daq list|start|stop|status");
+            return;
+        }
+        memcpy(payload, &c, sizeof(c));
+        if (startReliableSend(Proto::MSG_DAQ_CMD, payload, static_cast<uint8_t>(sizeof(c) + c.count))) {
+            Serial.println("OK: daq cmd sent (LoRa, wait reply)");
+        } else {
+            Serial.println("ERR: LoRa send failed");
+        }
+        return;
+    }
+
+    if (strcmp(cmd, "sync") == 0) {
+        char *sub = strtok(nullptr, " \t\r\n");
+        printSyncStatus();
+        if (sub && strcmp(sub, "reset") == 0) {
+            g_lat.reset();
+            Serial.println("OK: latency stats cleared");
+        }
+        return;
+    }
+
+    if (strcmp(cmd, "trace") == 0) {
+        char *sub = strtok(nullptr, " \t\r\n");
+        printTraceHist();
+        if (sub && strcmp(sub, "reset") == 0) {
+            for (Metrics::Histogram *h : g_trace_hist) h->reset();
+            Serial.println("OK: trace histograms cleared");
+        }
+        return;
+    }
+
+    if (strcmp(cmd, "metrics") == 0) {
+        char *sub = strtok(nullptr, " \t\r\n");
+        uint8_t nodes = 0;
+        if (!sub || strcmp(sub, "all") == 0) nodes = (1u << Proto::METRICS_NODE_GROUND) |
+                                                     (1u << Proto::METRICS_NODE_AIR) |
+                                                     (1u << Proto::METRICS_NODE_CTRL);
+        else if (strcmp(sub, "ground") == 0) nodes = 1u << Proto::METRICS_NODE_GROUND;
+        else if (strcmp(sub, "air") == 0) nodes = 1u << Proto::METRICS_NODE_AIR;
+        else if (strcmp(sub, "ctrl") == 0) nodes = 1u << Proto::METRICS_NODE_CTRL;
+        else {
+            Serial.println("Usage: metrics [ground|air|ctrl|all]");
+            return;
+        }
+
+        if (nodes & (1u << Proto::METRICS_NODE_GROUND)) printLocalMetrics();
+        g_mpull.nodes = static_cast<uint8_t>(nodes & ~(1u << Proto::METRICS_NODE_GROUND));
+        if (g_mpull.nodes) {
+            startNextMetricsNode(millis());
+            Serial.println("OK: metrics request sent (LoRa, wait reply)");
+        }
+        return;
+    }
+
+    if (strcmp(cmd, "capture") == 0) {
+        char *sub = strtok(nullptr, " \t\r\n");
+        uint8_t op = 0;
+        if (sub && strcmp(sub, "info") == 0) op = Proto::CAPTURE_OP_INFO;
+        else if (sub && strcmp(sub, "trigger") == 0) op = Proto::CAPTURE_OP_TRIGGER;
+        else if (sub && strcmp(sub, "arm") == 0) op = Proto::CAPTURE_OP_ARM;
+        else if (sub && strcmp(sub, "get") == 0) {
+            char *arg = strtok(nullptr, " \t\r\n");
+            // 记录总数未知时先按 0 开始，收到首块后由 count=0 判定结束
+            g_cap.active = true;
+            g_cap.count = 0;
+            g_cap.next = arg ? static_cast<uint16_t>(strtoul(arg, nullptr, 10)) : 0;
+            g_cap.retry = 0;
+            requestCaptureChunk(millis());
+            Serial.println("OK: capture download started");
+            return;
+        } else {
+            Serial.println("Usage: capture info|trigger|arm|get [index]");
+            return;
+        }
+        if (op == Proto::CAPTURE_OP_ARM) g_cap.active = false;
+        Serial.println(sendCaptureCmd(op, 0) ? "OK: capture cmd sent" : "ERR: LoRa send failed");
+        return;
+    }
+
     if (strcmp(cmd, "mode") == 0) {
         char *arg = strtok(nullptr, " \t\r\n");
         Proto::PayloadModeSwitch p{};
@@ -317,6 +1286,7 @@ static void handleLine(char *line)
         if (strcmp(arg, "safe") == 0) p.mode = Proto::MODE_SAFE;
         else if (strcmp(arg, "manual") == 0) p.mode = Proto::MODE_MANUAL;
         else if (strcmp(arg, "auto") == 0) p.mode = Proto::MODE_AUTO;
+        else if (strcmp(arg, "autotune") == 0) p.mode = Proto::MODE_AUTOTUNE;
         else {
             Serial.println("ERR: unknown mode");
             return;
@@ -402,13 +1372,173 @@ static void handleLine(char *line)
     Serial.println("ERR: unknown command (try: help)");
 }
 
+// [TELEM] 行：温度按实际通道数输出 T0..Tn-1（至少 T0、T1，保持旧格式兼容）
+static void printTelemLine(uint32_t t_ms, uint8_t temp_count, const float *temp_c, uint8_t cap,
+                           float pressure_pa, float heater_pct, float valve_pct)
+{
+    uint8_t nT = (temp_count > cap) ? cap : temp_count;
+    if (nT < 2) nT = 2;
+
+    Serial.print("[TELEM] t=");
+    Serial.print(t_ms);
+    for (uint8_t i = 0; i < nT; ++i) {
+        Serial.print(" T");
+        Serial.print(i);
+        Serial.print("=");
+        Serial.print(temp_c[i]);
+    }
+    Serial.print(" P(Pa)=");
+    Serial.print(pressure_pa);
+    Serial.print(" heater=%=");
+    Serial.print(heater_pct);
+    Serial.print(" valve=%=");
+    Serial.println(valve_pct);
+}
+
+// [LAT] 行：遥测生成（控制器时钟）到本机收到（本机时钟）的端到端延迟；任一跳未同步时不输出
+static void printLatencyLine(uint32_t t_ms, bool ctrl_synced, int32_t ctrl_offset_ms, uint32_t rx_ms)
+{
+    if (!ctrl_synced || !g_sync_air.valid(rx_ms, BoardConfig::TIME_SYNC_VALID_MS)) return;
+
+    const int32_t air_offset_ms = g_sync_air.offsetAt(rx_ms);
+    // 控制器时刻 -> 空中端时刻 -> 本机时刻
+    const uint32_t t_local = t_ms - (uint32_t)ctrl_offset_ms - (uint32_t)air_offset_ms;
+    const int32_t e2e = (int32_t)(rx_ms - t_local);
+
+    g_lat.record(e2e > 0 ? (uint32_t)e2e : 0);
+
+    Serial.print("[LAT] t=");
+    Serial.print(t_ms);
+    Serial.print(" e2e_ms=");
+    Serial.print(e2e);
+    Serial.print(" ca_ms=");
+    Serial.print(ctrl_offset_ms);
+    Serial.print(" ag_ms=");
+    Serial.println(air_offset_ms);
+}
+
+// [PROG] 行：程序执行中（或状态变化时）随遥测输出进度与当前生效设定值
+static void printProgramLine(uint8_t state, uint8_t segment, uint32_t seg_elapsed_ms,
+                             float sp_temp_c, float sp_pressure_pa)
+{
+    const bool active = (state == Proto::PROGRAM_RUNNING || state == Proto::PROGRAM_PAUSED);
+    if (!active && state == g_prog_last_state) return;
+    g_prog_last_state = state;
+
+    Serial.print("[PROG] state=");
+    Serial.print(state);
+    Serial.print(" seg=");
+    Serial.print(segment);
+    Serial.print(" t_seg=");
+    Serial.print(seg_elapsed_ms * 0.001f, 2);
+    Serial.print(" sp_T=");
+    Serial.print(sp_temp_c, 2);
+    Serial.print(" sp_P=");
+    Serial.println(sp_pressure_pa, 1);
+}
+
+// [DAQ] 行：每个采样一行，变量按订阅顺序输出（目录中有名称时用名称，否则 v<id>）
+static void printDaqFrame(const uint8_t *payload, uint8_t len)
+{
+    Proto::PayloadDaqV1 h;
+    memcpy(&h, payload, sizeof(h));
+    if (!g_daq.valid || h.list_id != g_daq.list_id) {
+        Serial.print("[DAQ] list=");
+        Serial.print(h.list_id);
+        Serial.println(" layout unknown (daq status)");
+        return;
+    }
+
+    uint8_t row_bytes = 0;
+    for (uint8_t i = 0; i < g_daq.count; ++i) {
+        const uint8_t t = g_daq.types[i];
+        row_bytes = static_cast<uint8_t>(row_bytes + ((t <= Proto::DAQ_T_I8) ? 1 : (t <= Proto::DAQ_T_I16) ? 2 : 4));
+    }
+    if (row_bytes == 0 || sizeof(h) + h.n_samples * row_bytes > len) return;
+
+    if (h.first_sample != g_daq.next_sample) {
+        Serial.print("[DAQ] gap lost=");
+        Serial.println(static_cast<uint16_t>(h.first_sample - g_daq.next_sample));
+    }
+    g_daq.next_sample = static_cast<uint16_t>(h.first_sample + h.n_samples);
+
+    const uint8_t *p = payload + sizeof(h);
+    for (uint8_t r = 0; r < h.n_samples; ++r) {
+        Serial.print("[DAQ] i=");
+        Serial.print(static_cast<uint16_t>(h.first_sample + r));
+        Serial.print(" t=");
+        Serial.print(h.t_ms + static_cast<uint32_t>((static_cast<uint64_t>(r) * g_daq.period_us) / 1000u));
+        for (uint8_t i = 0; i < g_daq.count; ++i) {
+            const uint8_t id = g_daq.ids[i];
+            Serial.print(" ");
+            if (g_daq_vars[id].known) {
+                Serial.print(g_daq_vars[id].name);
+            } else {
+                Serial.print("v");
+                Serial.print(id);
+            }
+            Serial.print("=");
+            switch (g_daq.types[i]) {
+            case Proto::DAQ_T_U8:  Serial.print(p[0]); p += 1; break;
+            case Proto::DAQ_T_I8:  Serial.print(static_cast<int8_t>(p[0])); p += 1; break;
+            case Proto::DAQ_T_U16: { uint16_t v; memcpy(&v, p, 2); Serial.print(v); p += 2; break; }
+            case Proto::DAQ_T_I16: { int16_t v;  memcpy(&v, p, 2); Serial.print(v); p += 2; break; }
+            case Proto::DAQ_T_U32: { uint32_t v; memcpy(&v, p, 4); Serial.print(v); p += 4; break; }
+            case Proto::DAQ_T_I32: { int32_t v;  memcpy(&v, p, 4); Serial.print(v); p += 4; break; }
+            default:               { float v;    memcpy(&v, p, 4); Serial.print(v, 4); p += 4; break; }
+            }
+        }
+        Serial.println();
+    }
+}
+
+// [CAP] 行：捕获记录解码为物理量（无效温度/压力输出 nan）；
+// 温度总是输出 T0、T1，其后只输出到最后一路有效通道（与 [TELEM] 行一致）
+static void printCaptureRecord(uint16_t capture_id, uint16_t index, const Proto::CaptureRecordV1 &r)
+{
+    const uint8_t max_t = sizeof(r.temp_cc) / sizeof(r.temp_cc[0]);
+    uint8_t n_t = 2;
+    for (uint8_t i = n_t; i < max_t; ++i) {
+        if (r.temp_cc[i] != INT16_MIN) n_t = i + 1;
+    }
+
+    Serial.print("[CAP] id=");
+    Serial.print(capture_id);
+    Serial.print(" i=");
+    Serial.print(index);
+    Serial.print(" t16=");
+    Serial.print(r.t_ms);
+    for (uint8_t i = 0; i < n_t; ++i) {
+        Serial.print(" T");
+        Serial.print(i);
+        Serial.print("=");
+        if (r.temp_cc[i] == INT16_MIN) Serial.print("nan");
+        else Serial.print(r.temp_cc[i] * 0.01f, 2);
+    }
+    Serial.print(" P(Pa)=");
+    if (r.pressure_dapa == 0xFFFFu) Serial.print("nan");
+    else Serial.print(static_cast<uint32_t>(r.pressure_dapa) * 10UL);
+    Serial.print(" heater=%=");
+    Serial.print(r.heater_cpct * 0.01f, 2);
+    Serial.print(" valve=%=");
+    Serial.print(r.valve_cpct * 0.01f, 2);
+    Serial.print(" mode=");
+    Serial.print(r.mode);
+    Serial.print(" safety=0x");
+    Serial.println(r.safety, HEX);
+}
+
 static void handleLoRaRx()
 {
     uint8_t buf[256];
     LoRaLink::RxPacket rx;
     if (!LoRaLink::pollReceive(buf, sizeof(buf), rx)) return;
 
-    g_last_lora_pkt_ms = millis();
+    // 收到时刻：时间同步 t4 与端到端延迟均以此为准（在 USB 打印之前取）
+    const uint32_t rx_ms = millis();
+    g_last_lora_pkt_ms = rx_ms;
+    g_m_lora_rx.inc();
+    g_m_lora_rssi.set(rx.rssi);
 
     Serial.print("[LORA] rx len=");
     Serial.print(rx.len);
@@ -457,23 +1587,316 @@ static void handleLoRaRx()
                     Serial.print(g_pending.seq);
                     Serial.print(" status=");
                     Serial.println(ack.status);
-                    g_pending.active = false;
+                    completePending(rx_ms);
                 }
             } else if (f.msg_type == Proto::MSG_TELEM_V1 && f.payload_len == sizeof(Proto::PayloadTelemetryV1)) {
                 Proto::PayloadTelemetryV1 t;
                 memcpy(&t, f.payload, sizeof(t));
-                Serial.print("[TELEM] t=");
-                Serial.print(t.timestamp_ms);
-                Serial.print(" T0=");
-                Serial.print(t.temp_c[0]);
-                Serial.print(" T1=");
-                Serial.print(t.temp_c[1]);
-                Serial.print(" P(Pa)=");
-                Serial.print(t.pressure_pa);
-                Serial.print(" heater=%=");
-                Serial.print(t.heater_power_pct);
-                Serial.print(" valve=%=");
-                Serial.println(t.valve_opening_pct);
+                printTelemLine(t.timestamp_ms, t.temp_count, t.temp_c, 4,
+                               t.pressure_pa, t.heater_power_pct, t.valve_opening_pct);
+            } else if (f.msg_type == Proto::MSG_TELEM_V2 && f.payload_len == sizeof(Proto::PayloadTelemetryV2)) {
+                Proto::PayloadTelemetryV2 t;
+                memcpy(&t, f.payload, sizeof(t));
+                printTelemLine(t.timestamp_ms, t.temp_count, t.temp_c, 8,
+                               t.pressure_pa, t.heater_power_pct, t.valve_opening_pct);
+            } else if (f.msg_type == Proto::MSG_TELEM_V3 && f.payload_len == sizeof(Proto::PayloadTelemetryV3)) {
+                Proto::PayloadTelemetryV3 t;
+                memcpy(&t, f.payload, sizeof(t));
+                printTelemLine(t.timestamp_ms, t.temp_count, t.temp_c, 8,
+                               t.pressure_pa, t.heater_power_pct, t.valve_opening_pct);
+                printLatencyLine(t.timestamp_ms, t.clock_synced != 0, t.clock_offset_ms, rx_ms);
+                printProgramLine(t.prog_state, t.prog_segment, t.prog_seg_elapsed_ms,
+                                 t.sp_temp_c, t.sp_pressure_pa);
+            } else if (f.msg_type == Proto::MSG_TIME_SYNC_REPLY && f.payload_len == sizeof(Proto::PayloadTimeSyncV1)) {
+                Proto::PayloadTimeSyncV1 r;
+                memcpy(&r, f.payload, sizeof(r));
+                // 只接受最近一次请求的应答（迟到的旧应答往返偏大，直接丢弃）
+                if (r.id == g_sync_id) g_sync_air.addSample(r.t1_ms, r.t2_ms, r.t3_ms, rx_ms);
+            } else if (f.msg_type == Proto::MSG_METRICS_V1 && f.payload_len >= sizeof(Proto::PayloadMetricsV1)) {
+                handleMetricsReply(f.payload, f.payload_len, rx_ms);
+            } else if (f.msg_type == Proto::MSG_CMD_TRACE && f.payload_len == sizeof(Proto::PayloadCmdTraceV1)) {
+                Proto::PayloadCmdTraceV1 t;
+                memcpy(&t, f.payload, sizeof(t));
+                handleCmdTrace(f.seq, t, rx_ms);
+            } else if (f.msg_type == Proto::MSG_AUTOTUNE_RESULT && f.payload_len == sizeof(Proto::PayloadAutotuneResultV1)) {
+                Proto::PayloadAutotuneResultV1 r;
+                memcpy(&r, f.payload, sizeof(r));
+                Serial.print("[TUNE] status=");
+                Serial.print(r.status);
+                Serial.print(" cycles=");
+                Serial.print(r.cycles);
+                Serial.print(" a=");
+                Serial.print(r.amplitude_c, 3);
+                Serial.print(" Ku=");
+                Serial.print(r.ku, 4);
+                Serial.print(" Tu(s)=");
+                Serial.print(r.tu_s, 2);
+                Serial.print(" kp=");
+                Serial.print(r.kp, 4);
+                Serial.print(" ki=");
+                Serial.print(r.ki, 5);
+                Serial.print(" kd=");
+                Serial.println(r.kd, 3);
+            } else if (f.msg_type == Proto::MSG_TELEM_DIAG_V1 && f.payload_len == sizeof(Proto::PayloadTelemDiagV1)) {
+                Proto::PayloadTelemDiagV1 d;
+                memcpy(&d, f.payload, sizeof(d));
+                Serial.print("[DIAG] t=");
+                Serial.print(d.timestamp_ms);
+                Serial.print(" period_us=");
+                Serial.print(d.ctrl_period_us);
+                Serial.print(" ticks=");
+                Serial.print(d.ctrl_ticks);
+                Serial.print(" overruns=");
+                Serial.print(d.ctrl_overruns);
+                Serial.print(" jit_max_us=");
+                Serial.print(d.ctrl_jitter_max_us);
+                Serial.print(" jit_avg_us=");
+                Serial.print(d.ctrl_jitter_avg_us);
+                Serial.print(" exec_max_us=");
+                Serial.print(d.ctrl_exec_max_us);
+                Serial.print(" valve_cmd=%=");
+                Serial.print(d.valve_cmd_cpct * 0.01f, 2);
+                Serial.print(" valve_duty=%=");
+                Serial.print(d.valve_duty_cpct * 0.01f, 2);
+                Serial.print(" safety=0x");
+                Serial.print(d.safety_active, HEX);
+                Serial.print(" last_trip=0x");
+                Serial.print(d.safety_last_trip, HEX);
+                Serial.print(" trips=");
+                Serial.print(d.safety_trips);
+                Serial.print(" react_us=");
+                Serial.print(d.safety_react_last_us);
+                Serial.print(" react_max_us=");
+                Serial.print(d.safety_react_max_us);
+                Serial.print(" txq=");
+                Serial.print(d.uart_txq_bytes);
+                Serial.print(" txq_max=");
+                Serial.print(d.uart_txq_max);
+                Serial.print(" tx_drop=");
+                Serial.print(d.uart_tx_drops);
+                Serial.print(" telem_ovw=");
+                Serial.print(d.uart_telem_overwrites);
+                Serial.print(" diag_ovw=");
+                Serial.println(d.uart_diag_overwrites);
+            } else if (f.msg_type == Proto::MSG_PROFILE_V1 && f.payload_len == sizeof(Proto::PayloadProfileV1)) {
+                static const char *const kStageNames[Proto::PROFILE_STAGES] = {
+                    "sensors_poll", "link_poll", "sensors_read", "mode_compute", "safety_check", "actuators_apply"
+                };
+                Proto::PayloadProfileV1 pr;
+                memcpy(&pr, f.payload, sizeof(pr));
+                const float k = (pr.cycles_per_us > 0) ? 1.0f / pr.cycles_per_us : 1.0f;
+                const uint8_t n = (pr.stage_count > Proto::PROFILE_STAGES) ? Proto::PROFILE_STAGES : pr.stage_count;
+                for (uint8_t i = 0; i < n; ++i) {
+                    Serial.print("[PROF] t=");
+                    Serial.print(pr.timestamp_ms);
+                    Serial.print(" stage=");
+                    Serial.print(kStageNames[i]);
+                    Serial.print(" n=");
+                    Serial.print(pr.stage[i].count);
+                    Serial.print(" min_us=");
+                    Serial.print(pr.stage[i].min_cyc * k, 2);
+                    Serial.print(" mean_us=");
+                    Serial.print(pr.stage[i].mean_cyc * k, 2);
+                    Serial.print(" p99_us=");
+                    Serial.print(pr.stage[i].p99_cyc * k, 2);
+                    Serial.print(" max_us=");
+                    Serial.println(pr.stage[i].max_cyc * k, 2);
+                }
+            } else if (f.msg_type == Proto::MSG_CONFIG_VALUE && f.payload_len == sizeof(Proto::PayloadConfigValueV1)) {
+                Proto::PayloadConfigValueV1 cv;
+                memcpy(&cv, f.payload, sizeof(cv));
+                Serial.print("[CFG] op=");
+                Serial.print(cv.op);
+                Serial.print(" id=");
+                Serial.print(cv.id);
+                Serial.print(" value=");
+                Serial.print(cv.value, 4);
+                Serial.print(" status=");
+                Serial.print(cv.status);
+                Serial.print(" dirty=");
+                Serial.print(cv.dirty);
+                Serial.print(" commit_seq=");
+                Serial.println(cv.commit_seq);
+
+                // 应答即完成可靠下发（控制器不另回 ACK）
+                if (g_pending.active && f.seq == g_pending.seq && g_pending.msg_type == Proto::MSG_CONFIG_CMD) {
+                    completePending(rx_ms);
+                }
+            } else if (f.msg_type == Proto::MSG_PARAM_REPLY && f.payload_len >= sizeof(Proto::PayloadParamReplyV1)) {
+                Proto::PayloadParamReplyV1 pr;
+                memcpy(&pr, f.payload, sizeof(pr));
+                Serial.print("[PARAM] op=");
+                Serial.print(pr.op);
+                Serial.print(" status=");
+                Serial.print(pr.status);
+                Serial.print(" version=");
+                Serial.print(pr.version);
+                Serial.print(" staged=");
+                Serial.print(pr.staged);
+                Serial.print(" n=");
+                Serial.println(pr.count);
+                g_param_version = pr.version;
+
+                const uint8_t *items = f.payload + sizeof(pr);
+                const size_t avail = f.payload_len - sizeof(pr);
+                for (uint8_t i = 0; i < pr.count; ++i) {
+                    if (pr.op == Proto::PARAM_OP_INFO) {
+                        Proto::ParamInfoItemV1 it;
+                        if ((i + 1u) * sizeof(it) > avail) break;
+                        memcpy(&it, items + i * sizeof(it), sizeof(it));
+                        Serial.print("[PARAM] ");
+                        printConfigName(it.id);
+                        Serial.print(" id=");
+                        Serial.print(it.id);
+                        Serial.print(it.type == Proto::DAQ_T_U32 ? " u32" : " f32");
+                        Serial.print(" min=");
+                        Serial.print(it.min_v, 6);
+                        Serial.print(" max=");
+                        Serial.println(it.max_v, 6);
+                    } else {
+                        Proto::ParamValueItemV1 it;
+                        if ((i + 1u) * sizeof(it) > avail) break;
+                        memcpy(&it, items + i * sizeof(it), sizeof(it));
+                        Serial.print("[PARAM] ");
+                        printConfigName(it.id);
+                        Serial.print("=");
+                        if (it.type == Proto::DAQ_T_U32) Serial.print(static_cast<uint32_t>(it.value));
+                        else Serial.print(it.value, 6);
+                        if (it.status != Proto::CONFIG_OK) {
+                            Serial.print(" status=");
+                            Serial.print(it.status);
+                        }
+                        Serial.println();
+                    }
+                }
+                if (pr.status == Proto::CONFIG_ERR_VERSION) {
+                    Serial.println("WARN: parameters changed since last read, check with 'param get' and retry");
+                }
+
+                // 应答即完成可靠下发（控制器不另回 ACK）
+                if (g_pending.active && f.seq == g_pending.seq && g_pending.msg_type == Proto::MSG_PARAM_BATCH) {
+                    completePending(rx_ms);
+                }
+            } else if (f.msg_type == Proto::MSG_DAQ_V1 && f.payload_len >= sizeof(Proto::PayloadDaqV1)) {
+                printDaqFrame(f.payload, f.payload_len);
+            } else if (f.msg_type == Proto::MSG_DAQ_STATUS && f.payload_len == sizeof(Proto::PayloadDaqStatusV1)) {
+                Proto::PayloadDaqStatusV1 ds;
+                memcpy(&ds, f.payload, sizeof(ds));
+                Serial.print("[DAQSTAT] status=");
+                Serial.print(ds.status);
+                Serial.print(" list=");
+                Serial.print(ds.list_id);
+                Serial.print(" active=");
+                Serial.print(ds.active);
+                Serial.print(" div=");
+                Serial.print(ds.divider);
+                Serial.print(" rows=");
+                Serial.print(ds.samples_per_frame);
+                Serial.print(" period_us=");
+                Serial.print(ds.sample_period_us);
+                Serial.print(" frames=");
+                Serial.print(ds.frames);
+                Serial.print(" overruns=");
+                Serial.print(ds.overruns);
+                Serial.print(" vars=");
+                const uint8_t n = (ds.count > Proto::DAQ_MAX_VARS) ? Proto::DAQ_MAX_VARS : ds.count;
+                for (uint8_t i = 0; i < n; ++i) {
+                    if (i) Serial.print(",");
+                    Serial.print(ds.ids[i]);
+                }
+                Serial.println();
+
+                // 更新解码布局；同一订阅的重复状态不重置采样序号
+                if (!(g_daq.valid && g_daq.list_id == ds.list_id)) g_daq.next_sample = 0;
+                g_daq.valid = ds.active != 0;
+                g_daq.list_id = ds.list_id;
+                g_daq.count = n;
+                memcpy(g_daq.ids, ds.ids, n);
+                memcpy(g_daq.types, ds.types, n);
+                g_daq.period_us = ds.sample_period_us;
+
+                if (g_pending.active && f.seq == g_pending.seq && g_pending.msg_type == Proto::MSG_DAQ_CMD) {
+                    completePending(rx_ms);
+                }
+            } else if (f.msg_type == Proto::MSG_DAQ_CATALOG && f.payload_len >= sizeof(Proto::PayloadDaqCatalogV1)) {
+                Proto::PayloadDaqCatalogV1 dc;
+                memcpy(&dc, f.payload, sizeof(dc));
+                const size_t avail = (f.payload_len - sizeof(dc)) / sizeof(Proto::DaqCatalogEntryV1);
+                const uint8_t n = (dc.count <= avail) ? dc.count : static_cast<uint8_t>(avail);
+                for (uint8_t i = 0; i < n; ++i) {
+                    Proto::DaqCatalogEntryV1 e;
+                    memcpy(&e, f.payload + sizeof(dc) + i * sizeof(e), sizeof(e));
+                    e.name[sizeof(e.name) - 1] = 0;
+                    DaqVarInfo &v = g_daq_vars[e.id];
+                    memcpy(v.name, e.name, sizeof(v.name));
+                    v.type = e.type;
+                    v.known = true;
+                    Serial.print("[DAQVAR] id=");
+                    Serial.print(e.id);
+                    Serial.print(" type=");
+                    Serial.print(e.type);
+                    Serial.print(" name=");
+                    Serial.println(e.name);
+                }
+                Serial.print("[DAQVAR] first=");
+                Serial.print(dc.first);
+                Serial.print(" count=");
+                Serial.print(n);
+                Serial.print(" total=");
+                Serial.println(dc.total);
+            } else if (f.msg_type == Proto::MSG_CAPTURE_INFO && f.payload_len == sizeof(Proto::PayloadCaptureInfoV1)) {
+                Proto::PayloadCaptureInfoV1 ci;
+                memcpy(&ci, f.payload, sizeof(ci));
+                Serial.print("[CAPINFO] id=");
+                Serial.print(ci.capture_id);
+                Serial.print(" state=");
+                Serial.print(ci.state);
+                Serial.print(" reason=");
+                Serial.print(ci.reason);
+                Serial.print(" count=");
+                Serial.print(ci.count);
+                Serial.print(" pre=");
+                Serial.print(ci.pre_count);
+                Serial.print(" period_us=");
+                Serial.print(ci.period_us);
+                Serial.print(" t_trig=");
+                Serial.println(ci.trigger_ms);
+
+                // 捕获冻结：自动开始下载
+                if (ci.state == Proto::CAPTURE_READY && ci.count > 0 &&
+                    !(g_cap.active && g_cap.capture_id == ci.capture_id)) {
+                    g_cap.active = true;
+                    g_cap.capture_id = ci.capture_id;
+                    g_cap.count = ci.count;
+                    g_cap.next = 0;
+                    g_cap.retry = 0;
+                    requestCaptureChunk(millis());
+                }
+            } else if (f.msg_type == Proto::MSG_CAPTURE_CHUNK && f.payload_len >= sizeof(Proto::PayloadCaptureChunkV1)) {
+                Proto::PayloadCaptureChunkV1 h;
+                memcpy(&h, f.payload, sizeof(h));
+                const size_t avail = (f.payload_len - sizeof(h)) / sizeof(Proto::CaptureRecordV1);
+                const uint8_t n = (h.count <= avail) ? h.count : static_cast<uint8_t>(avail);
+                for (uint8_t i = 0; i < n; ++i) {
+                    Proto::CaptureRecordV1 r;
+                    memcpy(&r, f.payload + sizeof(h) + i * sizeof(r), sizeof(r));
+                    printCaptureRecord(h.capture_id, static_cast<uint16_t>(h.index + i), r);
+                }
+
+                if (g_cap.active && h.index == g_cap.next) {
+                    g_cap.capture_id = h.capture_id;
+                    g_cap.next = static_cast<uint16_t>(g_cap.next + n);
+                    g_cap.retry = 0;
+                    if (n == 0 || (g_cap.count > 0 && g_cap.next >= g_cap.count)) {
+                        Serial.print("[CAPINFO] download done id=");
+                        Serial.print(g_cap.capture_id);
+                        Serial.print(" records=");
+                        Serial.println(g_cap.next);
+                        g_cap.active = false;
+                    } else {
+                        requestCaptureChunk(millis());
+                    }
+                }
             } else {
                 Serial.print("[RX] msg=0x");
                 Serial.print(f.msg_type, HEX);
@@ -484,6 +1907,7 @@ static void handleLoRaRx()
     }
 
     if (frames == 0) {
+        g_m_lora_rx_bad.inc();
         Serial.println("[LORA] packet did not contain a valid frame (ignored)");
     }
 }
@@ -511,6 +1935,15 @@ void loop()
     // 1.5) 可靠下行：若超时未收到 ACK，则自动重发
     serviceReliableSend(now_ms);
 
+    // 1.55) 高速捕获下载：分块超时重发请求
+    serviceCaptureDownload(now_ms);
+
+    // 1.57) 运行指标拉取：分块超时重发请求
+    serviceMetricsPull(now_ms);
+
+    // 1.58) 时间同步：空闲时周期发起
+    serviceTimeSync(now_ms);
+
     // 1.6) LoRa 健康监测：必要时自动重置射频
     serviceLoRaWatchdog(now_ms);
 
@@ -519,6 +1952,7 @@ void loop()
         const char c = static_cast<char>(Serial.read());
         if (c == '\n') {
             g_line_buf[g_line_len] = 0;
+            g_line_rx_ms = millis();
             handleLine(g_line_buf);
             g_line_len = 0;
         } else if (c == '\r') {
@@ -6,15 +6,39 @@
 namespace Proto {
 
 static constexpr uint8_t MSG_TELEM_V1      = 0x01;
+static constexpr uint8_t MSG_TELEM_DIAG_V1 = 0x02;
+static constexpr uint8_t MSG_TELEM_V2      = 0x03;
+static constexpr uint8_t MSG_PROFILE_V1    = 0x04;
+static constexpr uint8_t MSG_DAQ_V1        = 0x05;
+static constexpr uint8_t MSG_TELEM_V3      = 0x06;
 static constexpr uint8_t MSG_MODE_SWITCH   = 0x10;
 static constexpr uint8_t MSG_SETPOINTS_V1  = 0x11;
 static constexpr uint8_t MSG_MANUAL_CMD_V1 = 0x12;
+static constexpr uint8_t MSG_CAPTURE_CMD   = 0x13;
+static constexpr uint8_t MSG_PROGRAM_V1    = 0x14;
+static constexpr uint8_t MSG_PROGRAM_CTRL  = 0x15;
+static constexpr uint8_t MSG_CONFIG_CMD    = 0x16;
+static constexpr uint8_t MSG_DAQ_CMD       = 0x17;
+static constexpr uint8_t MSG_PARAM_BATCH   = 0x18;
+static constexpr uint8_t MSG_TIME_SYNC     = 0x19;
+static constexpr uint8_t MSG_METRICS_CMD   = 0x1A;
 static constexpr uint8_t MSG_ACK           = 0x20;
 static constexpr uint8_t MSG_HEARTBEAT     = 0x23;
+static constexpr uint8_t MSG_AUTOTUNE_RESULT = 0x30;
+static constexpr uint8_t MSG_CAPTURE_INFO  = 0x31;
+static constexpr uint8_t MSG_CAPTURE_CHUNK = 0x32;
+static constexpr uint8_t MSG_CONFIG_VALUE  = 0x33;
+static constexpr uint8_t MSG_DAQ_STATUS    = 0x34;
+static constexpr uint8_t MSG_DAQ_CATALOG   = 0x35;
+static constexpr uint8_t MSG_PARAM_REPLY   = 0x36;
+static constexpr uint8_t MSG_TIME_SYNC_REPLY = 0x37;
+static constexpr uint8_t MSG_CMD_TRACE     = 0x38;
+static constexpr uint8_t MSG_METRICS_V1    = 0x39;
 
 static constexpr uint8_t MODE_SAFE   = 0;
 static constexpr uint8_t MODE_MANUAL = 1;
 static constexpr uint8_t MODE_AUTO   = 2;
+static constexpr uint8_t MODE_AUTOTUNE = 3;
 
 static constexpr uint8_t ACK_OK  = 0;
 static constexpr uint8_t ACK_ERR = 1;
@@ -54,8 +78,394 @@ struct PayloadTelemetryV1 {
     float    valve_opening_pct;
 };
 
+struct PayloadTelemetryV2 {
+    uint32_t timestamp_ms;
+    uint8_t  temp_count;
+    float    temp_c[8];
+    float    pressure_pa;
+    float    heater_power_pct;
+    float    valve_opening_pct;
+};
+
+struct PayloadTelemetryV3 {
+    uint32_t timestamp_ms;
+    uint8_t  temp_count;
+    float    temp_c[8];
+    float    pressure_pa;
+    float    heater_power_pct;
+    float    valve_opening_pct;
+    uint8_t  prog_state;
+    uint8_t  prog_segment;
+    uint32_t prog_seg_elapsed_ms;
+    float    sp_temp_c;
+    float    sp_pressure_pa;
+    int32_t  clock_offset_ms;
+    uint8_t  clock_synced;
+};
+
+struct PayloadTelemDiagV1 {
+    uint32_t timestamp_ms;
+    uint32_t ctrl_period_us;
+    uint32_t ctrl_ticks;
+    uint32_t ctrl_overruns;
+    uint16_t ctrl_jitter_max_us;
+    uint16_t ctrl_jitter_avg_us;
+    uint16_t ctrl_exec_max_us;
+    uint16_t valve_cmd_cpct;
+    uint16_t valve_duty_cpct;
+    uint8_t  safety_active;
+    uint8_t  safety_last_trip;
+    uint16_t safety_trips;
+    uint16_t safety_react_last_us;
+    uint16_t safety_react_max_us;
+    uint16_t uart_txq_bytes;
+    uint16_t uart_txq_max;
+    uint16_t uart_tx_drops;
+    uint16_t uart_telem_overwrites;
+    uint16_t uart_diag_overwrites;
+};
+
+struct PayloadAutotuneResultV1 {
+    uint8_t status;
+    uint8_t cycles;
+    float   amplitude_c;
+    float   ku;
+    float   tu_s;
+    float   kp;
+    float   ki;
+    float   kd;
+};
+
+struct PayloadCaptureCmd {
+    uint8_t  op;
+    uint16_t index;
+};
+
+struct PayloadCaptureInfoV1 {
+    uint8_t  state;
+    uint8_t  reason;
+    uint16_t capture_id;
+    uint16_t count;
+    uint16_t pre_count;
+    uint16_t period_us;
+    uint8_t  record_size;
+    uint32_t trigger_ms;
+};
+
+struct CaptureRecordV1 {
+    uint16_t t_ms;
+    int16_t  temp_cc[8];
+    uint16_t pressure_dapa;
+    uint16_t heater_cpct;
+    uint16_t valve_cpct;
+    uint8_t  mode;
+    uint8_t  safety;
+};
+
+struct PayloadCaptureChunkV1 {
+    uint16_t capture_id;
+    uint16_t index;
+    uint8_t  count;
+};
+
+struct ProfileStageV1 {
+    uint16_t count;
+    uint32_t min_cyc;
+    uint32_t mean_cyc;
+    uint32_t p99_cyc;
+    uint32_t max_cyc;
+};
+
+struct PayloadProfileV1 {
+    uint32_t timestamp_ms;
+    uint8_t  cycles_per_us;
+    uint8_t  stage_count;
+    ProfileStageV1 stage[6];
+};
+
+struct ProgramSegmentV1 {
+    uint8_t  type;
+    uint8_t  enable_mask;
+    float    temp_c;
+    float    pressure_pa;
+    uint32_t duration_ms;
+};
+
+struct PayloadProgramV1 {
+    uint8_t count;
+};
+
+struct PayloadProgramCtrl {
+    uint8_t op;
+};
+
+struct PayloadConfigCmd {
+    uint8_t op;
+    uint8_t id;
+    float   value;
+};
+
+struct PayloadConfigValueV1 {
+    uint8_t  op;
+    uint8_t  id;
+    uint8_t  status;
+    uint8_t  dirty;
+    float    value;
+    uint32_t commit_seq;
+};
+
+struct PayloadDaqCmdV1 {
+    uint8_t  op;
+    uint8_t  index;
+    uint16_t divider;
+    uint8_t  samples_per_frame;
+    uint8_t  count;
+};
+
+struct PayloadDaqStatusV1 {
+    uint8_t  status;
+    uint8_t  list_id;
+    uint8_t  active;
+    uint8_t  count;
+    uint16_t divider;
+    uint8_t  samples_per_frame;
+    uint8_t  row_bytes;
+    uint32_t sample_period_us;
+    uint32_t frames;
+    uint32_t overruns;
+    uint8_t  ids[16];
+    uint8_t  types[16];
+};
+
+struct DaqCatalogEntryV1 {
+    uint8_t id;
+    uint8_t type;
+    char    name[14];
+};
+
+struct PayloadDaqCatalogV1 {
+    uint8_t total;
+    uint8_t first;
+    uint8_t count;
+};
+
+struct PayloadDaqV1 {
+    uint8_t  list_id;
+    uint8_t  n_samples;
+    uint16_t first_sample;
+    uint32_t t_ms;
+};
+
+struct PayloadParamBatchV1 {
+    uint8_t  op;
+    uint8_t  count;
+    uint8_t  first;
+    uint8_t  reserved;
+    uint32_t expect_version;
+};
+
+struct ParamSetItemV1 {
+    uint8_t id;
+    float   value;
+};
+
+struct PayloadParamReplyV1 {
+    uint8_t  op;
+    uint8_t  status;
+    uint8_t  count;
+    uint8_t  staged;
+    uint32_t version;
+};
+
+struct ParamValueItemV1 {
+    uint8_t id;
+    uint8_t type;
+    uint8_t status;
+    float   value;
+};
+
+struct ParamInfoItemV1 {
+    uint8_t id;
+    uint8_t type;
+    float   min_v;
+    float   max_v;
+};
+
+struct PayloadTimeSyncV1 {
+    uint8_t  id;
+    uint8_t  synced;
+    int16_t  drift_ppm;
+    uint32_t t1_ms;
+    uint32_t t2_ms;
+    uint32_t t3_ms;
+    int32_t  offset_ms;
+    uint16_t rtt_ms;
+    uint16_t reserved;
+};
+
+struct PayloadCmdTraceV1 {
+    uint8_t  msg_type;
+    uint8_t  flags;
+    uint16_t reserved;
+    uint32_t ctrl_parse_ms;
+    uint32_t ctrl_apply_ms;
+    uint32_t air_lora_rx_ms;
+    uint32_t air_uart_tx_ms;
+    int32_t  ctrl_air_offset_ms;
+};
+
+struct PayloadMetricsCmdV1 {
+    uint8_t node;
+    uint8_t op;
+    uint8_t first;
+    uint8_t reserved;
+};
+
+struct PayloadMetricsV1 {
+    uint8_t  node;
+    uint8_t  op;
+    uint8_t  first;
+    uint8_t  count;
+    uint8_t  total;
+    uint8_t  reserved;
+    uint32_t schema;
+    uint32_t uptime_ms;
+};
+
+struct MetricValueV1 {
+    uint8_t index;
+    uint8_t kind;
+};
+
+struct MetricHistV1 {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint8_t  lo;
+    uint8_t  n;
+};
+
+struct MetricInfoV1 {
+    uint8_t index;
+    uint8_t kind;
+    char    name[14];
+};
+
 #pragma pack(pop)
 
+static constexpr uint8_t TUNE_DONE           = 0;
+static constexpr uint8_t TUNE_ABORT_LIMIT    = 1;
+static constexpr uint8_t TUNE_ABORT_SENSOR   = 2;
+static constexpr uint8_t TUNE_ABORT_TIMEOUT  = 3;
+static constexpr uint8_t TUNE_ABORT_EXTERNAL = 4;
+static constexpr uint8_t TUNE_REJECTED       = 5;
+
+static constexpr uint8_t SAFETY_TRIP_OVERTEMP    = 1u << 0;
+static constexpr uint8_t SAFETY_TRIP_TEMP_RATE   = 1u << 1;
+static constexpr uint8_t SAFETY_TRIP_OVERPRESS   = 1u << 2;
+static constexpr uint8_t SAFETY_TRIP_TEMP_FAULT  = 1u << 3;
+static constexpr uint8_t SAFETY_TRIP_PRESS_FAULT = 1u << 4;
+
+static constexpr uint8_t CAPTURE_OP_INFO    = 0;
+static constexpr uint8_t CAPTURE_OP_TRIGGER = 1;
+static constexpr uint8_t CAPTURE_OP_ARM     = 2;
+static constexpr uint8_t CAPTURE_OP_READ    = 3;
+
+static constexpr uint8_t CAPTURE_ARMED   = 0;
+static constexpr uint8_t CAPTURE_POST    = 1;
+static constexpr uint8_t CAPTURE_READY   = 2;
+
+static constexpr uint8_t CAPTURE_REASON_NONE     = 0;
+static constexpr uint8_t CAPTURE_REASON_SAFETY   = 1;
+static constexpr uint8_t CAPTURE_REASON_OPERATOR = 2;
+
+static constexpr uint8_t CAPTURE_CHUNK_RECORDS = 6;
+
+static constexpr uint8_t PROFILE_STAGES = 6;
+
+static constexpr uint8_t PROGRAM_MAX_SEGMENTS = 12;
+
+static constexpr uint8_t PROGRAM_SEG_RAMP = 0;
+static constexpr uint8_t PROGRAM_SEG_HOLD = 1;
+static constexpr uint8_t PROGRAM_SEG_STEP = 2;
+
+static constexpr uint8_t PROGRAM_OP_START  = 0;
+static constexpr uint8_t PROGRAM_OP_STOP   = 1;
+static constexpr uint8_t PROGRAM_OP_PAUSE  = 2;
+static constexpr uint8_t PROGRAM_OP_RESUME = 3;
+
+static constexpr uint8_t PROGRAM_EMPTY   = 0;
+static constexpr uint8_t PROGRAM_READY   = 1;
+static constexpr uint8_t PROGRAM_RUNNING = 2;
+static constexpr uint8_t PROGRAM_PAUSED  = 3;
+static constexpr uint8_t PROGRAM_DONE    = 4;
+static constexpr uint8_t PROGRAM_ABORTED = 5;
+
+static constexpr uint8_t CONFIG_OP_GET      = 0;
+static constexpr uint8_t CONFIG_OP_SET      = 1;
+static constexpr uint8_t CONFIG_OP_COMMIT   = 2;
+static constexpr uint8_t CONFIG_OP_DEFAULTS = 3;
+static constexpr uint8_t CONFIG_OP_RELOAD   = 4;
+
+static constexpr uint8_t CONFIG_OK         = 0;
+static constexpr uint8_t CONFIG_ERR_ID     = 1;
+static constexpr uint8_t CONFIG_ERR_RANGE  = 2;
+static constexpr uint8_t CONFIG_ERR_STATE  = 3;
+static constexpr uint8_t CONFIG_ERR_FLASH  = 4;
+static constexpr uint8_t CONFIG_ERR_OP     = 5;
+static constexpr uint8_t CONFIG_ERR_VERSION = 6;
+
+static constexpr uint8_t CFG_PRESS_V0_MV         = 0;
+static constexpr uint8_t CFG_PRESS_SENS_MV_KPA   = 1;
+static constexpr uint8_t CFG_SAFETY_MAX_TEMP_C   = 2;
+static constexpr uint8_t CFG_TELEMETRY_PERIOD_MS = 3;
+static constexpr uint8_t CFG_DIAG_PERIOD_MS      = 4;
+static constexpr uint8_t CFG_SAFETY_MAX_PRESS_PA = 5;
+static constexpr uint8_t CFG_SAFETY_MAX_RATE_C_S = 6;
+static constexpr uint8_t CFG_RTD_RREF_0          = 8;
+static constexpr uint8_t CFG_RTD_RREF_COUNT      = 8;
+static constexpr uint8_t CFG_TEMP_KP             = 16;
+static constexpr uint8_t CFG_TEMP_KI             = 17;
+static constexpr uint8_t CFG_TEMP_KD             = 18;
+static constexpr uint8_t CFG_TEMP_D_TAU_S        = 19;
+static constexpr uint8_t CFG_CASCADE_KP          = 20;
+static constexpr uint8_t CFG_CASCADE_KI          = 21;
+static constexpr uint8_t CFG_PRESS_KP            = 22;
+static constexpr uint8_t CFG_PRESS_KI            = 23;
+static constexpr uint8_t CFG_PRESS_KD            = 24;
+static constexpr uint8_t CFG_ID_LIMIT            = 32;
+
+static constexpr uint8_t PARAM_OP_GET        = 0;
+static constexpr uint8_t PARAM_OP_STAGE      = 1;
+static constexpr uint8_t PARAM_OP_COMMIT     = 2;
+static constexpr uint8_t PARAM_OP_ROLLBACK   = 3;
+static constexpr uint8_t PARAM_OP_SET_COMMIT = 4;
+static constexpr uint8_t PARAM_OP_INFO       = 5;
+
+static constexpr uint8_t PARAM_BATCH_MAX = 24;
+
+static constexpr uint8_t DAQ_MAX_VARS        = 16;
+static constexpr uint8_t DAQ_CATALOG_ENTRIES = 12;
+
+static constexpr uint8_t DAQ_OP_STOP    = 0;
+static constexpr uint8_t DAQ_OP_START   = 1;
+static constexpr uint8_t DAQ_OP_STATUS  = 2;
+static constexpr uint8_t DAQ_OP_CATALOG = 3;
+
+static constexpr uint8_t DAQ_OK       = 0;
+static constexpr uint8_t DAQ_ERR_ID   = 1;
+static constexpr uint8_t DAQ_ERR_SIZE = 2;
+static constexpr uint8_t DAQ_ERR_OP   = 3;
+
+static constexpr uint8_t DAQ_T_U8  = 0;
+static constexpr uint8_t DAQ_T_I8  = 1;
+static constexpr uint8_t DAQ_T_U16 = 2;
+static constexpr uint8_t DAQ_T_I16 = 3;
+static constexpr uint8_t DAQ_T_U32 = 4;
+static constexpr uint8_t DAQ_T_I32 = 5;
+static constexpr uint8_t DAQ_T_F32 = 6;
+
 static constexpr uint8_t MAN_FLAG_HEATER = 1u << 0;
 static constexpr uint8_t MAN_FLAG_VALVE  = 1u << 1;
 static constexpr uint8_t MAN_FLAG_PUMP   = 1u << 2;
@@ -65,4 +475,20 @@ static constexpr uint8_t SP_ENABLE_PRESSURE = 1u << 1;
 static constexpr uint8_t SP_ENABLE_VALVE    = 1u << 2;
 static constexpr uint8_t SP_ENABLE_PUMP     = 1u << 3;
 
+static constexpr uint8_t TRACE_FLAG_AIR         = 1u << 0;
+static constexpr uint8_t TRACE_FLAG_CTRL_SYNCED = 1u << 1;
+
+static constexpr uint8_t METRICS_NODE_GROUND = 0;
+static constexpr uint8_t METRICS_NODE_AIR    = 1;
+static constexpr uint8_t METRICS_NODE_CTRL   = 2;
+
+static constexpr uint8_t METRICS_OP_SNAPSHOT = 0;
+static constexpr uint8_t METRICS_OP_CATALOG  = 1;
+
+static constexpr uint8_t METRIC_COUNTER   = 0;
+static constexpr uint8_t METRIC_GAUGE     = 1;
+static constexpr uint8_t METRIC_HISTOGRAM = 2;
+
+static constexpr uint8_t METRICS_HIST_BUCKETS = 24;
+
 } // namespace Proto
@@ -46,4 +46,17 @@ static constexpr uint32_t LORA_TX_GUARD_MS = 5;
 static constexpr uint32_t CMD_ACK_TIMEOUT_MS = 400;
 static constexpr uint8_t  CMD_MAX_RETRY      = 3;
 
+// 高速捕获下载：逐块请求，超时未收到该块则重发请求
+static constexpr uint32_t CAPTURE_CHUNK_TIMEOUT_MS = 1000;
+static constexpr uint8_t  CAPTURE_MAX_RETRY        = 5;
+
+// 时间同步（地面 ↔ 空中端，LoRa）：空闲时（无待确认命令）周期发起一次交换，不重发；
+// 超过 TIME_SYNC_VALID_MS 无有效样本则不再输出端到端延迟
+static constexpr uint32_t TIME_SYNC_LORA_PERIOD_MS = 5000;
+static constexpr uint32_t TIME_SYNC_VALID_MS       = 30000;
+
+// 运行指标拉取（metrics air|ctrl）：逐块请求目录/快照，超时未收到该块则重发请求
+static constexpr uint32_t METRICS_TIMEOUT_MS = 1000;
+static constexpr uint8_t  METRICS_MAX_RETRY  = 3;
+
 } // namespace BoardConfig
@@ -12,9 +12,9 @@ import time
 from dataclasses import dataclass
 from datetime import datetime
 from collections import deque
-from typing import Deque, List, Optional, Tuple
+from typing import Deque, Dict, List, Optional, Tuple
 
-from host_gui.core.protocol import TelemetryFrame
+from host_gui.core.protocol import TelemetryFrame, CaptureInfo, CaptureRecord
 from host_gui.core.filtering import FilterConfig, FilterEngine
 
 
@@ -317,3 +317,77 @@ class TelemetryStore:
             list(self.temp1_f),
             list(self.press_kpa_f),
         )
+
+
+class CaptureStore:
+    """Collects one downloaded high-rate capture (``[CAPINFO]`` + ``[CAP]`` lines).
+
+    Records of other capture ids than the latest ``[CAPINFO]`` are ignored; a new id
+    starts over. Once every record of a ready capture has arrived it can be exported.
+    """
+
+    def __init__(self):
+        self.info: Optional[CaptureInfo] = None
+        self._records: Dict[int, CaptureRecord] = {}
+
+    def add_info(self, info: CaptureInfo) -> None:
+        if self.info is None or info.capture_id != self.info.capture_id:
+            self._records = {}
+        self.info = info
+
+    def add_record(self, rec: CaptureRecord) -> bool:
+        """Store one record; return True when this record completed the capture."""
+        if self.info is None or rec.capture_id != self.info.capture_id:
+            return False
+        if rec.index >= self.info.count or rec.index in self._records:
+            return False
+        self._records[rec.index] = rec
+        return self.complete()
+
+    def received(self) -> int:
+        return len(self._records)
+
+    def complete(self) -> bool:
+        # state 2 = ready (post-trigger part finished)
+        return (
+            self.info is not None
+            and self.info.state == 2
+            and self.info.count > 0
+            and len(self._records) == self.info.count
+        )
+
+    def default_csv_name(self) -> str:
+        ts = datetime.now().strftime("%Y%m%d_%H%M%S")
+        cid = self.info.capture_id if self.info else 0
+        return f"h2_capture_{cid}_{ts}.csv"
+
+    def write_csv(self, filename: str) -> None:
+        """Write the records in index order.
+
+        ``t_ms`` unwraps the 16-bit timestamps and is relative to the first record;
+        ``pre`` is 1 for records from before the trigger.
+        """
+        os.makedirs(os.path.dirname(os.path.abspath(filename)), exist_ok=True)
+        recs = [self._records[i] for i in sorted(self._records)]
+        n_t = max((len(r.temps_c) for r in recs), default=0)
+        pre_count = self.info.pre_count if self.info else 0
+
+        header = ["index", "pre", "t_ms", "t16_ms"]
+        header += [f"T{i}_C" for i in range(n_t)]
+        header += ["P_Pa", "heater_pct", "valve_pct", "mode", "safety_mask"]
+
+        with open(filename, "w", encoding="utf-8-sig", newline="") as f:
+            w = csv.writer(f)
+            w.writerow(header)
+            t_ms = 0
+            prev16 = None
+            for r in recs:
+                if prev16 is not None:
+                    t_ms += (r.t16_ms - prev16) & 0xFFFF
+                prev16 = r.t16_ms
+                temps = list(r.temps_c) + [float("nan")] * (n_t - len(r.temps_c))
+                w.writerow(
+                    [r.index, 1 if r.index < pre_count else 0, t_ms, r.t16_ms]
+                    + temps
+                    + [r.p_pa, r.heater_pct, r.valve_pct, r.mode, f"0x{r.safety_mask:X}"]
+                )
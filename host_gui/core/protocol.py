@@ -10,6 +10,7 @@ Supported line types
 --------------------
 - Telemetry:
     ``[TELEM] t=1234 T0=20.5 T1=20.6 P(Pa)=101.3 heater=%=0.0 valve=%=0.0``
+    (with more than 2 channels: ``... T1=20.6 T2=.. T7=.. P(Pa)=...``)
 - Simple ACK:
     ``[ACK] for=0x12 status=0``
 - Reliable-downlink status lines:
@@ -17,6 +18,13 @@ Supported line types
     - RETRY: ``[CMD] RETRY #2 msg=0x12 seq=7``
     - FAIL:  ``[CMD] FAIL: no ACK for msg=0x12 seq=7``
     - BUSY:  ``[CMD] WARNING: LoRa TX busy > 2.0s ...``
+- High-rate capture (controller forensics buffer):
+    - status: ``[CAPINFO] id=3 state=2 reason=1 count=1024 pre=512 period_us=10000 t_trig=123456``
+    - record: ``[CAP] id=3 i=17 t16=4567 T0=.. T1=.. [T2=.. ... T7=..] P(Pa)=.. heater=%=.. valve=%=.. mode=2 safety=0x4``
+- Setpoint program progress (follows a telemetry line while running/paused or on state change):
+    ``[PROG] state=2 seg=1 t_seg=12.34 sp_T=35.20 sp_P=0.0``
+- End-to-end telemetry latency (follows a telemetry line once both clock-sync hops are valid):
+    ``[LAT] t=123456 e2e_ms=87 ca_ms=-4021 ag_ms=15230``
 
 Unknown lines are wrapped as :class:`RawLine`.
 """
@@ -32,13 +40,25 @@ from typing import Optional, Union
 _FLOAT = r"(?i:nan|inf|-inf|[-+]?(?:\d+(?:\.\d*)?|\.\d+)(?:[eE][-+]?\d+)?)"
 
 RE_TELEM = re.compile(
-    rf"^\[TELEM\]\s+t=(\d+)\s+T0=({_FLOAT})\s+T1=({_FLOAT})\s+P\(Pa\)=({_FLOAT})\s+heater=%=({_FLOAT})\s+valve=%=({_FLOAT})\s*$"
+    rf"^\[TELEM\]\s+t=(\d+)\s+T0=({_FLOAT})\s+T1=({_FLOAT})((?:\s+T[2-7]={_FLOAT})*)\s+P\(Pa\)=({_FLOAT})\s+heater=%=({_FLOAT})\s+valve=%=({_FLOAT})\s*$"
 )
+RE_TELEM_EXTRA_T = re.compile(rf"T([2-7])=({_FLOAT})")
 RE_ACK = re.compile(r"^\[ACK\]\s+for=0x([0-9a-fA-F]+)\s+status=([-+]?\d+)\s*$")
 RE_CMD_ACK = re.compile(r"^\[CMD\]\s+ACK received for msg=0x([0-9a-fA-F]+)\s+seq=(\d+)\s+status=([-+]?\d+)\s*$")
 RE_CMD_RETRY = re.compile(r"^\[CMD\]\s+RETRY #(?P<retry>\d+)\s+msg=0x([0-9a-fA-F]+)\s+seq=(\d+)\s*$")
 RE_CMD_FAIL = re.compile(r"^\[CMD\]\s+FAIL:\s+no ACK for msg=0x([0-9a-fA-F]+)\s+seq=(\d+)\s*$")
 RE_CMD_WARN_BUSY = re.compile(r"^\[CMD\]\s+WARNING:\s+LoRa TX busy >\s*([0-9\.]+)s.*$")
+RE_CAP_INFO = re.compile(
+    r"^\[CAPINFO\]\s+id=(\d+)\s+state=(\d+)\s+reason=(\d+)\s+count=(\d+)\s+pre=(\d+)\s+period_us=(\d+)\s+t_trig=(\d+)\s*$"
+)
+RE_PROG = re.compile(
+    rf"^\[PROG\]\s+state=(\d+)\s+seg=(\d+)\s+t_seg=({_FLOAT})\s+sp_T=({_FLOAT})\s+sp_P=({_FLOAT})\s*$"
+)
+RE_LAT = re.compile(r"^\[LAT\]\s+t=(\d+)\s+e2e_ms=([-+]?\d+)\s+ca_ms=([-+]?\d+)\s+ag_ms=([-+]?\d+)\s*$")
+RE_CAP_REC = re.compile(
+    rf"^\[CAP\]\s+id=(\d+)\s+i=(\d+)\s+t16=(\d+)\s+T0=({_FLOAT})\s+T1=({_FLOAT})((?:\s+T[2-7]={_FLOAT})*)"
+    rf"\s+P\(Pa\)=({_FLOAT})\s+heater=%=({_FLOAT})\s+valve=%=({_FLOAT})\s+mode=(\d+)\s+safety=0x([0-9a-fA-F]+)\s*$"
+)
 
 
 @dataclass(frozen=True)
@@ -49,6 +69,8 @@ class TelemetryFrame:
     p_pa: float
     heater_pct: float
     valve_pct: float
+    # All temperature channels in order (T0, T1, T2, ...); at least T0/T1.
+    temps_c: tuple = ()
 
     @property
     def p_kpa(self) -> float:
@@ -86,6 +108,49 @@ class ReliableCmdBusyWarn:
     busy_s: float
 
 
+@dataclass(frozen=True)
+class CaptureInfo:
+    capture_id: int
+    state: int        # 0=armed, 1=collecting post-trigger, 2=ready
+    reason: int       # 1=safety trip, 2=operator
+    count: int
+    pre_count: int
+    period_us: int
+    trigger_ms: int
+
+
+@dataclass(frozen=True)
+class CaptureRecord:
+    capture_id: int
+    index: int
+    # Low 16 bits of controller millis(); unwrap against neighbouring records.
+    t16_ms: int
+    # T0, T1 and any further channels up to the last valid one (at most 8).
+    temps_c: tuple
+    p_pa: float
+    heater_pct: float
+    valve_pct: float
+    mode: int
+    safety_mask: int
+
+
+@dataclass(frozen=True)
+class ProgramStatus:
+    state: int        # 0=empty, 1=ready, 2=running, 3=paused, 4=done, 5=aborted
+    segment: int
+    seg_elapsed_s: float
+    sp_temp_c: float
+    sp_pressure_pa: float
+
+
+@dataclass(frozen=True)
+class LatencySample:
+    telem_ms: int       # controller timestamp of the telemetry frame
+    e2e_ms: int         # frame built on controller -> received on ground gateway
+    ctrl_air_ms: int    # controller clock - air gateway clock
+    air_ground_ms: int  # air gateway clock - ground gateway clock
+
+
 @dataclass(frozen=True)
 class RawLine:
     line: str
@@ -98,6 +163,10 @@ ParsedLine = Union[
     ReliableCmdRetry,
     ReliableCmdFail,
     ReliableCmdBusyWarn,
+    CaptureInfo,
+    CaptureRecord,
+    ProgramStatus,
+    LatencySample,
     RawLine,
 ]
 
@@ -109,6 +178,14 @@ def _safe_float(s: str) -> float:
         return float("nan")
 
 
+def _temps_with_extra(t0: str, t1: str, extra: Optional[str]) -> tuple:
+    """T0, T1 plus the optional `` T2=.. T7=..`` tail shared by [TELEM] and [CAP]."""
+    temps = [_safe_float(t0), _safe_float(t1)]
+    for em in RE_TELEM_EXTRA_T.finditer(extra or ""):
+        temps.append(_safe_float(em.group(2)))
+    return tuple(temps)
+
+
 def is_finite(x: float) -> bool:
     try:
         return math.isfinite(float(x))
@@ -130,13 +207,15 @@ def parse_line(line: str) -> Optional[ParsedLine]:
 
     m = RE_TELEM.match(text)
     if m:
+        temps = _temps_with_extra(m.group(2), m.group(3), m.group(4))
         return TelemetryFrame(
             t_ms=int(m.group(1)),
-            t0_c=_safe_float(m.group(2)),
-            t1_c=_safe_float(m.group(3)),
-            p_pa=_safe_float(m.group(4)),
-            heater_pct=_safe_float(m.group(5)),
-            valve_pct=_safe_float(m.group(6)),
+            t0_c=temps[0],
+            t1_c=temps[1],
+            p_pa=_safe_float(m.group(5)),
+            heater_pct=_safe_float(m.group(6)),
+            valve_pct=_safe_float(m.group(7)),
+            temps_c=temps,
         )
 
     m = RE_ACK.match(text)
@@ -163,4 +242,49 @@ def parse_line(line: str) -> Optional[ParsedLine]:
     if m:
         return ReliableCmdBusyWarn(busy_s=_safe_float(m.group(1)))
 
+    m = RE_CAP_INFO.match(text)
+    if m:
+        return CaptureInfo(
+            capture_id=int(m.group(1)),
+            state=int(m.group(2)),
+            reason=int(m.group(3)),
+            count=int(m.group(4)),
+            pre_count=int(m.group(5)),
+            period_us=int(m.group(6)),
+            trigger_ms=int(m.group(7)),
+        )
+
+    m = RE_CAP_REC.match(text)
+    if m:
+        return CaptureRecord(
+            capture_id=int(m.group(1)),
+            index=int(m.group(2)),
+            t16_ms=int(m.group(3)),
+            temps_c=_temps_with_extra(m.group(4), m.group(5), m.group(6)),
+            p_pa=_safe_float(m.group(7)),
+            heater_pct=_safe_float(m.group(8)),
+            valve_pct=_safe_float(m.group(9)),
+            mode=int(m.group(10)),
+            safety_mask=int(m.group(11), 16),
+        )
+
+    m = RE_PROG.match(text)
+    if m:
+        return ProgramStatus(
+            state=int(m.group(1)),
+            segment=int(m.group(2)),
+            seg_elapsed_s=_safe_float(m.group(3)),
+            sp_temp_c=_safe_float(m.group(4)),
+            sp_pressure_pa=_safe_float(m.group(5)),
+        )
+
+    m = RE_LAT.match(text)
+    if m:
+        return LatencySample(
+            telem_ms=int(m.group(1)),
+            e2e_ms=int(m.group(2)),
+            ctrl_air_ms=int(m.group(3)),
+            air_ground_ms=int(m.group(4)),
+        )
+
     return RawLine(line=text)
@@ -33,6 +33,10 @@ from host_gui.core.protocol import (
     ReliableCmdRetry,
     ReliableCmdFail,
     ReliableCmdBusyWarn,
+    CaptureInfo,
+    CaptureRecord,
+    ProgramStatus,
+    LatencySample,
     RawLine,
 )
 
@@ -44,6 +48,9 @@ class SerialWorker(QtCore.QObject):
     cmd_retry = pyqtSignal(object)   # ReliableCmdRetry
     cmd_fail = pyqtSignal(object)    # ReliableCmdFail
     cmd_busy = pyqtSignal(object)    # ReliableCmdBusyWarn
+    capture = pyqtSignal(object)     # CaptureInfo / CaptureRecord
+    program = pyqtSignal(object)     # ProgramStatus
+    latency = pyqtSignal(object)     # LatencySample
     log_line = pyqtSignal(str)
     status_msg = pyqtSignal(str)
     connected = pyqtSignal(bool)
@@ -114,6 +121,23 @@ class SerialWorker(QtCore.QObject):
                     self.log_line.emit(line)
                     continue
 
+                if isinstance(parsed, CaptureInfo):
+                    self.capture.emit(parsed)
+                    self.log_line.emit(line)
+                    continue
+                if isinstance(parsed, CaptureRecord):
+                    # 记录行量大，不进日志窗口
+                    self.capture.emit(parsed)
+                    continue
+
+                if isinstance(parsed, ProgramStatus):
+                    self.program.emit(parsed)
+                    continue
+
+                if isinstance(parsed, LatencySample):
+                    self.latency.emit(parsed)
+                    continue
+
                 # RawLine (unknown)
                 if isinstance(parsed, RawLine):
                     self.log_line.emit(parsed.line)
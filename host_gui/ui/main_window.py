@@ -22,9 +22,9 @@ import serial.tools.list_ports
 import pyqtgraph as pg
 
 from host_gui import config
-from host_gui.core.protocol import TelemetryFrame, AckFrame, ReliableCmdAck, ReliableCmdRetry, ReliableCmdFail, ReliableCmdBusyWarn
+from host_gui.core.protocol import TelemetryFrame, AckFrame, ReliableCmdAck, ReliableCmdRetry, ReliableCmdFail, ReliableCmdBusyWarn, LatencySample, CaptureInfo, CaptureRecord, ProgramStatus
 from host_gui.core.filtering import FilterMode, DisplayMode, FilterConfig
-from host_gui.core.model import TelemetryStore
+from host_gui.core.model import TelemetryStore, CaptureStore
 from host_gui.core.settings import SettingsStore, AppSettings
 from host_gui.io.serial_worker import SerialWorker
 
@@ -50,6 +50,10 @@ class MainWindow(QtWidgets.QMainWindow):
             filter_config=self._settings.filter_config,
         )
 
+        self.captures = CaptureStore()
+        self._capture_saved_id: Optional[int] = None
+        self._program_state: Optional[int] = None
+
         # serial worker/thread
         self.thread: Optional[QThread] = None
         self.worker: Optional[SerialWorker] = None
@@ -311,6 +315,9 @@ class MainWindow(QtWidgets.QMainWindow):
         self.lbl_heater = QtWidgets.QLabel("--")
         self.lbl_valve = QtWidgets.QLabel("--")
         self.lbl_last = QtWidgets.QLabel("--")
+        self.lbl_latency = QtWidgets.QLabel("--")
+        self.lbl_capture = QtWidgets.QLabel("--")
+        self.lbl_program = QtWidgets.QLabel("--")
 
         lay.addWidget(QtWidgets.QLabel("T0 (°C)"), 0, 0)
         lay.addWidget(self.lbl_t0, 0, 1)
@@ -327,6 +334,14 @@ class MainWindow(QtWidgets.QMainWindow):
         lay.addWidget(QtWidgets.QLabel("电磁阀 (%)"), 2, 2)
         lay.addWidget(self.lbl_valve, 2, 3)
 
+        lay.addWidget(QtWidgets.QLabel("端到端延迟 (ms)"), 3, 0)
+        lay.addWidget(self.lbl_latency, 3, 1)
+        lay.addWidget(QtWidgets.QLabel("捕获下载"), 3, 2)
+        lay.addWidget(self.lbl_capture, 3, 3)
+
+        lay.addWidget(QtWidgets.QLabel("设定值程序"), 4, 0)
+        lay.addWidget(self.lbl_program, 4, 1, 1, 3)
+
         return g
 
     def _build_filter_group(self) -> QtWidgets.QGroupBox:
@@ -375,12 +390,14 @@ class MainWindow(QtWidgets.QMainWindow):
 
         self.btn_safe = QtWidgets.QPushButton("SAFE")
         self.btn_manual = QtWidgets.QPushButton("MANUAL")
-        self.btn_auto = QtWidgets.QPushButton("AUTO(预留)")
+        self.btn_auto = QtWidgets.QPushButton("AUTO")
+        self.btn_autotune = QtWidgets.QPushButton("自整定")
 
         lay.addWidget(QtWidgets.QLabel("Mode"), 0, 0)
         lay.addWidget(self.btn_safe, 0, 1)
         lay.addWidget(self.btn_manual, 0, 2)
         lay.addWidget(self.btn_auto, 0, 3)
+        lay.addWidget(self.btn_autotune, 0, 4)
 
         self.sl_heater = QtWidgets.QSlider(QtCore.Qt.Horizontal)
         self.sl_heater.setRange(0, 100)
@@ -584,6 +601,7 @@ class MainWindow(QtWidgets.QMainWindow):
         self.btn_safe.clicked.connect(lambda: self._send_mode("safe"))
         self.btn_manual.clicked.connect(lambda: self._send_mode("manual"))
         self.btn_auto.clicked.connect(lambda: self._send_mode("auto"))
+        self.btn_autotune.clicked.connect(lambda: self._send_mode("autotune"))
 
         self.sl_heater.valueChanged.connect(lambda v: self.lb_heater_set.setText(str(v)))
         self.btn_heater_apply.clicked.connect(self._on_heater_apply)
@@ -683,6 +701,9 @@ class MainWindow(QtWidgets.QMainWindow):
         self.worker.cmd_retry.connect(self._on_cmd_retry)
         self.worker.cmd_fail.connect(self._on_cmd_fail)
         self.worker.cmd_busy.connect(self._on_cmd_busy)
+        self.worker.latency.connect(self._on_latency)
+        self.worker.capture.connect(self._on_capture)
+        self.worker.program.connect(self._on_program)
         self.worker.log_line.connect(self._append_log)
         self.worker.status_msg.connect(self._show_status)
         self.worker.connected.connect(self._on_connected)
@@ -739,6 +760,46 @@ class MainWindow(QtWidgets.QMainWindow):
         if self.store.rec_enabled:
             self._update_rec_info()
 
+    @pyqtSlot(object)
+    def _on_latency(self, s: LatencySample):
+        self.lbl_latency.setText(str(s.e2e_ms))
+
+    _PROGRAM_STATES = {0: "未上传", 1: "已上传", 2: "运行", 3: "暂停", 4: "完成", 5: "中止"}
+
+    @pyqtSlot(object)
+    def _on_program(self, p: ProgramStatus):
+        # [PROG] 随遥测每帧上报，只在状态变化时写日志
+        name = self._PROGRAM_STATES.get(p.state, str(p.state))
+        self.lbl_program.setText(
+            f"{name}  段{p.segment}  {p.seg_elapsed_s:.1f} s  T={p.sp_temp_c:.2f}  P={p.sp_pressure_pa:.0f}"
+        )
+        if p.state != self._program_state:
+            self._program_state = p.state
+            self._show_status(f"设定值程序：{name}（段 {p.segment}）")
+
+    @pyqtSlot(object)
+    def _on_capture(self, item):
+        # 捕获记录收齐后自动导出到保存目录（记录行不进日志窗口）
+        cap = self.captures
+        if isinstance(item, CaptureInfo):
+            cap.add_info(item)
+            done = cap.complete()
+        elif isinstance(item, CaptureRecord):
+            done = cap.add_record(item)
+        else:
+            return
+        if cap.info is None:
+            return
+        self.lbl_capture.setText(f"id={cap.info.capture_id} {cap.received()}/{cap.info.count}")
+        if done and self._capture_saved_id != cap.info.capture_id:
+            fn = os.path.join(self.store.save_dir or os.getcwd(), cap.default_csv_name())
+            try:
+                cap.write_csv(fn)
+                self._capture_saved_id = cap.info.capture_id
+                self._show_status(f"捕获已保存：{fn}")
+            except Exception as e:
+                self._show_status(f"捕获保存失败：{e}")
+
     @pyqtSlot(object)
     def _on_ack(self, ack: AckFrame):
         self.statusBar().showMessage(f"ACK: msg=0x{ack.msg_type:02X} status={ack.status}")